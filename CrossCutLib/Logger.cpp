@@ -1,6 +1,15 @@
 #include "Logger.h"
 #include <ctime>
 
+struct PendingLine // The stream-style line this thread is writing, see Logger::overflow
+{
+    const Logger* logger = nullptr;
+    LogLevel logLevel = LogLevel::Off;
+    std::string text {};
+};
+
+thread_local PendingLine pendingLine {};
+
 #ifdef HAS_CONSOLE
 #include <Windows.h>
 
@@ -56,110 +65,118 @@ void Console::setVisible(bool visible, void* voidHandle)
 
 Logger::Logger(LogLevel logLevel) :
     logLevel(logLevel), outputStream(std::shared_ptr<std::ostream>(&std::cout, [](std::ostream*){})), aggregator(nullptr),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::Logger(std::ostream & outputStream, LogLevel logLevel) :
     logLevel(logLevel), outputStream(std::shared_ptr<std::ostream>(&outputStream, [](std::ostream*){})), aggregator(nullptr),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::Logger(std::ostream & outputStream, Logger & aggregator, LogLevel logLevel) :
     logLevel(logLevel), outputStream(std::shared_ptr<std::ostream>(&outputStream, [](std::ostream*){})), aggregator(std::shared_ptr<Logger>(&aggregator, [](Logger*){})),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::Logger(std::ostream & outputStream, std::shared_ptr<Logger> aggregator, LogLevel logLevel) :
     logLevel(logLevel), outputStream(std::shared_ptr<std::ostream>(&outputStream, [](std::ostream*){})), aggregator(aggregator),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::Logger(std::shared_ptr<std::ostream> outputStream, LogLevel logLevel) :
     logLevel(logLevel), outputStream(outputStream), aggregator(nullptr),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::Logger(std::shared_ptr<std::ostream> outputStream, Logger & aggregator, LogLevel logLevel) :
     logLevel(logLevel), outputStream(outputStream), aggregator(std::shared_ptr<Logger>(&aggregator, [](Logger*){})),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::Logger(std::shared_ptr<std::ostream> outputStream, std::shared_ptr<Logger> aggregator, LogLevel logLevel) :
     logLevel(logLevel), outputStream(outputStream), aggregator(aggregator),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::Logger(Logger & aggregator, LogLevel logLevel) :
     logLevel(logLevel), outputStream(std::shared_ptr<std::ostream>(&std::cout, [](std::ostream*){})), aggregator(std::shared_ptr<Logger>(&aggregator, [](Logger*){})),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::Logger(std::shared_ptr<Logger> aggregator, LogLevel logLevel) :
     logLevel(logLevel), outputStream(std::shared_ptr<std::ostream>(&std::cout, [](std::ostream*){})), aggregator(aggregator),
-    streamLogLevel(logLevel), std::ostream(this)
+    std::ostream(this)
 {
 
 }
 
 Logger::~Logger()
 {
-
+    if ( pendingLine.logger == this )
+        pendingLine = PendingLine{};
 }
 
 LogLevel Logger::getLogLevel()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     return logLevel;
 }
 
 std::shared_ptr<std::ostream> Logger::getOutputStream()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     return outputStream;
 }
 
 std::shared_ptr<Logger> Logger::getAggregator()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     return aggregator;
 }
 
 void Logger::setLogLevel(LogLevel logLevel)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     this->logLevel = logLevel;
-    this->streamLogLevel = logLevel;
 }
 
 void Logger::setOutputStream(std::ostream & outputStream)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     this->outputStream = std::shared_ptr<std::ostream>(&outputStream, [](std::ostream*){});
 }
 
 void Logger::setOutputStream(std::shared_ptr<std::ostream> outputStream)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     this->outputStream = outputStream;
 }
 
 void Logger::setAggregator(Logger & aggregator)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     this->aggregator = std::shared_ptr<Logger>(&aggregator, [](Logger*){});
 }
 
 void Logger::setAggregator(std::shared_ptr<Logger> aggregator)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     this->aggregator = aggregator;
 }
 
@@ -193,85 +210,43 @@ std::string Logger::getPrefix(LogLevel logLevel)
 
 Logger & Logger::log(LogLevel logLevel)
 {
-    streamLogLevel = logLevel;
-    if ( aggregator != nullptr && streamLogLevel <= aggregator->logLevel )
-        aggregator->log(streamLogLevel);
-
-    if ( logLevel <= this->logLevel && outputStream != nullptr )
-        *outputStream << getPrefix(logLevel);
-
+    beginLine(logLevel);
     return *this;
 }
 
 Logger & Logger::fatal()
 {
-    streamLogLevel = LogLevel::Fatal;
-    if ( aggregator != nullptr && streamLogLevel <= aggregator->logLevel )
-        aggregator->fatal();
-
-    if ( LogLevel::Fatal <= logLevel && outputStream != nullptr )
-        *outputStream << getPrefix(LogLevel::Fatal);
-
+    beginLine(LogLevel::Fatal);
     return *this;
 }
 
 Logger & Logger::error()
 {
-    streamLogLevel = LogLevel::Error;
-    if ( aggregator != nullptr && streamLogLevel <= aggregator->logLevel )
-        aggregator->error();
-
-    if ( LogLevel::Error <= logLevel && outputStream != nullptr )
-        *outputStream << getPrefix(LogLevel::Error);
-
+    beginLine(LogLevel::Error);
     return *this;
 }
 
 Logger & Logger::warn()
 {
-    streamLogLevel = LogLevel::Warn;
-    if ( aggregator != nullptr && streamLogLevel <= aggregator->logLevel )
-        aggregator->warn();
-
-    if ( LogLevel::Warn <= logLevel && outputStream != nullptr )
-        *outputStream << getPrefix(LogLevel::Warn);
-        
+    beginLine(LogLevel::Warn);
     return *this;
 }
 
 Logger & Logger::info()
 {
-    streamLogLevel = LogLevel::Info;
-    if ( aggregator != nullptr && streamLogLevel <= aggregator->logLevel )
-        aggregator->info();
-
-    if ( LogLevel::Info <= logLevel && outputStream != nullptr )
-        *outputStream << getPrefix(LogLevel::Info);
-    
+    beginLine(LogLevel::Info);
     return *this;
 }
 
 Logger & Logger::debug()
 {
-    streamLogLevel = LogLevel::Debug;
-    if ( aggregator != nullptr && streamLogLevel <= aggregator->logLevel )
-        aggregator->debug();
-
-    if ( LogLevel::Debug <= logLevel && outputStream != nullptr )
-        *outputStream << getPrefix(LogLevel::Debug);
-
+    beginLine(LogLevel::Debug);
     return *this;
 }
 
 Logger & Logger::trace()
 {
-    streamLogLevel = LogLevel::Trace;
-    if ( aggregator != nullptr && streamLogLevel <= aggregator->logLevel )
-        aggregator->trace();
-
-    if ( LogLevel::Trace <= logLevel && outputStream != nullptr )
-        *outputStream << getPrefix(LogLevel::Trace);
-        
+    beginLine(LogLevel::Trace);
     return *this;
 }
 
@@ -282,6 +257,7 @@ std::shared_ptr<std::ostream> Logger::getDefaultOutputStream()
 
 int Logger::sync()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     if ( outputStream != nullptr )
         outputStream->flush();
 
@@ -295,20 +271,42 @@ int Logger::overflow(int c)
         return 0;
 #endif
 
-    if ( outputStream != nullptr && streamLogLevel <= logLevel && streamLogLevel > LogLevel::Off )
-        outputStream->put(c);
-
-    if ( aggregator != nullptr && streamLogLevel <= aggregator->logLevel )
-        aggregator->overflowAggregator(c, streamLogLevel);
+    if ( pendingLine.logger != this ) // Streamed to without a level call, the line is logged at this logger's level
+        beginLine(getLogLevel(), false);
 
+    pendingLine.text.push_back(char(c));
+    if ( c == '\n' )
+    {
+        writeLine(pendingLine.logLevel, pendingLine.text);
+        pendingLine.text.clear(); // Later text streamed without a level call continues at the same level
+    }
     return 0;
 }
 
-void Logger::overflowAggregator(int c, LogLevel sourceStreamLogLevel)
+std::streamsize Logger::xsputn(const char* s, std::streamsize count)
+{
+    for ( std::streamsize i=0; i<count; ++i )
+        overflow(s[i]);
+
+    return count;
+}
+
+void Logger::beginLine(LogLevel logLevel, bool prefixed)
+{
+    if ( pendingLine.logger == this && !pendingLine.text.empty() ) // The previous line didn't end in a newline, end it here
+        writeLine(pendingLine.logLevel, pendingLine.text + '\n');
+
+    pendingLine.logger = this; // An unfinished line of another logger is dropped, that logger may no longer exist
+    pendingLine.logLevel = logLevel;
+    pendingLine.text = prefixed ? getPrefix(logLevel) : std::string();
+}
+
+void Logger::writeLine(LogLevel logLevel, const std::string & line)
 {
-    if ( outputStream != nullptr && sourceStreamLogLevel <= logLevel && logLevel > LogLevel::Off )
-        outputStream->put(c);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    if ( outputStream != nullptr && logLevel <= this->logLevel && logLevel > LogLevel::Off )
+        *outputStream << line;
 
-    if ( aggregator != nullptr && sourceStreamLogLevel <= aggregator->logLevel )
-        aggregator->overflowAggregator(c, sourceStreamLogLevel);
+    if ( aggregator != nullptr )
+        aggregator->writeLine(logLevel, line);
 }
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #ifdef _WIN32
@@ -41,6 +42,8 @@ struct LogLevel_
 };
 using LogLevel = LogLevel_::uint32_t_;
 
+// Each call locks the logger (and then its aggregators), message overloads write whole lines without interleaving across threads
+// Stream-style lines (e.g. logger.info() << a << b << std::endl) are buffered per thread & written the same way once they end in a newline
 struct Logger : std::ostream, std::streambuf
 {
     Logger(LogLevel logLevel = LogLevel::Default);
@@ -77,6 +80,7 @@ struct Logger : std::ostream, std::streambuf
 
     template <typename T> void log(LogLevel logLevel, const T & message)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && logLevel <= this->logLevel )
             *outputStream << getPrefix(logLevel) << message << std::endl;
         if ( aggregator != nullptr )
@@ -84,6 +88,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void log(LogLevel logLevel, const T & message, const std::exception & e)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && logLevel <= this->logLevel )
             *outputStream << getPrefix(logLevel) << message << std::endl << e.what() << std::endl;
         if ( aggregator != nullptr )
@@ -91,6 +96,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void fatal(const T & message)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Fatal <= logLevel )
             *outputStream << getPrefix(LogLevel::Fatal) << message << std::endl;
         if ( aggregator != nullptr )
@@ -98,6 +104,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void fatal(const T & message, const std::exception & e)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Fatal <= logLevel )
             *outputStream << getPrefix(LogLevel::Fatal) << message << std::endl << e.what() << std::endl;
         if ( aggregator != nullptr )
@@ -105,6 +112,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void error(const T & message)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Error <= logLevel )
             *outputStream << getPrefix(LogLevel::Error) << message << std::endl;
         if ( aggregator != nullptr )
@@ -112,6 +120,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void error(const T & message, const std::exception & e)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Error <= logLevel )
             *outputStream << getPrefix(LogLevel::Error) << message << std::endl << e.what() << std::endl;
         if ( aggregator != nullptr )
@@ -119,6 +128,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void warn(const T & message)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Warn <= logLevel )
             *outputStream << getPrefix(LogLevel::Warn) << message << std::endl;
         if ( aggregator != nullptr )
@@ -126,6 +136,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void warn(const T & message, const std::exception & e)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Warn <= logLevel )
             *outputStream << getPrefix(LogLevel::Warn) << message << std::endl << e.what() << std::endl;
         if ( aggregator != nullptr )
@@ -133,6 +144,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void info(const T & message)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Info <= logLevel )
             *outputStream << getPrefix(LogLevel::Info) << message << std::endl;
         if ( aggregator != nullptr )
@@ -140,6 +152,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void info(const T & message, const std::exception & e)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Info <= logLevel )
             *outputStream << getPrefix(LogLevel::Info) << message << std::endl << e.what() << std::endl;
         if ( aggregator != nullptr )
@@ -147,6 +160,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void debug(const T & message)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Debug <= logLevel )
             *outputStream << getPrefix(LogLevel::Debug) << message << std::endl;
         if ( aggregator != nullptr )
@@ -154,6 +168,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void debug(const T & message, const std::exception & e)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Debug <= logLevel )
             *outputStream << getPrefix(LogLevel::Debug) << message << std::endl << e.what() << std::endl;
         if ( aggregator != nullptr )
@@ -161,6 +176,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void trace(const T & message)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Trace <= logLevel )
             *outputStream << getPrefix(LogLevel::Trace) << message << std::endl;
         if ( aggregator != nullptr )
@@ -168,6 +184,7 @@ struct Logger : std::ostream, std::streambuf
     }
     template <typename T> void trace(const T & message, const std::exception & e)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if ( outputStream != nullptr && LogLevel::Trace <= logLevel )
             *outputStream << getPrefix(LogLevel::Trace) << message << std::endl << e.what() << std::endl;
         if ( aggregator != nullptr )
@@ -179,13 +196,15 @@ struct Logger : std::ostream, std::streambuf
 protected:
     virtual int sync();
     virtual int overflow(int c);
-    void overflowAggregator(int c, LogLevel sourceStreamLogLevel);
+    virtual std::streamsize xsputn(const char* s, std::streamsize count);
+    void beginLine(LogLevel logLevel, bool prefixed = true); // Starts this thread's stream-style line at logLevel, prefixed by getPrefix(logLevel)
+    void writeLine(LogLevel logLevel, const std::string & line); // Writes a finished stream-style line here & to the aggregators that log logLevel
 
 private:
     LogLevel logLevel;
-    LogLevel streamLogLevel;
     std::shared_ptr<std::ostream> outputStream;
     std::shared_ptr<Logger> aggregator;
+    std::recursive_mutex mutex;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+    A fixed-size pool of worker threads that run submitted tasks in FIFO order
+
+    Tasks must not block waiting on other tasks submitted to the same pool (e.g. by calling parallelFor from within a task),
+    a pool whose workers are all waiting on queued tasks will never finish
+*/
+class ThreadPool
+{
+    public:
+        explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency())
+        {
+            if ( threadCount == 0 )
+                threadCount = 1;
+
+            workers.reserve(threadCount);
+            for ( size_t i=0; i<threadCount; ++i )
+                workers.emplace_back([this]() { run(); });
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(taskLocker);
+                stopping = true;
+            }
+            hasTasks.notify_all();
+            for ( auto & worker : workers )
+                worker.join();
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool & operator=(const ThreadPool &) = delete;
+
+        size_t size() const { return workers.size(); }
+
+        template <typename Task>
+        auto submit(Task && task) -> std::future<std::invoke_result_t<std::decay_t<Task>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<Task>>;
+            auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+            std::future<Result> result = packagedTask->get_future();
+            {
+                std::lock_guard<std::mutex> lock(taskLocker);
+                tasks.emplace([packagedTask]() { (*packagedTask)(); });
+            }
+            hasTasks.notify_one();
+            return result;
+        }
+
+        // Runs func(i) for every i in [0, count) across the pool and waits for all to complete, rethrows the first exception encountered
+        template <typename Func>
+        void parallelFor(size_t count, Func && func)
+        {
+            std::vector<std::future<void>> results {};
+            results.reserve(count);
+            for ( size_t i=0; i<count; ++i )
+                results.push_back(submit([&func, i]() { func(i); }));
+
+            for ( auto & result : results )
+                result.wait();
+
+            for ( auto & result : results )
+                result.get();
+        }
+
+    private:
+        void run()
+        {
+            for ( ;; )
+            {
+                std::function<void()> task {};
+                {
+                    std::unique_lock<std::mutex> lock(taskLocker);
+                    hasTasks.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                    if ( tasks.empty() ) // Only reachable when stopping
+                        return;
+
+                    task = std::move(tasks.front());
+                    tasks.pop();
+                }
+                task();
+            }
+        }
+
+        std::vector<std::thread> workers {};
+        std::queue<std::function<void()>> tasks {};
+        std::mutex taskLocker {};
+        std::condition_variable hasTasks {};
+        bool stopping = false;
+};
+
+#endif
\ No newline at end of file
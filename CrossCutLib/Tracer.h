@@ -0,0 +1,205 @@
+#ifndef TRACER_H
+#define TRACER_H
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+    A process-wide recorder of timed spans which can be written out as Chrome/Perfetto trace-event JSON (chrome://tracing or ui.perfetto.dev)
+
+    Tracing is off until setEnabled(true) is called, while off a TraceSpan costs a single relaxed atomic load
+    Each thread records into its own buffer without taking locks, a lock is only taken the first time a thread records a span and when writing/clearing
+
+    Span names must be string literals or otherwise outlive the tracer, they're stored as pointers
+*/
+class Tracer
+{
+    public:
+        struct Event
+        {
+            const char* name = nullptr;
+            int64_t startUs = 0; // Microseconds since the tracer was created
+            int64_t durationUs = 0;
+        };
+
+        static inline Tracer & get()
+        {
+            static Tracer tracer {};
+            return tracer;
+        }
+
+        inline bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+        inline void setEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+
+        inline int64_t now() const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+        }
+
+        inline void record(const char* name, int64_t startUs, int64_t finishUs)
+        {
+            getThreadBuffer().push({name, startUs, finishUs - startUs});
+        }
+
+        // Discards all recorded events, must not be called while other threads are recording spans
+        inline void clear()
+        {
+            std::lock_guard<std::mutex> lock(bufferLocker);
+            for ( auto & buffer : buffers )
+                buffer->clear();
+        }
+
+        // Writes all events published so far, safe to call while other threads are recording spans
+        inline void writeJson(std::ostream & out) const
+        {
+            std::lock_guard<std::mutex> lock(bufferLocker);
+            out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            bool first = true;
+            for ( const auto & buffer : buffers )
+            {
+                out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"args\":{\"name\":\"Thread " << buffer->threadId << "\"}}";
+                first = false;
+                buffer->forEach([&](const Event & event) {
+                    out << ",\n{\"name\":\"";
+                    writeEscaped(out, event.name);
+                    out << "\",\"cat\":\"chkdraft\",\"ph\":\"X\",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs
+                        << ",\"pid\":1,\"tid\":" << buffer->threadId << "}";
+                });
+            }
+            out << "\n]}" << std::endl;
+        }
+
+        inline bool writeJson(const std::string & filePath) const
+        {
+            std::ofstream outFile(filePath, std::ios_base::out|std::ios_base::trunc);
+            if ( !outFile )
+                return false;
+
+            writeJson(outFile);
+            return outFile.good();
+        }
+
+        Tracer(const Tracer &) = delete;
+        Tracer & operator=(const Tracer &) = delete;
+
+    private:
+        static constexpr size_t eventsPerChunk = 4096;
+
+        // Events are appended to fixed-size chunks so published events never move, readers see events up to the published count
+        class ThreadBuffer
+        {
+            struct Chunk
+            {
+                Event events[eventsPerChunk] {};
+                std::atomic<size_t> published = 0;
+                std::atomic<Chunk*> next = nullptr;
+            };
+
+            std::unique_ptr<Chunk> head = std::make_unique<Chunk>();
+            std::vector<std::unique_ptr<Chunk>> overflow {};
+            Chunk* tail = head.get();
+
+        public:
+            uint32_t threadId;
+
+            inline ThreadBuffer(uint32_t threadId) : threadId(threadId) {}
+
+            inline void push(const Event & event) // Only called from the owning thread
+            {
+                size_t index = tail->published.load(std::memory_order_relaxed);
+                if ( index == eventsPerChunk )
+                {
+                    overflow.push_back(std::make_unique<Chunk>());
+                    Chunk* chunk = overflow.back().get();
+                    tail->next.store(chunk, std::memory_order_release);
+                    tail = chunk;
+                    index = 0;
+                }
+                tail->events[index] = event;
+                tail->published.store(index+1, std::memory_order_release);
+            }
+
+            template <typename Func>
+            inline void forEach(Func && func) const
+            {
+                for ( const Chunk* chunk = head.get(); chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire) )
+                {
+                    size_t published = chunk->published.load(std::memory_order_acquire);
+                    for ( size_t i=0; i<published; ++i )
+                        func(chunk->events[i]);
+                }
+            }
+
+            inline void clear()
+            {
+                head->next.store(nullptr, std::memory_order_relaxed);
+                head->published.store(0, std::memory_order_relaxed);
+                overflow.clear();
+                tail = head.get();
+            }
+        };
+
+        std::atomic<bool> enabled = false;
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        mutable std::mutex bufferLocker {};
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers {}; // Buffers outlive their threads so spans from finished threads are still written
+
+        Tracer() = default;
+
+        inline ThreadBuffer & getThreadBuffer()
+        {
+            thread_local ThreadBuffer* threadBuffer = nullptr;
+            if ( threadBuffer == nullptr )
+            {
+                std::lock_guard<std::mutex> lock(bufferLocker);
+                buffers.push_back(std::make_unique<ThreadBuffer>(uint32_t(buffers.size()+1)));
+                threadBuffer = buffers.back().get();
+            }
+            return *threadBuffer;
+        }
+
+        static inline void writeEscaped(std::ostream & out, const char* str)
+        {
+            for ( ; str != nullptr && *str != '\0'; ++str )
+            {
+                if ( *str == '"' || *str == '\\' )
+                    out << '\\' << *str;
+                else if ( uint8_t(*str) >= 0x20 )
+                    out << *str;
+            }
+        }
+};
+
+// Records the time from construction to destruction as a span on the calling thread if tracing was enabled at construction
+class TraceSpan
+{
+    public:
+        inline explicit TraceSpan(const char* name) : name(Tracer::get().isEnabled() ? name : nullptr)
+        {
+            if ( this->name != nullptr )
+                startUs = Tracer::get().now();
+        }
+
+        inline ~TraceSpan()
+        {
+            if ( name != nullptr )
+                Tracer::get().record(name, startUs, Tracer::get().now());
+        }
+
+        TraceSpan(const TraceSpan &) = delete;
+        TraceSpan & operator=(const TraceSpan &) = delete;
+
+    private:
+        const char* name;
+        int64_t startUs = 0;
+};
+
+#endif
\ No newline at end of file
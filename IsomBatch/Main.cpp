@@ -0,0 +1,339 @@
+#include "../IsomTerrain/IsomApi.h"
+#include "../IsomTerrain/IsomJournal.h"
+#include "../IsomTerrain/IsomMapFile.h"
+#include "../CrossCutLib/Logger.h"
+#include "../CrossCutLib/ThreadPool.h"
+#include "../CrossCutLib/Tracer.h"
+#include "../RareCpp/include/rarecpp/json.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Runs new-map, resize and edit jobs from a manifest across a bounded pool of workers, one status line is written to stdout as each job finishes
+// Usage: IsomBatch <manifest.json|manifest.csv> [--threads count] [--starcraft directory] [--trace traceFile.json]
+//
+// JSON manifests are {"jobs":[...]} where each job has an "op" of "new", "resize", "edit" or "replay", an "input" map (unused by new), an "output" map & the op's parameters
+//     new: tileset, width, height, terrainType; resize: width, height, xOffset, yOffset, terrainType; edit: edits [{terrainType, x, y, brushSize}]
+//     replay: journal (an IsomJournal recorded against the input map)
+// CSV manifests have one job per line (no quoting, paths can't contain commas), blank lines & lines starting with # are skipped
+//     new,,output,tileset,width,height,terrainType
+//     resize,input,output,width,height,xOffset,yOffset,terrainType
+//     edit,input,output,terrainType,x,y,brushSize[,terrainType,x,y,brushSize...]
+//     replay,input,output,journal
+//
+// Input maps are opened with only their terrain sections parsed, every other section is saved back unchanged
+// Input & output maps ending in .chksnap are uncompressed snapshots (see MapFile::saveSnapshot) for passing maps between pipeline stages
+// Each worker loads its maps' strings & sections into its own arena which is released after every job rather than freeing allocations one by one
+//
+// Status lines are JSON objects, the final line summarizes the batch, the exit code is non-zero if any job failed
+
+Logger logger(LogLevel::Warn);
+
+Sc::Terrain_ terrainDat; // Loaded once then shared read-only by every worker
+
+struct EditOp
+{
+    size_t terrainType = 0;
+    size_t x = 0; // x is a tileCoord/2, only even x-coords are valid on even y coords, only odd x-coords are valid on odd y-coords
+    size_t y = 0;
+    size_t brushSize = 1;
+
+    REFLECT(EditOp, terrainType, x, y, brushSize)
+};
+
+struct Job
+{
+    std::string op {};
+    std::string input {};
+    std::string output {};
+    uint16_t tileset = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    int32_t xOffset = 0;
+    int32_t yOffset = 0;
+    size_t terrainType = 0;
+    std::vector<EditOp> edits {};
+    std::string journal {};
+
+    REFLECT(Job, op, input, output, tileset, width, height, xOffset, yOffset, terrainType, edits, journal)
+};
+
+struct Manifest
+{
+    std::vector<Job> jobs {};
+
+    REFLECT(Manifest, jobs)
+};
+
+struct JobStatus
+{
+    size_t job = 0; // Index of the job in the manifest
+    std::string op {};
+    std::string output {};
+    bool success = false;
+    std::string error {};
+    double ms = 0.0;
+
+    REFLECT(JobStatus, job, op, output, success, error, ms)
+};
+
+struct BatchSummary
+{
+    size_t jobs = 0;
+    size_t succeeded = 0;
+    size_t failed = 0;
+    size_t threads = 0;
+    double totalMs = 0.0;
+
+    REFLECT(BatchSummary, jobs, succeeded, failed, threads, totalMs)
+};
+
+std::vector<std::string> splitCsvLine(const std::string & line)
+{
+    std::vector<std::string> fields {};
+    std::stringstream lineStream(line);
+    std::string field {};
+    while ( std::getline(lineStream, field, ',') )
+    {
+        size_t start = field.find_first_not_of(" \t\r");
+        size_t end = field.find_last_not_of(" \t\r");
+        fields.push_back(start == std::string::npos ? "" : field.substr(start, end-start+1));
+    }
+    return fields;
+}
+
+Job parseCsvJob(const std::vector<std::string> & fields)
+{
+    auto number = [&](size_t index) {
+        if ( index >= fields.size() )
+            throw std::invalid_argument("Missing parameter " + std::to_string(index+1) + " for op \"" + fields[0] + "\"");
+        return std::stoll(fields[index]);
+    };
+
+    Job job {};
+    job.op = fields[0];
+    job.input = fields.size() > 1 ? fields[1] : "";
+    job.output = fields.size() > 2 ? fields[2] : "";
+    if ( job.op == "new" )
+    {
+        job.tileset = uint16_t(number(3));
+        job.width = uint16_t(number(4));
+        job.height = uint16_t(number(5));
+        job.terrainType = size_t(number(6));
+    }
+    else if ( job.op == "resize" )
+    {
+        job.width = uint16_t(number(3));
+        job.height = uint16_t(number(4));
+        job.xOffset = int32_t(number(5));
+        job.yOffset = int32_t(number(6));
+        job.terrainType = size_t(number(7));
+    }
+    else if ( job.op == "edit" )
+    {
+        for ( size_t i=3; i<fields.size(); i+=4 )
+            job.edits.push_back(EditOp{size_t(number(i)), size_t(number(i+1)), size_t(number(i+2)), size_t(number(i+3))});
+    }
+    else if ( job.op == "replay" )
+        job.journal = fields.size() > 3 ? fields[3] : "";
+
+    return job;
+}
+
+Manifest loadManifest(const std::string & manifestPath)
+{
+    std::ifstream manifestFile(manifestPath);
+    if ( !manifestFile )
+        throw std::runtime_error("Failed to open manifest " + manifestPath);
+
+    Manifest manifest {};
+    if ( getSystemFileExtension(manifestPath) == ".json" )
+        manifestFile >> Json::in(manifest);
+    else
+    {
+        std::string line {};
+        for ( size_t lineNumber=1; std::getline(manifestFile, line); ++lineNumber )
+        {
+            auto fields = splitCsvLine(line);
+            if ( fields.empty() || fields[0].empty() || fields[0][0] == '#' )
+                continue;
+
+            try {
+                manifest.jobs.push_back(parseCsvJob(fields));
+            } catch ( std::exception & e ) {
+                throw std::runtime_error("Invalid job on line " + std::to_string(lineNumber) + " of " + manifestPath + ": " + e.what());
+            }
+        }
+    }
+    return manifest;
+}
+
+bool isValidTerrainType(Sc::Terrain::Tileset tileset, size_t terrainType)
+{
+    const auto & terrainTypes = terrainDat.get(tileset).terrainTypes;
+    return terrainType < terrainTypes.size() && terrainTypes[terrainType].isomValue != 0;
+}
+
+void matchSaveTypeToExtension(MapFile & mapFile, const std::string & outputPath)
+{
+    // Chk save types follow the matching scm/scx save types in the same order
+    bool chkOutput = getSystemFileExtension(outputPath) == ".chk";
+    auto saveType = mapFile.getSaveType();
+    if ( chkOutput && saveType >= SaveType::StarCraftScm && saveType <= SaveType::RemasteredScx )
+        mapFile.setSaveType(SaveType(int(saveType) + int(SaveType::StarCraftChk)));
+    else if ( !chkOutput && saveType >= SaveType::StarCraftChk && saveType <= SaveType::RemasteredChk )
+        mapFile.setSaveType(SaveType(int(saveType) - int(SaveType::StarCraftChk)));
+}
+
+std::string runJob(const Job & job, std::pmr::memory_resource & arena) // Returns an error message, or an empty string if the job succeeded
+{
+    TraceSpan traceSpan("IsomBatch::runJob");
+    if ( job.output.empty() )
+        return "No output map";
+
+    std::unique_ptr<MapFile> mapFile = nullptr;
+    if ( job.op == "new" )
+    {
+        if ( job.tileset >= Sc::Terrain::NumTilesets )
+            return "Invalid tileset " + std::to_string(job.tileset);
+        else if ( job.width == 0 || job.height == 0 )
+            return "Invalid dimensions";
+        else if ( !isValidTerrainType(Sc::Terrain::Tileset(job.tileset), job.terrainType) )
+            return "Invalid terrainType " + std::to_string(job.terrainType);
+
+        mapFile = newMap(terrainDat, Sc::Terrain::Tileset(job.tileset), job.width, job.height, job.terrainType);
+    }
+    else if ( job.op == "resize" || job.op == "edit" || job.op == "replay" )
+    {
+        mapFile = openMap(job.input, &Scenario::terrainSections, &arena, true); // Jobs change terrain through IsomMapFile.h's helpers, which mark it dirty
+        if ( mapFile == nullptr )
+            return "Failed to open input map " + job.input;
+
+        Sc::Terrain::Tileset tileset = mapFile->getTileset();
+        if ( job.op == "resize" )
+        {
+            if ( job.width == 0 || job.height == 0 )
+                return "Invalid dimensions";
+            else if ( !isValidTerrainType(tileset, job.terrainType) )
+                return "Invalid terrainType " + std::to_string(job.terrainType);
+
+            resizeMap(terrainDat, *mapFile, job.width, job.height, job.xOffset, job.yOffset, job.terrainType);
+        }
+        else if ( job.op == "replay" )
+        {
+            auto journal = IsomJournal::load(job.journal);
+            if ( !journal )
+                return "Failed to open journal " + job.journal;
+
+            ScMap scMap = copyToScMap(*mapFile);
+            auto result = journal->replay(scMap, terrainDat.get(tileset));
+            if ( !result.success )
+                return "Failed to replay " + job.journal + ": " + result.error;
+
+            copyFromScMap(*mapFile, scMap);
+        }
+        else
+        {
+            std::vector<PlaceTerrainOp> ops {};
+            for ( const auto & edit : job.edits )
+            {
+                if ( !isValidTerrainType(tileset, edit.terrainType) )
+                    return "Invalid terrainType " + std::to_string(edit.terrainType);
+
+                ops.push_back(PlaceTerrainOp{edit.terrainType, edit.x, edit.y, edit.brushSize});
+            }
+            placeTerrain(terrainDat, *mapFile, ops);
+        }
+    }
+    else
+        return "Unknown op \"" + job.op + "\"";
+
+    if ( mapFile == nullptr )
+        return "Failed to create map";
+
+    matchSaveTypeToExtension(*mapFile, job.output);
+    return mapFile->save(job.output, true) ? "" : "Failed to save output map " + job.output;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string manifestPath {};
+    std::string starCraftDirectory = "C:\\Program Files (x86)\\StarCraft";
+    std::string tracePath {};
+    size_t threadCount = std::thread::hardware_concurrency();
+    for ( int i=1; i<argc; ++i )
+    {
+        std::string arg(argv[i]);
+        if ( arg == "--threads" && i+1 < argc )
+            threadCount = size_t(std::strtoull(argv[++i], nullptr, 10));
+        else if ( arg == "--starcraft" && i+1 < argc )
+            starCraftDirectory = argv[++i];
+        else if ( arg == "--trace" && i+1 < argc )
+            tracePath = argv[++i];
+        else if ( manifestPath.empty() )
+            manifestPath = arg;
+        else
+        {
+            std::cerr << "Unexpected argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    if ( manifestPath.empty() )
+    {
+        std::cerr << "Usage: IsomBatch <manifest.json|manifest.csv> [--threads count] [--starcraft directory] [--trace traceFile.json]" << std::endl;
+        return 1;
+    }
+
+    Manifest manifest {};
+    try {
+        manifest = loadManifest(manifestPath);
+    } catch ( std::exception & e ) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    Tracer::get().setEnabled(!tracePath.empty());
+    if ( !terrainDat.load(starCraftDirectory) )
+    {
+        std::cerr << "Failed to load StarCraft terrain data from " << starCraftDirectory << std::endl;
+        return 1;
+    }
+
+    ThreadPool threadPool(threadCount);
+    BatchSummary summary { manifest.jobs.size(), 0, 0, threadPool.size() };
+    std::mutex statusLocker {};
+    auto start = std::chrono::steady_clock::now();
+    threadPool.parallelFor(manifest.jobs.size(), [&](size_t i) {
+        const Job & job = manifest.jobs[i];
+        auto jobStart = std::chrono::steady_clock::now();
+        std::string error {};
+        thread_local std::pmr::monotonic_buffer_resource arena {};
+        try {
+            error = runJob(job, arena);
+        } catch ( std::exception & e ) {
+            error = e.what();
+        }
+        arena.release(); // The job's map was destroyed when runJob returned
+        auto jobFinish = std::chrono::steady_clock::now();
+
+        JobStatus status { i, job.op, job.output, error.empty(), error, std::chrono::duration<double, std::milli>(jobFinish - jobStart).count() };
+        std::lock_guard<std::mutex> lock(statusLocker);
+        ++(status.success ? summary.succeeded : summary.failed);
+        std::cout << Json::out(status) << std::endl;
+    });
+    summary.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << Json::out(summary) << std::endl;
+
+    if ( !tracePath.empty() && !Tracer::get().writeJson(tracePath) )
+        std::cerr << "Failed to write trace to " << tracePath << std::endl;
+
+    return summary.failed == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,634 @@
+#include "../IsomTerrain/IsomApi.h"
+#include "../IsomTerrain/IsomFixtures.h"
+#include "../IsomTerrain/IsomJournal.h"
+#include "../CrossCutLib/Logger.h"
+#include "../CrossCutLib/Tracer.h"
+#include "../RareCpp/include/rarecpp/json.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#ifdef _WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Times the ISOM engine against the synthetic fixture tilesets so it runs headless without a StarCraft install, results are written as JSON
+// Usage: IsomBenchmark [outputFile.json] [traceFile.json] [--baseline baseline.json] [--time-threshold percent] [--count-threshold percent] [--fail-on-time]
+// Results go to stdout if no output file is given, if a trace file is given the timed phases are also written there as Chrome/Perfetto trace-event JSON
+//
+// With --baseline each scenario is compared against the same scenario in a previous report (e.g. Baseline.json, regenerate it by passing it as the
+// output file), the run fails if any scenario's operation counts grew by more than the count threshold
+// Operation counts are deterministic for a given seed so they're the only pass/fail check, wall time depends on the machine & its load so scenarios whose
+// fastest run slowed by more than the time threshold are only reported as advisory, compare against a baseline generated on the same machine
+// With --fail-on-time such slowdowns fail the run as well, only use it against a baseline generated on the same (otherwise idle) machine
+// Counts are only gathered when ISOM_STATS is defined, which the IsomBenchmark project does in all configurations
+//
+// Usage: IsomBenchmark --stress [--seed number] [--ops count] [--baseline stressBaseline.json] [outputFile.json] [traceFile.json]
+// Runs a sustained random workload (random brushes, sizes & positions) on a large map of each tileset, reporting placements per second, per-op
+// latency percentiles & peak memory; every diamond is validated against the isomLinks table after each op & ops that leave links inconsistent are reported
+// The radial update (like staredit's) can leave some links inconsistent, with --baseline (e.g. StressBaseline.json, made with the same seed & ops) those
+// are reported as known & the run only fails if a tileset has more inconsistent ops than in the baseline
+//
+// Usage: IsomBenchmark --replay journal.isoj [--repetitions count] [outputFile.json] [traceFile.json]
+// Replays a recorded editing session (see IsomJournal.h) against a new map of the journal's tileset & dimensions, filled with the default brush
+
+Logger logger(LogLevel::Warn);
+
+constexpr uint32_t benchmarkSeed = 0x150B;
+constexpr uint16_t mapSizes[] { 64, 128, 256 };
+constexpr size_t maxBrushSize = 10;
+constexpr size_t brushOpsPerSize = 100;
+constexpr size_t fullMapRepetitions = 5;
+constexpr double defaultTimeThreshold = 75.0; // Percent, advisory unless --fail-on-time is passed
+constexpr double defaultCountThreshold = 2.0; // Percent
+constexpr double minTimeRegressionUs = 5.0; // Smaller slowdowns are treated as noise regardless of percentage
+constexpr uint16_t stressMapSize = 256;
+constexpr size_t defaultStressOps = 2000; // Per tileset
+
+struct BenchmarkResult
+{
+    std::string tileset {};
+    uint16_t mapWidth = 0;
+    uint16_t mapHeight = 0;
+    std::string operation {};
+    size_t brushSize = 0; // Zero for operations that don't use a brush
+    size_t iterations = 0;
+    double totalMs = 0.0;
+    double meanUs = 0.0;
+    double medianUs = 0.0; // Less sensitive to stray slow iterations than the mean
+    double minUs = 0.0; // Compared against baselines as an advisory, the least sensitive to machine load
+    double maxUs = 0.0;
+    size_t diamondsVisited = 0; // Operation counts are summed across all iterations
+    size_t bestMatchSearches = 0;
+    size_t searchIterations = 0;
+    size_t tileGroupLookups = 0;
+
+    REFLECT(BenchmarkResult, tileset, mapWidth, mapHeight, operation, brushSize, iterations, totalMs, meanUs, medianUs, minUs, maxUs,
+        diamondsVisited, bestMatchSearches, searchIterations, tileGroupLookups)
+
+    using Scenario = std::tuple<std::string, uint16_t, uint16_t, std::string, size_t>;
+    inline Scenario scenario() const { return Scenario{tileset, mapWidth, mapHeight, operation, brushSize}; }
+};
+
+struct BenchmarkReport
+{
+    std::string benchmark = "IsomBenchmark";
+    uint32_t seed = benchmarkSeed;
+    std::vector<BenchmarkResult> results {};
+
+    REFLECT(BenchmarkReport, benchmark, seed, results)
+};
+
+class Timings
+{
+    std::vector<double> samplesUs {};
+    Chk::IsomStats counts {}; // Only the counters reported in BenchmarkResult are summed
+
+public:
+    template <typename Func>
+    inline void time(const Chk::IsomCache & cache, Func && func)
+    {
+        Chk::IsomStats before = cache.snapshotStats();
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto finish = std::chrono::high_resolution_clock::now();
+        samplesUs.push_back(std::chrono::duration<double, std::micro>(finish-start).count());
+
+        Chk::IsomStats after = cache.snapshotStats();
+        counts.diamondsVisited += after.diamondsVisited - before.diamondsVisited;
+        counts.bestMatchSearches += after.bestMatchSearches - before.bestMatchSearches;
+        counts.searchIterations += after.searchIterations - before.searchIterations;
+        counts.tileGroupLookups += after.tileGroupLookups - before.tileGroupLookups;
+    }
+
+    inline BenchmarkResult toResult(std::string_view tileset, uint16_t mapWidth, uint16_t mapHeight, std::string_view operation, size_t brushSize = 0) const
+    {
+        BenchmarkResult result { std::string(tileset), mapWidth, mapHeight, std::string(operation), brushSize, samplesUs.size() };
+        result.diamondsVisited = counts.diamondsVisited;
+        result.bestMatchSearches = counts.bestMatchSearches;
+        result.searchIterations = counts.searchIterations;
+        result.tileGroupLookups = counts.tileGroupLookups;
+        if ( !samplesUs.empty() )
+        {
+            double totalUs = 0.0;
+            for ( auto sampleUs : samplesUs )
+                totalUs += sampleUs;
+
+            result.totalMs = totalUs/1000.0;
+            result.meanUs = totalUs/double(samplesUs.size());
+            std::vector<double> sortedUs(samplesUs);
+            std::sort(sortedUs.begin(), sortedUs.end());
+            result.medianUs = sortedUs[sortedUs.size()/2];
+            result.minUs = sortedUs.front();
+            result.maxUs = sortedUs.back();
+        }
+        return result;
+    }
+};
+
+ScMap newScMap(Sc::Terrain::Tileset tileset, uint16_t width, uint16_t height, size_t terrainType, Chk::IsomCache & cache)
+{
+    ScMap scMap {};
+    scMap.tileWidth = width;
+    scMap.tileHeight = height;
+    scMap.tileset = tileset;
+    scMap.tiles.assign(size_t(width)*size_t(height), 0);
+    scMap.editorTiles.assign(size_t(width)*size_t(height), 0);
+
+    uint16_t isomValue = ((cache.getTerrainTypeIsomValue(terrainType) << 4) | Chk::IsomRect::EditorFlag::Modified);
+    scMap.isomRects.assign(scMap.getIsomWidth()*scMap.getIsomHeight(), Chk::IsomRect{isomValue, isomValue, isomValue, isomValue});
+
+    cache.setAllChanged();
+    scMap.updateTilesFromIsom(cache);
+    return scMap;
+}
+
+void benchmarkMapSize(size_t tilesetIndex, const Sc::Terrain_::Tiles & tiles, uint16_t mapSize, BenchmarkReport & report)
+{
+    Sc::Terrain::Tileset tileset = Sc::Terrain::Tileset(tilesetIndex);
+    std::string_view tilesetName = TestData::fixtureTilesetNames[tilesetIndex];
+    size_t defaultTerrainType = size_t(tiles.defaultBrush.index);
+    Chk::IsomCache cache(tileset, mapSize, mapSize, tiles);
+    cache.seedSubtiles(benchmarkSeed);
+
+    Timings newMapTimings {};
+    for ( size_t i=0; i<fullMapRepetitions; ++i )
+        newMapTimings.time(cache, [&]() { newScMap(tileset, mapSize, mapSize, defaultTerrainType, cache); });
+
+    report.results.push_back(newMapTimings.toResult(tilesetName, mapSize, mapSize, "newMap"));
+
+    ScMap scMap = newScMap(tileset, mapSize, mapSize, defaultTerrainType, cache);
+    std::mt19937 random(benchmarkSeed + uint32_t(tilesetIndex));
+    for ( size_t brushSize=1; brushSize<=maxBrushSize; ++brushSize )
+    {
+        Timings brushTimings {};
+        for ( size_t i=0; i<brushOpsPerSize; ++i )
+        {
+            size_t y = random() % scMap.getIsomHeight();
+            size_t x = random() % scMap.getIsomWidth();
+            if ( (x+y)%2 != 0 ) // Only diamonds with an even x+y are valid
+                x = x > 0 ? x-1 : x+1;
+
+            size_t terrainType = size_t(tiles.brushes[random() % tiles.brushes.size()].index);
+            brushTimings.time(cache, [&]() { scMap.placeIsomTerrain({x, y}, terrainType, brushSize, cache); });
+            scMap.updateTilesFromIsom(cache);
+        }
+        report.results.push_back(brushTimings.toResult(tilesetName, mapSize, mapSize, "placeIsomTerrain", brushSize));
+    }
+
+    Timings updateTimings {};
+    for ( size_t i=0; i<fullMapRepetitions; ++i )
+    {
+        for ( auto & isomRect : scMap.isomRects )
+            isomRect.left |= Chk::IsomRect::EditorFlag::Modified;
+
+        cache.setAllChanged();
+        updateTimings.time(cache, [&]() { scMap.updateTilesFromIsom(cache); });
+    }
+    report.results.push_back(updateTimings.toResult(tilesetName, mapSize, mapSize, "updateTilesFromIsom"));
+
+    Timings resizeTimings {};
+    int32_t xTileOffset = -int32_t(mapSize/4); // Shift the terrain up and left, the same-size map gets a new border along the bottom and right
+    int32_t yTileOffset = -int32_t(mapSize/4);
+    for ( size_t i=0; i<fullMapRepetitions; ++i )
+    {
+        Chk::IsomCache destCache(tileset, mapSize, mapSize, tiles);
+        destCache.seedSubtiles(benchmarkSeed);
+        ScMap destMap = newScMap(tileset, mapSize, mapSize, defaultTerrainType, destCache);
+        resizeTimings.time(destCache, [&]() {
+            destMap.copyIsomFrom(scMap, xTileOffset, yTileOffset, false, destCache);
+            destMap.resizeIsom(xTileOffset, yTileOffset, scMap.tileWidth, scMap.tileHeight, false, destCache);
+        });
+    }
+    report.results.push_back(resizeTimings.toResult(tilesetName, mapSize, mapSize, "resizeIsom"));
+}
+
+struct StressResult
+{
+    std::string tileset {};
+    uint16_t mapWidth = 0;
+    uint16_t mapHeight = 0;
+    size_t operations = 0;
+    double totalMs = 0.0; // Time spent placing & updating tiles, excludes validation
+    double placementsPerSecond = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    size_t inconsistentOps = 0; // Ops after which one or more diamonds failed validation, inconsistencies aren't repaired so they may carry over
+    int64_t firstInconsistentOp = -1; // -1 if every op left the map consistent
+    size_t finalLinkMismatches = 0; // Link mismatches left on the map after the last op
+    size_t diamondsValidated = 0;
+
+    REFLECT(StressResult, tileset, mapWidth, mapHeight, operations, totalMs, placementsPerSecond, p50Us, p99Us, maxUs,
+        inconsistentOps, firstInconsistentOp, finalLinkMismatches, diamondsValidated)
+};
+
+struct StressReport
+{
+    std::string benchmark = "IsomStress";
+    uint32_t seed = benchmarkSeed;
+    size_t peakMemoryBytes = 0; // Peak working set/resident set size of the process
+    std::vector<StressResult> results {};
+
+    REFLECT(StressReport, benchmark, seed, peakMemoryBytes, results)
+};
+
+size_t getPeakMemoryBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS memoryCounters {};
+    if ( GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)) )
+        return size_t(memoryCounters.PeakWorkingSetSize);
+#else
+    rusage usage {};
+    if ( getrusage(RUSAGE_SELF, &usage) == 0 )
+        return size_t(usage.ru_maxrss) * 1024; // Kilobytes on Linux
+#endif
+    return 0;
+}
+
+StressResult stressTileset(size_t tilesetIndex, const Sc::Terrain_::Tiles & tiles, uint32_t seed, size_t totalOps)
+{
+    Sc::Terrain::Tileset tileset = Sc::Terrain::Tileset(tilesetIndex);
+    std::string_view tilesetName = TestData::fixtureTilesetNames[tilesetIndex];
+    Chk::IsomCache cache(tileset, stressMapSize, stressMapSize, tiles);
+    cache.seedSubtiles(seed + uint32_t(tilesetIndex));
+    ScMap scMap = newScMap(tileset, stressMapSize, stressMapSize, size_t(tiles.defaultBrush.index), cache);
+
+    std::mt19937 random(seed + uint32_t(tilesetIndex));
+    std::vector<double> samplesUs {};
+    samplesUs.reserve(totalOps);
+    StressResult result { std::string(tilesetName), stressMapSize, stressMapSize, totalOps };
+    for ( size_t op=0; op<totalOps; ++op )
+    {
+        size_t y = random() % scMap.getIsomHeight();
+        size_t x = random() % scMap.getIsomWidth();
+        if ( (x+y)%2 != 0 ) // Only diamonds with an even x+y are valid
+            x = x > 0 ? x-1 : x+1;
+
+        size_t terrainType = size_t(tiles.brushes[random() % tiles.brushes.size()].index);
+        size_t brushSize = 1 + random() % maxBrushSize;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        scMap.placeIsomTerrain({x, y}, terrainType, brushSize, cache);
+        scMap.updateTilesFromIsom(cache);
+        auto finish = std::chrono::high_resolution_clock::now();
+        samplesUs.push_back(std::chrono::duration<double, std::micro>(finish-start).count());
+
+        Chk::IsomValidationReport report = scMap.validateIsom(cache);
+        result.diamondsValidated += report.diamondsChecked;
+        result.finalLinkMismatches = report.linkMismatches;
+        if ( !report.isConsistent() )
+        {
+            if ( result.inconsistentOps++ == 0 )
+            {
+                result.firstInconsistentOp = int64_t(op);
+                std::cerr << "INCONSISTENT - " << tilesetName << " op " << op << " (terrainType " << terrainType << " at " << x << ", " << y << " brush " << brushSize
+                    << ") - " << report.invalidValues << " invalid values, " << report.quadrantMismatches << " quadrant mismatches, "
+                    << report.linkMismatches << " link mismatches" << std::endl;
+            }
+        }
+    }
+
+    double totalUs = 0.0;
+    for ( auto sampleUs : samplesUs )
+        totalUs += sampleUs;
+
+    std::sort(samplesUs.begin(), samplesUs.end());
+    if ( !samplesUs.empty() )
+    {
+        result.totalMs = totalUs/1000.0;
+        result.placementsPerSecond = totalUs > 0.0 ? double(samplesUs.size()) * 1000000.0 / totalUs : 0.0;
+        result.p50Us = samplesUs[samplesUs.size()/2];
+        result.p99Us = samplesUs[std::min(samplesUs.size()-1, samplesUs.size()*99/100)];
+        result.maxUs = samplesUs.back();
+    }
+    return result;
+}
+
+StressReport runStress(uint32_t seed, size_t totalOps)
+{
+    StressReport report { "IsomStress", seed };
+    for ( size_t tilesetIndex=0; tilesetIndex<TestData::totalFixtureTilesets; ++tilesetIndex )
+    {
+        Sc::Terrain_::Tiles tiles = TestData::makeFixtureTiles(tilesetIndex);
+        report.results.push_back(stressTileset(tilesetIndex, tiles, seed, totalOps));
+    }
+    report.peakMemoryBytes = getPeakMemoryBytes();
+    return report;
+}
+
+// Prints how many ops of each tileset left the map inconsistent to stderr, as known if the baseline had at least as many
+// Returns the number of tilesets with more inconsistent ops than the baseline, without a baseline inconsistencies are only reported
+size_t compareStressToBaseline(const StressReport* baseline, const StressReport & report)
+{
+    size_t regressions = 0;
+    for ( const auto & result : report.results )
+    {
+        const StressResult* base = nullptr;
+        if ( baseline != nullptr )
+        {
+            for ( const auto & baseResult : baseline->results )
+            {
+                if ( baseResult.tileset == result.tileset && baseResult.operations == result.operations )
+                    base = &baseResult;
+            }
+        }
+
+        if ( base != nullptr && result.inconsistentOps > base->inconsistentOps )
+        {
+            ++regressions;
+            std::cerr << "REGRESSION - " << result.tileset << " - inconsistent ops " << base->inconsistentOps << " -> " << result.inconsistentOps << std::endl;
+        }
+        else if ( result.inconsistentOps > 0 )
+        {
+            std::cerr << "KNOWN - " << result.tileset << " - " << result.inconsistentOps << " / " << result.operations << " ops left links inconsistent, "
+                << result.finalLinkMismatches << " link mismatches at the end" << (base != nullptr ? " (baseline " + std::to_string(base->inconsistentOps) + ")" : "")
+                << std::endl;
+        }
+    }
+    std::cerr << (regressions == 0 ? "PASS - " : "FAIL - ") << regressions << " tilesets with more inconsistent ops than the baseline"
+        << (baseline != nullptr ? "" : " (no baseline given, inconsistencies only reported)") << std::endl;
+    return regressions;
+}
+
+struct ReplayReport
+{
+    std::string benchmark = "IsomReplay";
+    std::string tileset {};
+    uint16_t mapWidth = 0;
+    uint16_t mapHeight = 0;
+    size_t journalBytes = 0;
+    size_t operations = 0; // Per repetition
+    size_t batches = 0;
+    size_t repetitions = 0;
+    double totalMs = 0.0;
+    double operationsPerSecond = 0.0;
+    double minRepetitionMs = 0.0;
+
+    REFLECT(ReplayReport, benchmark, tileset, mapWidth, mapHeight, journalBytes, operations, batches, repetitions, totalMs, operationsPerSecond, minRepetitionMs)
+};
+
+std::optional<ReplayReport> runReplay(const IsomJournal & journal, size_t repetitions)
+{
+    size_t tilesetIndex = size_t(journal.getTileset());
+    if ( tilesetIndex >= TestData::totalFixtureTilesets )
+    {
+        std::cerr << "The journal's tileset has no fixture tileset to replay on" << std::endl;
+        return std::nullopt;
+    }
+
+    Sc::Terrain_::Tiles tiles = TestData::makeFixtureTiles(tilesetIndex);
+    Chk::IsomCache baseCache(journal.getTileset(), journal.getTileWidth(), journal.getTileHeight(), tiles);
+    const ScMap baseMap = newScMap(journal.getTileset(), journal.getTileWidth(), journal.getTileHeight(), size_t(tiles.defaultBrush.index), baseCache);
+
+    ReplayReport report {};
+    report.tileset = std::string(TestData::fixtureTilesetNames[tilesetIndex]);
+    report.mapWidth = journal.getTileWidth();
+    report.mapHeight = journal.getTileHeight();
+    report.journalBytes = journal.getBytes().size();
+    report.repetitions = repetitions;
+    for ( size_t i=0; i<repetitions; ++i )
+    {
+        ScMap scMap = baseMap;
+        auto start = std::chrono::high_resolution_clock::now();
+        IsomJournal::ReplayResult result = journal.replay(scMap, tiles);
+        double repetitionMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        if ( !result.success )
+        {
+            std::cerr << "Replay failed: " << result.error << std::endl;
+            return std::nullopt;
+        }
+        report.operations = result.operations;
+        report.batches = result.batches;
+        report.totalMs += repetitionMs;
+        report.minRepetitionMs = i == 0 ? repetitionMs : std::min(report.minRepetitionMs, repetitionMs);
+    }
+    report.operationsPerSecond = report.totalMs > 0.0 ? double(report.operations*repetitions) * 1000.0 / report.totalMs : 0.0;
+    return report;
+}
+
+template <typename Report>
+bool writeReport(const Report & report, const std::string & outputPath)
+{
+    if ( outputPath.empty() )
+        std::cout << Json::pretty(report) << std::endl;
+    else
+    {
+        std::ofstream outFile(outputPath);
+        if ( !outFile )
+        {
+            std::cerr << "Failed to open " << outputPath << " for writing" << std::endl;
+            return false;
+        }
+        outFile << Json::pretty(report) << std::endl;
+    }
+    return true;
+}
+
+bool exceedsThreshold(double baseline, double current, double thresholdPercent)
+{
+    return current > baseline * (1.0 + thresholdPercent/100.0);
+}
+
+double percentChange(double baseline, double current)
+{
+    return baseline == 0.0 ? 100.0 : 100.0 * (current - baseline) / baseline;
+}
+
+// Prints each scenario whose counts regressed past the count threshold or whose time slowed past the time threshold to stderr
+// Returns the number of count regressions, slowdowns in time are advisory and not counted unless failOnTime is set
+size_t compareToBaseline(const BenchmarkReport & baseline, const BenchmarkReport & report, double timeThreshold, double countThreshold, bool failOnTime)
+{
+    std::map<BenchmarkResult::Scenario, const BenchmarkResult*> baselineResults {};
+    for ( const auto & result : baseline.results )
+        baselineResults.insert(std::make_pair(result.scenario(), &result));
+
+    size_t regressions = 0;
+    size_t slowdowns = 0;
+    for ( const auto & result : report.results )
+    {
+        std::string scenarioName = result.tileset + " " + std::to_string(result.mapWidth) + "x" + std::to_string(result.mapHeight) + " " + result.operation
+            + (result.brushSize == 0 ? "" : " brush " + std::to_string(result.brushSize));
+
+        auto found = baselineResults.find(result.scenario());
+        if ( found == baselineResults.end() )
+        {
+            std::cerr << "NEW - " << scenarioName << " - not in baseline" << std::endl;
+            continue;
+        }
+
+        const BenchmarkResult & base = *found->second;
+        auto checkCount = [&](const char* counter, size_t baseCount, size_t count) {
+            if ( Chk::IsomStats::enabled && exceedsThreshold(double(baseCount), double(count), countThreshold) )
+            {
+                ++regressions;
+                std::cerr << "REGRESSION - " << scenarioName << " - " << counter << " " << baseCount << " -> " << count
+                    << " (+" << percentChange(double(baseCount), double(count)) << "%)" << std::endl;
+            }
+        };
+        checkCount("diamondsVisited", base.diamondsVisited, result.diamondsVisited);
+        checkCount("bestMatchSearches", base.bestMatchSearches, result.bestMatchSearches);
+        checkCount("searchIterations", base.searchIterations, result.searchIterations);
+        checkCount("tileGroupLookups", base.tileGroupLookups, result.tileGroupLookups);
+
+        if ( exceedsThreshold(base.minUs, result.minUs, timeThreshold) && result.minUs - base.minUs >= minTimeRegressionUs )
+        {
+            ++slowdowns;
+            std::cerr << (failOnTime ? "REGRESSION - " : "SLOWER - ") << scenarioName << " - minUs " << base.minUs << " -> " << result.minUs
+                << " (+" << percentChange(base.minUs, result.minUs) << (failOnTime ? "%)" : "%, advisory)") << std::endl;
+        }
+        baselineResults.erase(found);
+    }
+
+    for ( const auto & [scenario, missing] : baselineResults )
+        std::cerr << "MISSING - " << missing->tileset << " " << missing->mapWidth << "x" << missing->mapHeight << " " << missing->operation << " - only in baseline" << std::endl;
+
+    bool failed = regressions > 0 || (failOnTime && slowdowns > 0);
+    std::cerr << (failed ? "FAIL - " : "PASS - ") << regressions << " count regressions across " << report.results.size() << " scenarios"
+        << (Chk::IsomStats::enabled ? "" : " (operation counts not compared, ISOM_STATS is not defined)")
+        << ", " << slowdowns << (failOnTime ? " slower" : " slower (advisory)") << std::endl;
+    return failOnTime ? regressions + slowdowns : regressions;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> paths {}; // Output file then trace file
+    std::string baselinePath {};
+    bool stress = false;
+    std::string replayPath {};
+    size_t replayRepetitions = 1;
+    uint32_t seed = benchmarkSeed;
+    size_t stressOps = defaultStressOps;
+    double timeThreshold = defaultTimeThreshold;
+    double countThreshold = defaultCountThreshold;
+    bool failOnTime = false;
+    for ( int i=1; i<argc; ++i )
+    {
+        std::string arg(argv[i]);
+        if ( arg == "--stress" )
+            stress = true;
+        else if ( arg == "--replay" && i+1 < argc )
+            replayPath = argv[++i];
+        else if ( arg == "--repetitions" && i+1 < argc )
+            replayRepetitions = std::max(size_t(1), size_t(std::strtoull(argv[++i], nullptr, 10)));
+        else if ( arg == "--seed" && i+1 < argc )
+            seed = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+        else if ( arg == "--ops" && i+1 < argc )
+            stressOps = size_t(std::strtoull(argv[++i], nullptr, 10));
+        else if ( arg == "--baseline" && i+1 < argc )
+            baselinePath = argv[++i];
+        else if ( arg == "--time-threshold" && i+1 < argc )
+            timeThreshold = std::strtod(argv[++i], nullptr);
+        else if ( arg == "--count-threshold" && i+1 < argc )
+            countThreshold = std::strtod(argv[++i], nullptr);
+        else if ( arg == "--fail-on-time" )
+            failOnTime = true;
+        else if ( paths.size() < 2 )
+            paths.push_back(arg);
+        else
+        {
+            std::cerr << "Unexpected argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+    std::string outputPath = paths.size() > 0 ? paths[0] : "";
+    std::string tracePath = paths.size() > 1 ? paths[1] : "";
+
+    Tracer::get().setEnabled(!tracePath.empty());
+    if ( !replayPath.empty() )
+    {
+        auto journal = IsomJournal::load(replayPath);
+        if ( !journal )
+        {
+            std::cerr << "Failed to load journal " << replayPath << std::endl;
+            return 1;
+        }
+        auto report = runReplay(*journal, replayRepetitions);
+        if ( !report || !writeReport(*report, outputPath) )
+            return 1;
+        else if ( !tracePath.empty() && !Tracer::get().writeJson(tracePath) )
+        {
+            std::cerr << "Failed to write trace to " << tracePath << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    else if ( stress )
+    {
+        StressReport report = runStress(seed, stressOps);
+        if ( !writeReport(report, outputPath) )
+            return 1;
+        else if ( !tracePath.empty() && !Tracer::get().writeJson(tracePath) )
+        {
+            std::cerr << "Failed to write trace to " << tracePath << std::endl;
+            return 1;
+        }
+
+        StressReport baseline {};
+        if ( !baselinePath.empty() )
+        {
+            std::ifstream baselineFile(baselinePath);
+            if ( !baselineFile )
+            {
+                std::cerr << "Failed to open stress baseline " << baselinePath << std::endl;
+                return 1;
+            }
+            baselineFile >> Json::in(baseline);
+            if ( baseline.seed != seed )
+            {
+                std::cerr << "Stress baseline " << baselinePath << " was made with a different seed, regenerate it" << std::endl;
+                return 1;
+            }
+        }
+        return compareStressToBaseline(baselinePath.empty() ? nullptr : &baseline, report) == 0 ? 0 : 1;
+    }
+
+    BenchmarkReport baseline {};
+    if ( !baselinePath.empty() )
+    {
+        std::ifstream baselineFile(baselinePath);
+        if ( !baselineFile )
+        {
+            std::cerr << "Failed to open baseline " << baselinePath << std::endl;
+            return 1;
+        }
+        baselineFile >> Json::in(baseline);
+        if ( baseline.seed != benchmarkSeed )
+        {
+            std::cerr << "Baseline " << baselinePath << " was made with a different seed, regenerate it" << std::endl;
+            return 1;
+        }
+    }
+
+    BenchmarkReport report {};
+    for ( size_t tilesetIndex=0; tilesetIndex<TestData::totalFixtureTilesets; ++tilesetIndex )
+    {
+        Sc::Terrain_::Tiles tiles = TestData::makeFixtureTiles(tilesetIndex);
+        for ( auto mapSize : mapSizes )
+            benchmarkMapSize(tilesetIndex, tiles, mapSize, report);
+    }
+
+    if ( !writeReport(report, outputPath) )
+        return 1;
+    else if ( !tracePath.empty() && !Tracer::get().writeJson(tracePath) )
+    {
+        std::cerr << "Failed to write trace to " << tracePath << std::endl;
+        return 1;
+    }
+
+    if ( !baselinePath.empty() && compareToBaseline(baseline, report, timeThreshold, countThreshold, failOnTime) > 0 )
+        return 1;
+
+    return 0;
+}
\ No newline at end of file
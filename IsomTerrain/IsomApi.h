@@ -1,15 +1,24 @@
 #ifndef ISOMAPI_H
 #define ISOMAPI_H
 #include "../CrossCutLib/Logger.h"
+#include "../CrossCutLib/ThreadPool.h"
+#include "../CrossCutLib/Tracer.h"
 #include "../MappingCoreLib/MappingCore.h"
 #include <chrono>
 #include <cstdint>
+#include <random>
 #include <string_view>
 
 // This file pulls out the majority of code related to ISOM from the various places they'd otherwise be found in Chkdraft's mapping core code 
 
 extern Logger logger;
 
+#ifdef ISOM_STATS // Define in project properties to count hot-path work in IsomCache::stats, counting is compiled out otherwise
+#define ISOM_STAT(...) __VA_ARGS__
+#else
+#define ISOM_STAT(...)
+#endif
+
 namespace Sc {
     
     struct BoundingBox
@@ -204,6 +213,11 @@ namespace Sc {
             BottomRightQuadrant bottomRight {};
             BottomLeftQuadrant bottomLeft {};
 
+            // Whether a quadrant with the given linkId links up with the facing quadrant of a neighboring shape
+            static constexpr bool linksMatch(LinkId linkId, uint16_t terrainType, LinkId neighborLinkId, uint16_t neighborTerrainType) {
+                return neighborLinkId == linkId && (linkId < LinkId::OnlyMatchSameType || terrainType == neighborTerrainType);
+            }
+
             constexpr LinkId getLinkId(Quadrant quadrant) const {
                 switch ( quadrant )
                 {
@@ -214,6 +228,20 @@ namespace Sc {
                 }
             }
 
+            static constexpr uint32_t getQuadrantHash(Quadrant quadrant, Link firstSideLink, Link secondSideLink) {
+                return (uint32_t(quadrant) << 6 | uint32_t(firstSideLink)) << 6 | uint32_t(secondSideLink); // 6 bits per component (quadrant, first side, second side)
+            }
+
+            constexpr uint32_t getQuadrantHash(Quadrant quadrant) const {
+                switch ( quadrant )
+                {
+                    case Quadrant::TopLeft: return getQuadrantHash(quadrant, topLeft.right, topLeft.bottom);
+                    case Quadrant::TopRight: return getQuadrantHash(quadrant, topRight.left, topRight.bottom);
+                    case Quadrant::BottomRight: return getQuadrantHash(quadrant, bottomRight.left, bottomRight.top);
+                    default: /*Quadrant::BottomLeft*/ return getQuadrantHash(quadrant, bottomLeft.top, bottomLeft.right);
+                }
+            }
+
             constexpr Link getEdgeLink(uint16_t isomValue) const {
                 switch ( isomValue & EdgeFlags::Mask ) {
                     case EdgeFlags::TopLeft_Right: return topLeft.right;
@@ -1089,9 +1117,34 @@ namespace Sc {
         };
 
         static constexpr Span<size_t> defaultBrushIndex { Brush::defaultBrushIndex };
+
+        // Maps each brush in the source tileset to the brush of the same name in the destination tileset, terrain types without a match map to zero
+        inline std::vector<uint16_t> getTerrainTypeMappingByName(size_t sourceTilesetIndex, size_t destTilesetIndex)
+        {
+            const auto & sourceTerrainTypes = tilesetTerrainTypes[sourceTilesetIndex];
+            const auto & destTerrainTypes = tilesetTerrainTypes[destTilesetIndex];
+            std::vector<uint16_t> terrainTypeMapping(sourceTerrainTypes.size(), uint16_t(0));
+            for ( const auto & sourceTerrainType : sourceTerrainTypes )
+            {
+                if ( sourceTerrainType.brushSortOrder < 0 )
+                    continue;
+
+                for ( const auto & destTerrainType : destTerrainTypes )
+                {
+                    if ( destTerrainType.brushSortOrder >= 0 && destTerrainType.name == sourceTerrainType.name )
+                    {
+                        terrainTypeMapping[sourceTerrainType.index] = destTerrainType.index;
+                        break;
+                    }
+                }
+            }
+            return terrainTypeMapping;
+        }
     };
 
-    struct Terrain_ { // Terrain dat, altered from the Sc::Terrain found in Sc.h
+    // Terrain dat, altered from the Sc::Terrain found in Sc.h
+    // Only load modifies Terrain_, afterwards get only hands out const Tiles so one loaded instance can be shared by any number of threads & IsomCaches
+    struct Terrain_ {
         static constexpr size_t NumTilesets = 8;
 
 #pragma pack(push, 1)
@@ -1114,6 +1167,7 @@ namespace Sc {
 
             std::vector<uint16_t> terrainTypeMap {};
             std::unordered_map<uint32_t, std::vector<uint16_t>> hashToTileGroup {};
+            std::unordered_map<uint32_t, std::vector<uint16_t>> quadrantHashToIsomValues {}; // Inverse of the isomLinks table, used to recover ISOM from tiles
             std::vector<Isom::ShapeLinks> isomLinks {};
             Span<Isom::TerrainTypeInfo> terrainTypes {};
             std::vector<Isom::TerrainTypeInfo> brushes {};
@@ -1299,8 +1353,22 @@ namespace Sc {
                 }
 
                 generateIsomLinks();
+                populateIsomLookups(tilesetIndex);
+            }
+
+            // Builds what's derived from isomLinks & terrainTypes once they're set: the quadrant hash lookup and the brushes in brush sort order
+            inline void populateIsomLookups(size_t tilesetIndex)
+            {
+                for ( size_t isomValue=1; isomValue<isomLinks.size(); ++isomValue )
+                {
+                    if ( isomLinks[isomValue].terrainType == 0 )
+                        continue;
+
+                    for ( auto quadrant : Isom::quadrants )
+                        quadrantHashToIsomValues[isomLinks[isomValue].getQuadrantHash(quadrant)].push_back(uint16_t(isomValue));
+                }
 
-                for ( const auto & terrainType : terrainTypeInfo )
+                for ( const auto & terrainType : terrainTypes )
                 {
                     if ( terrainType.brushSortOrder >= 0 )
                         brushes.push_back(terrainType);
@@ -1308,7 +1376,7 @@ namespace Sc {
                 std::sort(brushes.begin(), brushes.end(), [&](const Isom::TerrainTypeInfo & l, const Isom::TerrainTypeInfo & r) {
                     return l.brushSortOrder < r.brushSortOrder;
                 });
-                defaultBrush = terrainTypeInfo[Isom::defaultBrushIndex[tilesetIndex]];
+                defaultBrush = terrainTypes[Isom::defaultBrushIndex[tilesetIndex]];
             }
 
             inline bool load(size_t tilesetIndex, const std::vector<ArchiveFilePtr> & orderedSourceFiles, const std::string & tilesetName)
@@ -1361,6 +1429,7 @@ namespace Sc {
 
         inline bool load(const std::vector<ArchiveFilePtr> & orderedSourceFiles)
         {
+            TraceSpan traceSpan("Sc::Terrain_::load");
             auto start = std::chrono::high_resolution_clock::now();
             bool success = true;
             for ( size_t i=0; i<NumTilesets; i++ )
@@ -1524,6 +1593,8 @@ namespace Chk {
 
         constexpr void setVisited() { right |= EditorFlag::Visited; }
 
+        constexpr void clearVisited() { right &= EditorFlag::xVisited; }
+
         constexpr void clearEditorFlags() {
             left &= EditorFlag::ClearAll;
             top &= EditorFlag::ClearAll;
@@ -1572,8 +1643,44 @@ namespace Chk {
         }
     };
 
+    // Counters for the hottest loops in ISOM editing, these stay zero unless ISOM_STATS is defined
+    struct IsomStats
+    {
+        size_t diamondsEnqueued = 0; // Diamonds added to the radial update queue, including the initial diamonds
+        size_t diamondsVisited = 0; // Diamonds popped from the radial update queue which needed an update
+        size_t queueHighWater = 0; // Largest size of the radial update queue
+        size_t bestMatchSearches = 0; // Calls to searchForBestMatch
+        size_t searchIterations = 0; // isomValues checked across all best match searches
+        size_t neighborMatchCounts = 0; // Calls to countNeighborMatches
+        size_t tileGroupLookups = 0; // Lookups in hashToTileGroup
+        size_t tileGroupLookupMisses = 0; // Lookups in hashToTileGroup which found no tile group
+        size_t stackWalkRows = 0; // Rows walked up and down tile-group stacks in updateTileFromIsom
+        size_t maxStackWalkDepth = 0; // Most rows walked for a single diamond in updateTileFromIsom
+
+        static constexpr bool enabled =
+#ifdef ISOM_STATS
+            true;
+#else
+            false;
+#endif
+    };
+
     // IsomCache holds all the data required to edit isometric terrain which is not a part of scenario; as well as methods that operate on said data exclusively
     // IsomCache is invalidated & must be re-created whenever tileset, map width, or map height changes
+    // The tileset data is only read through const spans/pointers, all mutable editing state (including subtile randomness) is per-cache so maps can be edited
+    // concurrently without locks as long as each thread uses its own IsomCache
+    struct IsomStamp;
+
+    // Receives the placements, flood fills & pastes made with an IsomCache as they're made, e.g. IsomJournal (see IsomJournal.h)
+    class IsomEditRecorder
+    {
+    public:
+        virtual inline ~IsomEditRecorder() = default;
+        virtual inline void recordPlace(IsomDiamond isomDiamond, size_t terrainType, size_t brushSize) = 0;
+        virtual inline void recordFloodFill(IsomDiamond isomDiamond, size_t terrainType) = 0;
+        virtual inline void recordPaste(const IsomStamp & stamp, IsomDiamond topLeft) = 0;
+    };
+
     struct IsomCache
     {
         Sc::Terrain::Tileset tileset; // If tileset changes the cache should be recreated with the new tileset
@@ -1588,6 +1695,12 @@ namespace Chk {
         Span<Sc::Isom::TerrainTypeInfo> terrainTypes {};
         Span<uint16_t> terrainTypeMap {};
         const std::unordered_map<uint32_t, std::vector<uint16_t>>* hashToTileGroup;
+        const std::unordered_map<uint32_t, std::vector<uint16_t>>* quadrantHashToIsomValues;
+
+        IsomStats stats {}; // Only counted if ISOM_STATS is defined
+        std::minstd_rand subtileRandom {}; // Used in place of std::rand so caches share no hidden state, see seedSubtiles
+        bool recordUndos = true; // If false edits skip all undo bookkeeping regardless of whether they're undoable, e.g. while replaying a journal
+        IsomEditRecorder* recorder = nullptr; // If set, placements, flood fills & pastes made with this cache are passed to this recorder
 
         inline IsomCache(Sc::Terrain::Tileset tileset, size_t tileWidth, size_t tileHeight, const Sc::Terrain_::Tiles & tilesetData) :
             tileset(tileset),
@@ -1598,6 +1711,7 @@ namespace Chk {
             terrainTypes(&tilesetData.terrainTypes[0], tilesetData.terrainTypes.size()),
             terrainTypeMap(&tilesetData.terrainTypeMap[0], tilesetData.terrainTypeMap.size()),
             hashToTileGroup(&tilesetData.hashToTileGroup),
+            quadrantHashToIsomValues(&tilesetData.quadrantHashToIsomValues),
             undoMap(isomWidth*isomHeight, std::nullopt)
         {
             resetChangedArea();
@@ -1619,12 +1733,27 @@ namespace Chk {
             changedArea.bottom = isomHeight-1;
         }
 
+        constexpr IsomStats snapshotStats() const
+        {
+            return stats;
+        }
+
+        constexpr void resetStats()
+        {
+            stats = {};
+        }
+
+        inline void seedSubtiles(uint32_t seed) // The same seed and edits produce the same subtiles
+        {
+            subtileRandom.seed(seed);
+        }
+
         constexpr uint16_t getTerrainTypeIsomValue(size_t terrainType) const
         {
             return terrainType < terrainTypes.size() ? terrainTypes[terrainType].isomValue : 0;
         }
 
-        inline uint16_t getRandomSubtile(uint16_t tileGroup) const
+        inline uint16_t getRandomSubtile(uint16_t tileGroup)
         {
             if ( tileGroup < tileGroups.size() )
             {
@@ -1633,10 +1762,10 @@ namespace Chk {
                 for ( ; totalCommon < 16 && tileGroups[tileGroup].megaTileIndex[totalCommon] != 0; ++totalCommon );
                 for ( ; totalCommon+totalRare+1 < 16 && tileGroups[tileGroup].megaTileIndex[totalCommon+totalRare+1] != 0; ++totalRare );
 
-                if ( totalRare != 0 && std::rand() <= RAND_MAX / 20 ) // 1 in 20 chance of using a rare tile
-                    return 16*tileGroup + uint16_t(totalCommon + 1 + (std::rand() % totalRare)); // Select particular rare tile
+                if ( totalRare != 0 && subtileRandom() % 20 == 0 ) // 1 in 20 chance of using a rare tile
+                    return 16*tileGroup + uint16_t(totalCommon + 1 + (subtileRandom() % totalRare)); // Select particular rare tile
                 else if ( totalCommon != 0 ) // Use a common tile
-                    return 16*tileGroup + uint16_t(std::rand() % totalCommon); // Select particular common tile
+                    return 16*tileGroup + uint16_t(subtileRandom() % totalCommon); // Select particular common tile
             }
             return 16*tileGroup; // Default/fall-back to first tile in group
         }
@@ -1652,6 +1781,104 @@ namespace Chk {
         }
     };
     #pragma pack(pop)
+
+    // A summary of the diamonds in an ISOM section which disagree with the isomLinks table of the tileset
+    struct IsomValidationReport
+    {
+        struct Issue_ {
+            enum uint8_t_ : uint8_t {
+                None = 0x0,
+                InvalidValue = 0x1, // The central isomValue is zero or has no terrain type in the isomLinks table
+                QuadrantMismatch = 0x2, // The four projected quadrants of the diamond do not hold the same isomValue
+                LinkMismatch = 0x4 // One or more neighboring diamonds do not link up with this diamond
+            };
+        };
+        using Issue = Issue_::uint8_t_;
+
+        bool undersized = false; // The ISOM section is too small for the map dimensions, nothing else was checked
+        size_t diamondsChecked = 0;
+        size_t invalidValues = 0;
+        size_t quadrantMismatches = 0;
+        size_t linkMismatches = 0;
+        std::vector<IsomDiamond> inconsistentDiamonds {}; // Every diamond with one or more issues, in row-major order
+        std::vector<Sc::BoundingBox> inconsistentRegions {}; // Inclusive isom-coordinate bounds around connected groups of inconsistent diamonds
+
+        inline bool isConsistent() const { return !undersized && inconsistentDiamonds.empty(); }
+
+        inline void addIssue(IsomDiamond isomDiamond, uint8_t issues)
+        {
+            invalidValues += (issues & Issue::InvalidValue) ? 1 : 0;
+            quadrantMismatches += (issues & Issue::QuadrantMismatch) ? 1 : 0;
+            linkMismatches += (issues & Issue::LinkMismatch) ? 1 : 0;
+            inconsistentDiamonds.push_back(isomDiamond);
+        }
+
+        // Groups inconsistentDiamonds into inconsistentRegions, diamonds are grouped if they neighbor each other or are two apart along a row or column
+        // Regions depend only on the diamonds found, so reports made serially or in bands always agree
+        inline void groupRegions()
+        {
+            inconsistentRegions.clear();
+            std::vector<size_t> parents(inconsistentDiamonds.size());
+            for ( size_t i=0; i<parents.size(); ++i )
+                parents[i] = i;
+
+            auto findRoot = [&](size_t i) {
+                while ( parents[i] != i )
+                    i = parents[i] = parents[parents[i]];
+                return i;
+            };
+            auto rowMajorLess = [](const IsomDiamond & lhs, const IsomDiamond & rhs) { return lhs.y < rhs.y || (lhs.y == rhs.y && lhs.x < rhs.x); };
+            for ( size_t i=0; i<inconsistentDiamonds.size(); ++i ) // Diamonds are in row-major order, so only diamonds after this one need to be joined
+            {
+                const IsomDiamond & isomDiamond = inconsistentDiamonds[i];
+                IsomDiamond laterDiamonds[] { {isomDiamond.x+2, isomDiamond.y}, {isomDiamond.x-1, isomDiamond.y+1}, {isomDiamond.x+1, isomDiamond.y+1},
+                    {isomDiamond.x, isomDiamond.y+2} };
+                for ( const auto & laterDiamond : laterDiamonds )
+                {
+                    auto found = std::lower_bound(inconsistentDiamonds.begin()+i, inconsistentDiamonds.end(), laterDiamond, rowMajorLess);
+                    if ( found != inconsistentDiamonds.end() && found->x == laterDiamond.x && found->y == laterDiamond.y )
+                        parents[findRoot(size_t(std::distance(inconsistentDiamonds.begin(), found)))] = findRoot(i);
+                }
+            }
+
+            std::vector<size_t> rootRegions(inconsistentDiamonds.size(), SIZE_MAX); // Regions are ordered by their first diamond
+            for ( size_t i=0; i<inconsistentDiamonds.size(); ++i )
+            {
+                size_t root = findRoot(i);
+                const IsomDiamond & isomDiamond = inconsistentDiamonds[i];
+                if ( rootRegions[root] == SIZE_MAX )
+                {
+                    rootRegions[root] = inconsistentRegions.size();
+                    inconsistentRegions.push_back(Sc::BoundingBox{isomDiamond.x, isomDiamond.y, isomDiamond.x, isomDiamond.y});
+                }
+                else
+                    inconsistentRegions[rootRegions[root]].expandToInclude(isomDiamond.x, isomDiamond.y);
+            }
+        }
+
+        // Appends the report for a band of rows below the rows covered by this report
+        inline void append(const IsomValidationReport & band)
+        {
+            undersized |= band.undersized;
+            diamondsChecked += band.diamondsChecked;
+            invalidValues += band.invalidValues;
+            quadrantMismatches += band.quadrantMismatches;
+            linkMismatches += band.linkMismatches;
+            inconsistentDiamonds.insert(inconsistentDiamonds.end(), band.inconsistentDiamonds.begin(), band.inconsistentDiamonds.end());
+        }
+    };
+
+    // A rectangular block of resolved ISOM rects and the tiles generated from them, captured once per tileset and placed without re-painting
+    struct IsomStamp
+    {
+        Sc::Terrain::Tileset tileset {Sc::Terrain::Tileset::Badlands};
+        size_t width = 0; // Width in isom rects, the tile width is twice this
+        size_t height = 0; // Height in isom rects, the same as the tile height
+        std::vector<IsomRect> isomRects {};
+        std::vector<uint16_t> tiles {};
+
+        inline bool isEmpty() const { return width == 0 || height == 0; }
+    };
 }
 
 struct ScMap
@@ -1682,6 +1909,10 @@ struct ScMap
     
     inline bool placeIsomTerrain(Chk::IsomDiamond isomDiamond, size_t terrainType, size_t brushExtent, Chk::IsomCache & cache)
     {
+        TraceSpan traceSpan("ScMap::placeIsomTerrain");
+        if ( cache.recorder != nullptr )
+            cache.recorder->recordPlace(isomDiamond, terrainType, brushExtent);
+
         uint16_t isomValue = cache.getTerrainTypeIsomValue(terrainType);
         if ( isomValue == 0 || !isomDiamond.isValid() || size_t(isomValue) >= cache.isomLinks.size() || cache.isomLinks[size_t(isomValue)].terrainType == 0 )
             return false;
@@ -1720,6 +1951,253 @@ struct ScMap
         radiallyUpdateTerrain(true, diamondsToUpdate, cache);
         return true;
     }
+
+    // Replaces every diamond connected to isomDiamond that shares its terrain type with the given terrain type, then resolves the borders of the filled region
+    // Like placeIsomTerrain this expects the editor flags to be clear, the region is gathered using the visited flags so nothing map-sized is allocated
+    inline bool floodFillIsomTerrain(Chk::IsomDiamond isomDiamond, size_t terrainType, Chk::IsomCache & cache)
+    {
+        TraceSpan traceSpan("ScMap::floodFillIsomTerrain");
+        if ( cache.recorder != nullptr )
+            cache.recorder->recordFloodFill(isomDiamond, terrainType);
+
+        uint16_t isomValue = cache.getTerrainTypeIsomValue(terrainType);
+        if ( isomValue == 0 || !isomDiamond.isValid() || !isInBounds(isomDiamond) || size_t(isomValue) >= cache.isomLinks.size() || cache.isomLinks[size_t(isomValue)].terrainType == 0 )
+            return false;
+
+        uint16_t sourceTerrainType = getDiamondTerrainType(isomDiamond, cache);
+        if ( sourceTerrainType == 0 || sourceTerrainType == cache.isomLinks[size_t(isomValue)].terrainType )
+            return false;
+
+        std::vector<Chk::IsomDiamond> filledDiamonds {};
+        std::vector<Chk::IsomDiamond> diamondsToVisit { isomDiamond };
+        Sc::BoundingBox visitedArea { isomDiamond.x, isomDiamond.y, isomDiamond.x, isomDiamond.y };
+        isomRectAt(isomDiamond).setVisited();
+        while ( !diamondsToVisit.empty() )
+        {
+            Chk::IsomDiamond visitedDiamond = diamondsToVisit.back();
+            diamondsToVisit.pop_back();
+            filledDiamonds.push_back(visitedDiamond);
+            for ( auto i : Chk::IsomDiamond::neighbors )
+            {
+                Chk::IsomDiamond neighbor = visitedDiamond.getNeighbor(i);
+                if ( isInBounds(neighbor) && !getIsomRect(neighbor).isVisited() )
+                {
+                    isomRectAt(neighbor).setVisited();
+                    visitedArea.expandToInclude(neighbor.x, neighbor.y);
+                    if ( getDiamondTerrainType(neighbor, cache) == sourceTerrainType )
+                        diamondsToVisit.push_back(neighbor);
+                }
+            }
+        }
+
+        for ( size_t y=visitedArea.top; y<=visitedArea.bottom; ++y )
+        {
+            for ( size_t x=visitedArea.left; x<=visitedArea.right; ++x )
+                isomRectAt({x, y}).clearVisited();
+        }
+
+        // Neighbors of another terrain type border the region, gather them before filling as the fill is what they need to adapt to
+        std::deque<Chk::IsomDiamond> diamondsToUpdate {};
+        for ( const auto & filledDiamond : filledDiamonds )
+        {
+            for ( auto i : Chk::IsomDiamond::neighbors )
+            {
+                Chk::IsomDiamond neighbor = filledDiamond.getNeighbor(i);
+                if ( isInBounds(neighbor) && getDiamondTerrainType(neighbor, cache) != sourceTerrainType )
+                    diamondsToUpdate.push_back(neighbor);
+            }
+        }
+
+        // The filled region acts as one brush stroke: every filled diamond is pinned and the border is resolved in a single radial update
+        cache.resetChangedArea();
+        for ( const auto & filledDiamond : filledDiamonds )
+            setDiamondIsomValues(filledDiamond, isomValue, true, cache);
+
+        radiallyUpdateTerrain(true, diamondsToUpdate, cache);
+        repairChangedArea(true, cache); // A single radial update around an irregular region can leave pockets with no valid isomValue
+        return true;
+    }
+
+    // Converts the map from the tileset of sourceCache to the tileset of destCache, terrainTypeMapping maps source terrain types (by index) to destination
+    // terrain types, anything unmapped becomes the destination's default brush; every isomValue is rewritten through one lookup table in a single pass,
+    // transitions whose pair of terrain types has no equivalent in the destination tileset are repaired, then TILE/MTXM are regenerated
+    // Nothing is converted if either cache was made for different map dimensions
+    inline bool convertTileset(const std::vector<uint16_t> & terrainTypeMapping, const Chk::IsomCache & sourceCache, Chk::IsomCache & destCache)
+    {
+        if ( isomRects.size() < getIsomWidth()*getIsomHeight() || editorTiles.size() < size_t(tileWidth)*size_t(tileHeight) ||
+            tiles.size() < size_t(tileWidth)*size_t(tileHeight) )
+        {
+            return false;
+        }
+        else if ( sourceCache.isomWidth != getIsomWidth() || sourceCache.isomHeight != getIsomHeight() ||
+            destCache.isomWidth != getIsomWidth() || destCache.isomHeight != getIsomHeight() )
+        {
+            return false;
+        }
+
+        auto mapTerrainType = [&](size_t sourceTerrainType) {
+            size_t destTerrainType = sourceTerrainType < terrainTypeMapping.size() ? terrainTypeMapping[sourceTerrainType] : 0;
+            uint16_t isomValue = destCache.getTerrainTypeIsomValue(destTerrainType);
+            if ( destTerrainType == 0 || destTerrainType > destCache.terrainTypes.size()/2 || isomValue == 0 ||
+                isomValue >= destCache.isomLinks.size() || destCache.isomLinks[isomValue].terrainType == 0 )
+            {
+                return Sc::Isom::defaultBrushIndex[size_t(destCache.tileset) % Sc::Terrain_::NumTilesets]; // Only solid brushes can be mapped to
+            }
+            return destTerrainType;
+        };
+
+        // Solid values map to solid values and transitions map shape-for-shape onto the transition between the same pair of mapped terrain types
+        uint16_t defaultIsomValue = destCache.getTerrainTypeIsomValue(mapTerrainType(0));
+        std::vector<uint16_t> isomValueMap(size_t(Chk::IsomRect::EditorFlag::ClearAll >> 4) + 1, defaultIsomValue);
+        isomValueMap[0] = 0;
+        for ( size_t isomValue=1; isomValue<sourceCache.isomLinks.size() && isomValue<isomValueMap.size(); ++isomValue )
+        {
+            size_t terrainType = sourceCache.isomLinks[isomValue].terrainType;
+            uint16_t terrainTypeIsomValue = sourceCache.getTerrainTypeIsomValue(terrainType);
+            if ( terrainType == 0 || terrainTypeIsomValue == 0 )
+                continue;
+            else if ( terrainType <= sourceCache.terrainTypes.size()/2 )
+                isomValueMap[isomValue] = destCache.getTerrainTypeIsomValue(mapTerrainType(terrainType));
+            else
+            {
+                auto [outerTerrainType, innerTerrainType] = getTransitionTerrainTypes(terrainType, sourceCache);
+                size_t destOuterTerrainType = mapTerrainType(outerTerrainType);
+                size_t destInnerTerrainType = mapTerrainType(innerTerrainType);
+                isomValueMap[isomValue] = destCache.getTerrainTypeIsomValue(destInnerTerrainType);
+                for ( size_t destTerrainType=destCache.terrainTypes.size()/2+1; destTerrainType<destCache.terrainTypes.size(); ++destTerrainType )
+                {
+                    uint16_t destTerrainTypeIsomValue = destCache.getTerrainTypeIsomValue(destTerrainType);
+                    if ( destTerrainTypeIsomValue != 0 && size_t(destTerrainTypeIsomValue) + Sc::Isom::shapes.size() <= destCache.isomLinks.size() &&
+                        getTransitionTerrainTypes(destTerrainType, destCache) == std::make_pair(destOuterTerrainType, destInnerTerrainType) )
+                    {
+                        isomValueMap[isomValue] = uint16_t(destTerrainTypeIsomValue + (isomValue - terrainTypeIsomValue));
+                        break;
+                    }
+                }
+            }
+        }
+
+        for ( auto & isomRect : isomRects ) // Editor flags are dropped, edge flags stay with the side they belong to
+        {
+            isomRect.left = uint16_t(isomValueMap[(isomRect.left & Chk::IsomRect::EditorFlag::ClearAll) >> 4] << 4) | (isomRect.left & Sc::Isom::EdgeFlags::Mask);
+            isomRect.top = uint16_t(isomValueMap[(isomRect.top & Chk::IsomRect::EditorFlag::ClearAll) >> 4] << 4) | (isomRect.top & Sc::Isom::EdgeFlags::Mask);
+            isomRect.right = uint16_t(isomValueMap[(isomRect.right & Chk::IsomRect::EditorFlag::ClearAll) >> 4] << 4) | (isomRect.right & Sc::Isom::EdgeFlags::Mask);
+            isomRect.bottom = uint16_t(isomValueMap[(isomRect.bottom & Chk::IsomRect::EditorFlag::ClearAll) >> 4] << 4) | (isomRect.bottom & Sc::Isom::EdgeFlags::Mask);
+        }
+        tileset = destCache.tileset;
+
+        Chk::IsomValidationReport report = validateIsom(destCache);
+        if ( !report.isConsistent() )
+            repairIsom(report, false, destCache);
+
+        for ( auto & isomRect : isomRects )
+            isomRect.left |= Chk::IsomRect::EditorFlag::Modified;
+
+        destCache.setAllChanged();
+        updateTilesFromIsom(destCache);
+        return true;
+    }
+
+    // Captures the block of isom rects whose top-left rect is the given diamond, along with the tiles they generated
+    inline std::optional<Chk::IsomStamp> captureIsomStamp(Chk::IsomDiamond topLeft, size_t width, size_t height) const
+    {
+        if ( !isStampPlaceable(topLeft, width, height) )
+            return std::nullopt;
+
+        Chk::IsomStamp stamp { tileset, width, height };
+        stamp.isomRects.reserve(width*height);
+        stamp.tiles.reserve(2*width*height);
+        for ( size_t y=topLeft.y; y<topLeft.y+height; ++y )
+        {
+            const Chk::IsomRect* sourceRow = &isomRects[y*getIsomWidth() + topLeft.x];
+            stamp.isomRects.insert(stamp.isomRects.end(), sourceRow, sourceRow+width);
+            const u16* sourceTiles = &editorTiles[y*tileWidth + 2*topLeft.x];
+            stamp.tiles.insert(stamp.tiles.end(), sourceTiles, sourceTiles+2*width);
+        }
+        for ( auto & isomRect : stamp.isomRects )
+            isomRect.clearEditorFlags();
+
+        return stamp;
+    }
+
+    // Copies the stamp's isom rects and tiles to the block whose top-left rect is the given diamond, then resolves the seam with the terrain around it
+    // Call updateTilesFromIsom after to regenerate the tiles on and around the seam, tiles for rects that still match the stamp are copied as-is
+    inline bool placeIsomStamp(const Chk::IsomStamp & stamp, Chk::IsomDiamond topLeft, Chk::IsomCache & cache)
+    {
+        if ( cache.recorder != nullptr )
+            cache.recorder->recordPaste(stamp, topLeft);
+
+        if ( stamp.isEmpty() || stamp.tileset != cache.tileset || stamp.isomRects.size() < stamp.width*stamp.height ||
+            stamp.tiles.size() < 2*stamp.width*stamp.height || !isStampPlaceable(topLeft, stamp.width, stamp.height) )
+        {
+            return false;
+        }
+
+        cache.resetChangedArea();
+        Sc::BoundingBox stampArea { topLeft.x, topLeft.y, topLeft.x+stamp.width-1, topLeft.y+stamp.height-1 };
+        for ( size_t y=0; y<stamp.height; ++y )
+        {
+            for ( size_t x=stampArea.left; x<=stampArea.right; ++x )
+                addIsomUndo({x, stampArea.top+y}, cache);
+
+            std::memcpy(&isomRects[(stampArea.top+y)*getIsomWidth() + stampArea.left], &stamp.isomRects[y*stamp.width], sizeof(Chk::IsomRect)*stamp.width);
+            std::memcpy(&editorTiles[(stampArea.top+y)*tileWidth + 2*stampArea.left], &stamp.tiles[2*y*stamp.width], sizeof(u16)*2*stamp.width);
+            std::memcpy(&tiles[(stampArea.top+y)*tileWidth + 2*stampArea.left], &stamp.tiles[2*y*stamp.width], sizeof(u16)*2*stamp.width);
+
+            for ( size_t x=stampArea.left; x<=stampArea.right; ++x )
+            {
+                size_t isomRectIndex = (stampArea.top+y)*cache.isomWidth + x;
+                if ( cache.undoMap[isomRectIndex] )
+                    cache.undoMap[isomRectIndex]->setNewValue(isomRects[isomRectIndex]);
+            }
+        }
+        cache.changedArea.expandToInclude(stampArea.left, stampArea.top);
+        cache.changedArea.expandToInclude(stampArea.right, stampArea.bottom);
+        Sc::BoundingBox seamBand { // The stamp plus one ring of rects, the rects the seam strokes are brushed across
+            stampArea.left > 0 ? stampArea.left-1 : 0, stampArea.top > 0 ? stampArea.top-1 : 0,
+            std::min(stampArea.right+1, getIsomWidth()-1), std::min(stampArea.bottom+1, getIsomHeight()-1)
+        };
+        std::vector<Chk::IsomRect> originalRects = copyIsomRects(seamBand); // Rects that change from here on no longer match the stamp's tiles
+
+        // The seam can't be resolved by radial updates alone, the terrain outside may be too narrow to transition to whatever the stamp's edge requires;
+        // instead the seam is brushed with the solid terrain the stamp has there while the diamonds wholly inside the stamp stay pinned to the stamp's values
+        auto isInStamp = [&](Chk::IsomRect::Point rectCoords) {
+            return rectCoords.x >= stampArea.left && rectCoords.x <= stampArea.right && rectCoords.y >= stampArea.top && rectCoords.y <= stampArea.bottom;
+        };
+        std::vector<Chk::IsomDiamond> strokeDiamonds {};
+        std::vector<uint16_t> strokeIsomValues {};
+        for ( size_t y=stampArea.top; y<=stampArea.bottom+1; ++y )
+        {
+            for ( size_t x=stampArea.left+(stampArea.left+y)%2; x<=stampArea.right+1; x+=2 )
+            {
+                Chk::IsomDiamond isomDiamond {x, y};
+                if ( isInStamp(isomDiamond.getRectangleCoords(Sc::Isom::Quadrant::TopLeft)) && isInStamp(isomDiamond) )
+                    continue;
+
+                uint16_t isomValue = 0; // Taken from whichever quadrants of the seam diamond lie in the stamp
+                for ( auto quadrant : Sc::Isom::quadrants )
+                {
+                    Chk::IsomRect::Point rectCoords = isomDiamond.getRectangleCoords(quadrant);
+                    if ( isInStamp(rectCoords) )
+                        isomValue = getIsomRect(rectCoords).getIsomValue(Sc::Isom::ProjectedQuadrant{quadrant}.firstSide) >> 4;
+                }
+                size_t terrainType = size_t(isomValue) < cache.isomLinks.size() ? size_t(cache.isomLinks[isomValue].terrainType) : 0;
+                if ( terrainType > cache.terrainTypes.size()/2 )
+                    terrainType = getTransitionTerrainTypes(terrainType, cache).second;
+
+                if ( terrainType != 0 )
+                {
+                    strokeDiamonds.push_back(isomDiamond);
+                    strokeIsomValues.push_back(cache.getTerrainTypeIsomValue(terrainType));
+                }
+            }
+        }
+        Sc::BoundingBox stampDiamonds { stampArea.left+1, stampArea.top+1, stampArea.right, stampArea.bottom }; // Diamonds with all four quadrants in the stamp
+        applyBrushStrokes(strokeDiamonds, strokeIsomValues, seamBand, originalRects, true, cache, stampDiamonds);
+        repairChangedArea(true, cache, stampDiamonds);
+        return true;
+    }
+
     inline void copyIsomFrom(const ScMap & sourceMap, int32_t xTileOffset, int32_t yTileOffset, bool undoable, Chk::IsomCache & destCache)
     {
         size_t sourceIsomWidth = sourceMap.tileWidth/2 + 1;
@@ -1773,6 +2251,7 @@ struct ScMap
     }
     inline void updateTilesFromIsom(Chk::IsomCache & cache)
     {
+        TraceSpan traceSpan("ScMap::updateTilesFromIsom");
         for ( size_t y=cache.changedArea.top; y<=cache.changedArea.bottom; ++y )
         {
             for ( size_t x=cache.changedArea.left; x<=cache.changedArea.right; ++x )
@@ -1786,6 +2265,32 @@ struct ScMap
         }
         cache.resetChangedArea();
     }
+    // Ends one edit of a batch whose tiles are regenerated together by updateTilesFromBatch; the edit's changed area is added to batchArea and editor flags
+    // are cleared so the next edit's radial updates resolve the same as if tiles had been updated after every edit
+    inline void deferTileUpdate(Sc::BoundingBox & batchArea, Chk::IsomCache & cache)
+    {
+        if ( cache.changedArea.left <= cache.changedArea.right && cache.changedArea.top <= cache.changedArea.bottom )
+        {
+            for ( size_t y=cache.changedArea.top; y<=cache.changedArea.bottom && y<getIsomHeight(); ++y )
+            {
+                for ( size_t x=cache.changedArea.left; x<=cache.changedArea.right && x<getIsomWidth(); ++x )
+                    isomRectAt({x, y}).clearEditorFlags();
+            }
+            batchArea.expandToInclude(cache.changedArea.left, cache.changedArea.top);
+            batchArea.expandToInclude(cache.changedArea.right, cache.changedArea.bottom);
+        }
+        cache.resetChangedArea();
+    }
+    // Regenerates the tiles of every rect in batchArea which differs from batchStartRects (the isomRects from before the batch's first edit)
+    inline void updateTilesFromBatch(const std::vector<Chk::IsomRect> & batchStartRects, const Sc::BoundingBox & batchArea, Chk::IsomCache & cache)
+    {
+        if ( batchArea.left > batchArea.right || batchArea.top > batchArea.bottom || batchStartRects.size() != isomRects.size() )
+            return;
+
+        cache.changedArea = batchArea;
+        flagChangedRects({0, 0, getIsomWidth()-1, getIsomHeight()-1}, batchStartRects, cache);
+        updateTilesFromIsom(cache);
+    }
     inline bool resizeIsom(int32_t xTileOffset, int32_t yTileOffset, size_t oldMapWidth, size_t oldMapHeight, bool fixBorders, Chk::IsomCache & cache)
     {
         int32_t xDiamondOffset = xTileOffset/2;
@@ -1971,6 +2476,180 @@ struct ScMap
         return true;
     }
 
+    // Checks every diamond against the isomLinks table without modifying the map
+    inline Chk::IsomValidationReport validateIsom(const Chk::IsomCache & cache) const
+    {
+        Chk::IsomValidationReport report {};
+        if ( isomRects.size() < getIsomWidth()*getIsomHeight() )
+            report.undersized = true;
+        else
+        {
+            validateIsomRows(0, getIsomHeight(), cache, report);
+            report.groupRegions();
+        }
+        return report;
+    }
+
+    // Checks every diamond against the isomLinks table, splitting the map into bands of rows which are checked on the given thread pool
+    inline Chk::IsomValidationReport validateIsom(const Chk::IsomCache & cache, ThreadPool & threadPool) const
+    {
+        Chk::IsomValidationReport report {};
+        if ( isomRects.size() < getIsomWidth()*getIsomHeight() )
+        {
+            report.undersized = true;
+            return report;
+        }
+
+        size_t isomHeight = getIsomHeight();
+        size_t rowsPerBand = std::max(size_t(16), isomHeight/(4*threadPool.size()) + 1);
+        size_t totalBands = (isomHeight + rowsPerBand - 1)/rowsPerBand;
+        std::vector<Chk::IsomValidationReport> bandReports(totalBands);
+        threadPool.parallelFor(totalBands, [&](size_t band) {
+            validateIsomRows(band*rowsPerBand, std::min(isomHeight, (band+1)*rowsPerBand), cache, bandReports[band]);
+        });
+
+        for ( const auto & bandReport : bandReports )
+            report.append(bandReport);
+
+        report.groupRegions();
+        return report;
+    }
+
+    // Repairs the inconsistent diamonds from a validation report, call updateTilesFromIsom after to regenerate the tiles
+    // Diamonds with invalid values or mismatched quadrants are re-brushed with the solid isomValue of their terrain type (or the default brush if invalid),
+    // as are diamonds with only mismatched links that don't neighbor such a diamond; the surroundings are then radially updated as after a brush stroke
+    // Diamonds with an isomValue of zero are left as-is, a zeroed ISOM section cannot be repaired from its neighbors
+    // Edits in the changed area that haven't reached updateTilesFromIsom yet stay flagged as modified and remain in the changed area
+    // Diamonds within pinnedArea (if any) are never changed, only what's around them is repaired
+    inline void repairIsom(const Chk::IsomValidationReport & report, bool undoable, Chk::IsomCache & cache, std::optional<Sc::BoundingBox> pinnedArea = std::nullopt)
+    {
+        if ( report.undersized )
+            return;
+
+        // Flags left by prior edits would pin their diamonds and stop radial updates, clear them for now and restore the modified flags once done
+        Sc::BoundingBox priorChangedArea = cache.changedArea;
+        std::vector<size_t> priorModifiedRects {};
+        for ( size_t y=priorChangedArea.top; y<=priorChangedArea.bottom && y<getIsomHeight(); ++y )
+        {
+            for ( size_t x=priorChangedArea.left; x<=priorChangedArea.right && x<getIsomWidth(); ++x )
+            {
+                Chk::IsomRect & isomRect = isomRectAt({x, y});
+                if ( isomRect.isLeftOrRightModified() )
+                    priorModifiedRects.push_back(y*getIsomWidth() + x);
+
+                isomRect.clearEditorFlags();
+            }
+        }
+
+        auto isCorrupt = [&](Chk::IsomDiamond isomDiamond) {
+            uint16_t isomValue = getCentralIsomValue(isomDiamond);
+            return isomValue >= cache.isomLinks.size() || cache.isomLinks[isomValue].terrainType == 0 || !diamondQuadrantsMatch(isomDiamond);
+        };
+        auto neighborsCorruptDiamond = [&](Chk::IsomDiamond isomDiamond) {
+            for ( auto i : Chk::IsomDiamond::neighbors )
+            {
+                Chk::IsomDiamond neighbor = isomDiamond.getNeighbor(i);
+                if ( isInBounds(neighbor) && getCentralIsomValue(neighbor) != 0 && isCorrupt(neighbor) )
+                    return true;
+            }
+            return false;
+        };
+
+        // Decide what to re-brush before changing anything, re-brushing a corrupt diamond would hide it from its neighbors
+        std::vector<Chk::IsomDiamond> diamondsToRebrush {};
+        auto isPinned = [&](Chk::IsomDiamond isomDiamond) {
+            return pinnedArea && isomDiamond.x >= pinnedArea->left && isomDiamond.x <= pinnedArea->right &&
+                isomDiamond.y >= pinnedArea->top && isomDiamond.y <= pinnedArea->bottom;
+        };
+        for ( const auto & isomDiamond : report.inconsistentDiamonds )
+        {
+            if ( isInBounds(isomDiamond) && getCentralIsomValue(isomDiamond) != 0 && !isPinned(isomDiamond) &&
+                (isCorrupt(isomDiamond) || !neighborsCorruptDiamond(isomDiamond)) )
+            {
+                diamondsToRebrush.push_back(isomDiamond);
+            }
+        }
+
+        // Replace invalid values before any brush strokes, so radial updates never read them
+        uint16_t defaultIsomValue = cache.getTerrainTypeIsomValue(Sc::Isom::defaultBrushIndex[size_t(cache.tileset) % Sc::Terrain_::NumTilesets]);
+        std::vector<uint16_t> solidIsomValues(diamondsToRebrush.size(), defaultIsomValue);
+        Sc::BoundingBox originalArea = diamondsToRebrush.empty() ? Sc::BoundingBox{} : // The re-brushed diamonds' rects plus one ring
+            Sc::BoundingBox{getIsomWidth(), getIsomHeight(), 0, 0};
+        for ( const auto & isomDiamond : diamondsToRebrush )
+        {
+            originalArea.expandToInclude(isomDiamond.x > 1 ? isomDiamond.x-2 : 0, isomDiamond.y > 1 ? isomDiamond.y-2 : 0);
+            originalArea.expandToInclude(std::min(isomDiamond.x+1, getIsomWidth()-1), std::min(isomDiamond.y+1, getIsomHeight()-1));
+        }
+        std::vector<Chk::IsomRect> originalRects = copyIsomRects(originalArea);
+        cache.resetChangedArea();
+        for ( size_t i=0; i<diamondsToRebrush.size(); ++i )
+        {
+            uint16_t isomValue = getCentralIsomValue(diamondsToRebrush[i]);
+            uint16_t terrainType = isomValue < cache.isomLinks.size() ? cache.isomLinks[isomValue].terrainType : 0;
+            uint16_t solidIsomValue = terrainType != 0 ? cache.getTerrainTypeIsomValue(terrainType) : defaultIsomValue;
+            if ( solidIsomValue < cache.isomLinks.size() && cache.isomLinks[solidIsomValue].terrainType != 0 )
+                solidIsomValues[i] = solidIsomValue;
+
+            setDiamondIsomValues(diamondsToRebrush[i], solidIsomValues[i], undoable, cache);
+            for ( auto quadrant : Sc::Isom::quadrants )
+            {
+                Chk::IsomRect::Point rectCoords = diamondsToRebrush[i].getRectangleCoords(quadrant);
+                if ( isInBounds(rectCoords) )
+                    isomRectAt(rectCoords).clearEditorFlags();
+            }
+        }
+
+        // Each re-brush is applied as its own brush stroke so later strokes can reshape the transitions left by earlier ones
+        applyBrushStrokes(diamondsToRebrush, solidIsomValues, originalArea, originalRects, undoable, cache, pinnedArea);
+
+        for ( auto isomRectIndex : priorModifiedRects )
+            isomRects[isomRectIndex].left |= Chk::IsomRect::EditorFlag::Modified;
+
+        if ( priorChangedArea.left <= priorChangedArea.right )
+        {
+            cache.changedArea.expandToInclude(priorChangedArea.left, priorChangedArea.top);
+            cache.changedArea.expandToInclude(priorChangedArea.right, priorChangedArea.bottom);
+        }
+    }
+
+    // Rebuilds the ISOM section from the tile groups in TILE (or MTXM if TILE is absent), for maps whose ISOM section is zeroed or garbage
+    // Returns the number of diamonds whose surrounding tiles did not exactly match any isomValue (validateIsom/repairIsom can clean these up)
+    // Returns std::nullopt and leaves ISOM unchanged if neither TILE nor MTXM cover the map dimensions
+    inline std::optional<size_t> reconstructIsomFromTiles(const Chk::IsomCache & cache)
+    {
+        const std::vector<u16>* sourceTiles = getReconstructionSourceTiles();
+        if ( sourceTiles == nullptr )
+            return std::nullopt;
+
+        isomRects.assign(getIsomWidth()*getIsomHeight(), Chk::IsomRect{});
+        return reconstructIsomRows(0, getIsomHeight(), *sourceTiles, cache);
+    }
+
+    // Rebuilds the ISOM section from the tile groups in TILE (or MTXM if TILE is absent), splitting the map into bands of rows solved on the given thread pool
+    inline std::optional<size_t> reconstructIsomFromTiles(const Chk::IsomCache & cache, ThreadPool & threadPool)
+    {
+        const std::vector<u16>* sourceTiles = getReconstructionSourceTiles();
+        if ( sourceTiles == nullptr )
+            return std::nullopt;
+
+        isomRects.assign(getIsomWidth()*getIsomHeight(), Chk::IsomRect{});
+
+        // Each diamond only writes the two sides of each rect its quadrants project onto, so bands never write the same memory
+        size_t isomHeight = getIsomHeight();
+        size_t rowsPerBand = std::max(size_t(16), isomHeight/(4*threadPool.size()) + 1);
+        size_t totalBands = (isomHeight + rowsPerBand - 1)/rowsPerBand;
+        std::vector<size_t> bandInexactDiamonds(totalBands, 0);
+        threadPool.parallelFor(totalBands, [&](size_t band) {
+            bandInexactDiamonds[band] = reconstructIsomRows(band*rowsPerBand, std::min(isomHeight, (band+1)*rowsPerBand), *sourceTiles, cache);
+        });
+
+        size_t totalInexactDiamonds = 0;
+        for ( auto inexactDiamonds : bandInexactDiamonds )
+            totalInexactDiamonds += inexactDiamonds;
+
+        return totalInexactDiamonds;
+    }
+
 private:
     inline uint16_t getTileValue(size_t tileX, size_t tileY) const { return editorTiles[tileY*tileWidth + tileX]; }
     inline void setTileValue(size_t tileX, size_t tileY, uint16_t tileValue)
@@ -1980,6 +2659,34 @@ private:
         tiles[tileY*tileWidth + tileX] = tileValue;
     }
     inline uint16_t getCentralIsomValue(Chk::IsomRect::Point point) const { return isomRects[point.y*getIsomWidth() + point.x].left >> 4; }
+    inline uint16_t getDiamondTerrainType(Chk::IsomDiamond isomDiamond, const Chk::IsomCache & cache) const
+    {
+        size_t isomValue = size_t(getCentralIsomValue(isomDiamond));
+        return isomValue < cache.isomLinks.size() ? cache.isomLinks[isomValue].terrainType : 0;
+    }
+    inline bool isStampPlaceable(Chk::IsomDiamond topLeft, size_t width, size_t height) const
+    {
+        return topLeft.isValid() && width > 0 && height > 0 && topLeft.x+width <= size_t(tileWidth)/2 && topLeft.y+height <= size_t(tileHeight) &&
+            isomRects.size() >= getIsomWidth()*getIsomHeight() && editorTiles.size() >= size_t(tileWidth)*size_t(tileHeight) &&
+            tiles.size() >= size_t(tileWidth)*size_t(tileHeight);
+    }
+    static inline std::pair<size_t, size_t> getTransitionTerrainTypes(size_t terrainType, const Chk::IsomCache & cache) // Gets the outer and inner solid terrain types
+    {
+        size_t isomValue = size_t(cache.getTerrainTypeIsomValue(terrainType)) + Sc::Isom::Shape::Id::EdgeNorthWest;
+        if ( terrainType <= cache.terrainTypes.size()/2 || isomValue >= cache.isomLinks.size() )
+            return {0, 0};
+
+        auto getSolidTerrainType = [&](Sc::Isom::LinkId linkId) {
+            for ( size_t solidTerrainType=1; solidTerrainType<=cache.terrainTypes.size()/2; ++solidTerrainType )
+            {
+                if ( cache.terrainTypes[solidTerrainType].isomValue != 0 && cache.terrainTypes[solidTerrainType].linkId == linkId )
+                    return solidTerrainType;
+            }
+            return size_t(0);
+        };
+        const Sc::Isom::ShapeLinks & edgeNorthWest = cache.isomLinks[isomValue];
+        return {getSolidTerrainType(edgeNorthWest.topLeft.linkId), getSolidTerrainType(edgeNorthWest.bottomRight.linkId)};
+    }
     inline bool centralIsomValueModified(Chk::IsomRect::Point point) const { return isomRects[point.y*getIsomWidth() + point.x].isLeftModified(); }
     inline const Chk::IsomRect & getIsomRect(Chk::IsomRect::Point point) const { return isomRects[point.y*getIsomWidth() + point.x]; }
     inline Chk::IsomRect & isomRectAt(Chk::IsomRect::Point point) { return isomRects[point.y*getIsomWidth() + point.x]; }
@@ -1987,7 +2694,7 @@ private:
 
     inline void addIsomUndo(Chk::IsomRect::Point point, Chk::IsomCache & cache)
     {
-        if ( !cache.undoMap[point.y*cache.isomWidth + point.x] ) // if undoMap entry doesn't already exist at this position...
+        if ( cache.recordUndos && !cache.undoMap[point.y*cache.isomWidth + point.x] ) // if undoMap entry doesn't already exist at this position...
         {
             Chk::IsomRectUndo isomRectUndo(Chk::IsomDiamond{point.x, point.y}, getIsomRect(point), Chk::IsomRect{});
             cache.undoMap[point.y*cache.isomWidth + point.x] = isomRectUndo; // add undoMap entry at position
@@ -2006,7 +2713,7 @@ private:
         {
             Chk::IsomRectUndo* isomUndo = nullptr;
             size_t isomRectIndex = isomDiamond.y*cache.isomWidth + size_t(isomDiamond.x);
-            if ( undoable && isomRectIndex < cache.undoMap.size() )
+            if ( undoable && cache.recordUndos && isomRectIndex < cache.undoMap.size() )
             {
                 addIsomUndo(isomDiamond, cache);
                 isomUndo = cache.undoMap[isomRectIndex] ? &cache.undoMap[isomRectIndex].value() : nullptr;
@@ -2029,6 +2736,131 @@ private:
         setIsomValue(isomDiamond.getRectangleCoords(Sc::Isom::Quadrant::BottomLeft), Sc::Isom::Quadrant::BottomLeft, isomValue, undoable, cache);
     }
 
+    // Brushes each diamond with the corresponding isomValue as a separate single-diamond stroke, editor flags are cleared between strokes so earlier
+    // strokes don't pin the transitions later strokes need to reshape; once done every rect in originalArea differing from originalRects (see copyIsomRects)
+    // is flagged as modified, as is every rect outside originalArea that a stroke modified
+    // Diamonds within pinnedArea (if any) stay pinned throughout, no stroke or radial update changes their isomValues
+    inline void applyBrushStrokes(const std::vector<Chk::IsomDiamond> & diamonds, const std::vector<uint16_t> & isomValues, const Sc::BoundingBox & originalArea,
+        const std::vector<Chk::IsomRect> & originalRects, bool undoable, Chk::IsomCache & cache, std::optional<Sc::BoundingBox> pinnedArea = std::nullopt)
+    {
+        auto isPinned = [&](size_t x, size_t y) {
+            return pinnedArea && (x+y)%2 == 0 && x >= pinnedArea->left && x <= pinnedArea->right && y >= pinnedArea->top && y <= pinnedArea->bottom;
+        };
+        std::vector<size_t> changedOutsideOriginals {}; // Rects outside originalArea can't be compared, the ones strokes modified are flagged once done
+        auto clearStrokeFlags = [&]() {
+            for ( size_t y=cache.changedArea.top; y<=cache.changedArea.bottom; ++y )
+            {
+                for ( size_t x=cache.changedArea.left; x<=cache.changedArea.right; ++x )
+                {
+                    Chk::IsomRect & isomRect = isomRectAt({x, y});
+                    if ( (x < originalArea.left || x > originalArea.right || y < originalArea.top || y > originalArea.bottom) &&
+                        (((isomRect.top | isomRect.right | isomRect.bottom) & Chk::IsomRect::EditorFlag::Modified) != 0 || (isomRect.isLeftModified() && !isPinned(x, y))) )
+                    {
+                        changedOutsideOriginals.push_back(y*getIsomWidth() + x);
+                    }
+                    isomRect.clearEditorFlags();
+                }
+            }
+        };
+        auto pinDiamonds = [&](const Sc::BoundingBox & area, bool pin) {
+            for ( size_t y=std::max(area.top, pinnedArea->top); y<=std::min(area.bottom, pinnedArea->bottom); ++y )
+            {
+                for ( size_t x=std::max(area.left, pinnedArea->left); x<=std::min(area.right, pinnedArea->right); ++x )
+                {
+                    Chk::IsomRect & isomRect = isomRectAt({x, y});
+                    if ( (x+y)%2 == 0 )
+                        isomRect.left = pin ? (isomRect.left | Chk::IsomRect::EditorFlag::Modified) : (isomRect.left & Chk::IsomRect::EditorFlag::xModified);
+                }
+            }
+        };
+        if ( pinnedArea )
+            pinDiamonds(*pinnedArea, true);
+
+        Sc::BoundingBox strokeArea = cache.changedArea; // Includes anything the caller set prior to the strokes
+        for ( size_t strokeIndex=0; strokeIndex<diamonds.size(); ++strokeIndex )
+        {
+            const Chk::IsomDiamond & isomDiamond = diamonds[strokeIndex];
+            cache.resetChangedArea();
+            setDiamondIsomValues(isomDiamond, isomValues[strokeIndex], undoable, cache);
+
+            std::deque<Chk::IsomDiamond> diamondsToUpdate {};
+            for ( auto i : Chk::IsomDiamond::neighbors )
+            {
+                Chk::IsomDiamond neighbor = isomDiamond.getNeighbor(i);
+                if ( diamondNeedsUpdate(neighbor) )
+                    diamondsToUpdate.push_back(Chk::IsomDiamond{neighbor.x, neighbor.y});
+            }
+            radiallyUpdateTerrain(undoable, diamondsToUpdate, cache);
+
+            clearStrokeFlags();
+            if ( pinnedArea )
+                pinDiamonds(cache.changedArea, true);
+
+            strokeArea.expandToInclude(cache.changedArea.left, cache.changedArea.top);
+            strokeArea.expandToInclude(cache.changedArea.right, cache.changedArea.bottom);
+        }
+
+        if ( pinnedArea )
+        {
+            // The strokes were brushed without knowing what the pinned diamonds needed, settle them against the pinned diamonds in one more radial update
+            std::deque<Chk::IsomDiamond> diamondsToUpdate(diamonds.begin(), diamonds.end());
+            cache.resetChangedArea();
+            radiallyUpdateTerrain(undoable, diamondsToUpdate, cache);
+            clearStrokeFlags();
+            strokeArea.expandToInclude(cache.changedArea.left, cache.changedArea.top);
+            strokeArea.expandToInclude(cache.changedArea.right, cache.changedArea.bottom);
+            pinDiamonds(*pinnedArea, false);
+        }
+
+        cache.changedArea = strokeArea;
+        flagChangedRects(originalArea, originalRects, cache);
+        for ( auto isomRectIndex : changedOutsideOriginals )
+            isomRects[isomRectIndex].left |= Chk::IsomRect::EditorFlag::Modified;
+    }
+    // Repairs anything an edit left inconsistent within the changed area, diamonds within pinnedArea (if any) are never changed
+    inline void repairChangedArea(bool undoable, Chk::IsomCache & cache, std::optional<Sc::BoundingBox> pinnedArea = std::nullopt)
+    {
+        Sc::BoundingBox changedArea = cache.changedArea;
+        if ( changedArea.left > changedArea.right || changedArea.top > changedArea.bottom )
+            return;
+
+        Chk::IsomValidationReport report {};
+        validateIsomRows(changedArea.top, std::min(changedArea.bottom+1, getIsomHeight()), cache, report);
+        report.inconsistentDiamonds.erase(std::remove_if(report.inconsistentDiamonds.begin(), report.inconsistentDiamonds.end(),
+            [&](const Chk::IsomDiamond & isomDiamond) { return isomDiamond.x < changedArea.left || isomDiamond.x > changedArea.right; }),
+            report.inconsistentDiamonds.end());
+
+        if ( !report.inconsistentDiamonds.empty() )
+            repairIsom(report, undoable, cache, pinnedArea);
+    }
+    inline std::vector<Chk::IsomRect> copyIsomRects(const Sc::BoundingBox & area) const // Copies the rects in area (which must be in bounds) row by row
+    {
+        std::vector<Chk::IsomRect> areaRects {};
+        areaRects.reserve((area.right-area.left+1)*(area.bottom-area.top+1));
+        for ( size_t y=area.top; y<=area.bottom; ++y )
+            areaRects.insert(areaRects.end(), isomRects.begin() + y*getIsomWidth() + area.left, isomRects.begin() + y*getIsomWidth() + area.right + 1);
+
+        return areaRects;
+    }
+    // Flag what changed in originalArea (with originalRects copied from it by copyIsomRects) so updateTilesFromIsom picks it up
+    inline void flagChangedRects(const Sc::BoundingBox & originalArea, const std::vector<Chk::IsomRect> & originalRects, const Chk::IsomCache & cache)
+    {
+        size_t originalWidth = originalArea.right - originalArea.left + 1;
+        for ( size_t y=std::max(cache.changedArea.top, originalArea.top); y<=std::min(cache.changedArea.bottom, originalArea.bottom) && y<getIsomHeight(); ++y )
+        {
+            for ( size_t x=std::max(cache.changedArea.left, originalArea.left); x<=std::min(cache.changedArea.right, originalArea.right) && x<getIsomWidth(); ++x )
+            {
+                Chk::IsomRect & rect = isomRectAt({x, y});
+                const Chk::IsomRect & originalRect = originalRects[(y-originalArea.top)*originalWidth + x-originalArea.left];
+                for ( auto side : Sc::Isom::sides )
+                {
+                    if ( rect.getIsomValue(side) != originalRect.getIsomValue(side) )
+                        rect.left |= Chk::IsomRect::EditorFlag::Modified;
+                }
+            }
+        }
+    }
+
     struct IsomNeighbors
     {
         struct BestMatch
@@ -2093,7 +2925,7 @@ private:
             auto neighborLinkId = neighbors[quadrant].linkId;
             auto quadrantLinkId = shapeLinks.getLinkId(quadrant);
 
-            if ( neighborLinkId == quadrantLinkId && (quadrantLinkId < Sc::Isom::LinkId::OnlyMatchSameType || terrainType == neighborTerrainType) )
+            if ( Sc::Isom::ShapeLinks::linksMatch(quadrantLinkId, terrainType, neighborLinkId, neighborTerrainType) )
                 ++totalMatches;
             else if ( neighbors[quadrant].modified ) // There was no match with a neighbor that was already modified, so this isomValue can't be valid
                 return uint16_t(0);
@@ -2105,13 +2937,16 @@ private:
         bool searchUntilHigherTerrainType = startingTerrainType == cache.terrainTypes.size()/2+1; // The final search always searches until end or higher types
         bool searchUntilEnd = startingTerrainType == 0; // If startingTerrainType is zero, the whole table after start must be searched
 
+        ISOM_STAT(++cache.stats.bestMatchSearches;)
         uint16_t isomValue = cache.getTerrainTypeIsomValue(startingTerrainType);
         for ( ; isomValue < cache.isomLinks.size(); ++isomValue )
         {
+            ISOM_STAT(++cache.stats.searchIterations;)
             auto terrainType = cache.isomLinks[isomValue].terrainType;
             if ( !searchUntilEnd && terrainType != startingTerrainType && (!searchUntilHigherTerrainType || terrainType > startingTerrainType) )
                 break; // Do not search the rest of the table
 
+            ISOM_STAT(++cache.stats.neighborMatchCounts;)
             auto matchCount = countNeighborMatches(cache.isomLinks[isomValue], neighbors, cache.isomLinks);
             if ( matchCount > neighbors.bestMatch.matchCount )
                 neighbors.bestMatch = {isomValue, matchCount};
@@ -2139,12 +2974,15 @@ private:
     }
     inline void radiallyUpdateTerrain(bool undoable, std::deque<Chk::IsomDiamond> & diamondsToUpdate, Chk::IsomCache & cache)
     {
+        ISOM_STAT(cache.stats.diamondsEnqueued += diamondsToUpdate.size();)
         while ( !diamondsToUpdate.empty() )
         {
+            ISOM_STAT(cache.stats.queueHighWater = std::max(cache.stats.queueHighWater, diamondsToUpdate.size());)
             Chk::IsomDiamond isomDiamond = diamondsToUpdate.front();
             diamondsToUpdate.pop_front();
             if ( diamondNeedsUpdate(isomDiamond) && !getIsomRect(isomDiamond).isVisited() )
             {
+                ISOM_STAT(++cache.stats.diamondsVisited;)
                 isomRectAt(isomDiamond).setVisited();
                 cache.changedArea.expandToInclude(isomDiamond.x, isomDiamond.y);
                 if ( auto bestMatch = findBestMatchIsomValue(isomDiamond, cache) )
@@ -2156,7 +2994,10 @@ private:
                     {
                         Chk::IsomDiamond neighbor = isomDiamond.getNeighbor(i);
                         if ( diamondNeedsUpdate(neighbor) )
+                        {
                             diamondsToUpdate.push_back({neighbor.x, neighbor.y});
+                            ISOM_STAT(++cache.stats.diamondsEnqueued;)
+                        }
                     }
                 }
             }
@@ -2175,6 +3016,8 @@ private:
 
         uint32_t isomRectHash = getIsomRect(isomDiamond).getHash(cache.isomLinks);
         auto foundPotentialGroups = cache.hashToTileGroup->find(isomRectHash);
+        ISOM_STAT(++cache.stats.tileGroupLookups;)
+        ISOM_STAT(if ( foundPotentialGroups == cache.hashToTileGroup->end() ) ++cache.stats.tileGroupLookupMisses;)
         if ( foundPotentialGroups != cache.hashToTileGroup->end() )
         {
             const std::vector<uint16_t> & potentialGroups = foundPotentialGroups->second;
@@ -2213,6 +3056,7 @@ private:
 
                 curr = above;
             }
+            ISOM_STAT(size_t stackWalkDepth = isomDiamond.y - stackTopY;)
 
             setTileValue(leftTileX, stackTopY, 16*Sc::Terrain::getTileGroup(getTileValue(leftTileX, stackTopY)) + destSubTile);
             setTileValue(rightTileX, stackTopY, 16*Sc::Terrain::getTileGroup(getTileValue(rightTileX, stackTopY)) + destSubTile);
@@ -2229,6 +3073,7 @@ private:
                     break;
                 }
 
+                ISOM_STAT(++stackWalkDepth;)
                 uint16_t bottomConnection = cache.tileGroups[tileGroup].stackConnections.bottom;
                 uint16_t leftTileGroup = Sc::Terrain::getTileGroup(getTileValue(leftTileX, y));
                 uint16_t rightTileGroup = Sc::Terrain::getTileGroup(getTileValue(rightTileX, y));
@@ -2237,6 +3082,8 @@ private:
                     isomRectHash = getIsomRect({isomDiamond.x, y}).getHash(cache.isomLinks);
 
                     auto foundPotentialGroups = cache.hashToTileGroup->find(isomRectHash);
+                    ISOM_STAT(++cache.stats.tileGroupLookups;)
+                    ISOM_STAT(if ( foundPotentialGroups == cache.hashToTileGroup->end() ) ++cache.stats.tileGroupLookupMisses;)
                     if ( foundPotentialGroups != cache.hashToTileGroup->end() )
                     {
                         const std::vector<uint16_t> & potentialGroups = foundPotentialGroups->second;
@@ -2255,6 +3102,8 @@ private:
                 setTileValue(leftTileX, y, 16*leftTileGroup + destSubTile);
                 setTileValue(rightTileX, y, 16*rightTileGroup + destSubTile);
             }
+            ISOM_STAT(cache.stats.stackWalkRows += stackWalkDepth;)
+            ISOM_STAT(cache.stats.maxStackWalkDepth = std::max(cache.stats.maxStackWalkDepth, stackWalkDepth);)
         }
         else
         {
@@ -2262,6 +3111,211 @@ private:
             setTileValue(rightTileX, isomDiamond.y, 0);
         }
     }
+
+    inline bool diamondQuadrantsMatch(Chk::IsomDiamond isomDiamond) const
+    {
+        uint16_t isomValue = getCentralIsomValue(isomDiamond);
+        for ( auto quadrant : Sc::Isom::quadrants )
+        {
+            Chk::IsomRect::Point rectCoords = isomDiamond.getRectangleCoords(quadrant);
+            if ( isInBounds(rectCoords) )
+            {
+                Sc::Isom::ProjectedQuadrant projectedQuadrant {quadrant};
+                const Chk::IsomRect & rect = getIsomRect(rectCoords);
+                if ( (rect.getIsomValue(projectedQuadrant.firstSide) >> 4) != isomValue ||
+                    (rect.getIsomValue(projectedQuadrant.secondSide) >> 4) != isomValue )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    inline void validateIsomRows(size_t startY, size_t endY, const Chk::IsomCache & cache, Chk::IsomValidationReport & report) const
+    {
+        size_t isomWidth = getIsomWidth();
+        for ( size_t y=startY; y<endY; ++y )
+        {
+            for ( size_t x=y%2; x<isomWidth; x+=2 ) // Only visit valid diamonds, where (x+y)%2 == 0
+            {
+                Chk::IsomDiamond isomDiamond {x, y};
+                uint16_t isomValue = getCentralIsomValue(isomDiamond);
+                uint8_t issues = Chk::IsomValidationReport::Issue::None;
+                ++report.diamondsChecked;
+
+                if ( isomValue == 0 || isomValue >= cache.isomLinks.size() || cache.isomLinks[isomValue].terrainType == 0 )
+                    issues |= Chk::IsomValidationReport::Issue::InvalidValue;
+                else
+                {
+                    if ( !diamondQuadrantsMatch(isomDiamond) )
+                        issues |= Chk::IsomValidationReport::Issue::QuadrantMismatch;
+
+                    const Sc::Isom::ShapeLinks & shapeLinks = cache.isomLinks[isomValue];
+                    for ( auto i : Chk::IsomDiamond::neighbors )
+                    {
+                        Chk::IsomDiamond neighbor = isomDiamond.getNeighbor(i);
+                        if ( isInBounds(neighbor) )
+                        {
+                            uint16_t neighborIsomValue = getCentralIsomValue(neighbor);
+                            if ( neighborIsomValue != 0 && neighborIsomValue < cache.isomLinks.size() ) // Invalid neighbors are reported on their own
+                            {
+                                const Sc::Isom::ShapeLinks & neighborLinks = cache.isomLinks[neighborIsomValue];
+                                if ( !Sc::Isom::ShapeLinks::linksMatch(shapeLinks.getLinkId(Sc::Isom::Quadrant(i)), shapeLinks.terrainType,
+                                    neighborLinks.getLinkId(Sc::Isom::OppositeQuadrant(i)), neighborLinks.terrainType) )
+                                {
+                                    issues |= Chk::IsomValidationReport::Issue::LinkMismatch;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                if ( issues != Chk::IsomValidationReport::Issue::None )
+                    report.addIssue(isomDiamond, issues);
+            }
+        }
+    }
+
+    inline const std::vector<u16>* getReconstructionSourceTiles() const
+    {
+        size_t totalTiles = size_t(tileWidth)*size_t(tileHeight);
+        if ( editorTiles.size() >= totalTiles )
+            return &editorTiles;
+        else if ( tiles.size() >= totalTiles )
+            return &tiles;
+        else
+            return nullptr;
+    }
+    static constexpr Sc::Isom::Link getTileGroupLink(const Sc::Isom::DirectionalLinks & links, Sc::Isom::Side side)
+    {
+        switch ( side ) {
+            case Sc::Isom::Side::Left: return links.left;
+            case Sc::Isom::Side::Top: return links.top;
+            case Sc::Isom::Side::Right: return links.right;
+            default: /*Sc::Isom::Side::Bottom*/ return links.bottom;
+        }
+    }
+    struct TileQuadrant // The links a tile group imposes on the quadrant of a diamond projected onto the tile groups rectangle
+    {
+        bool known = false;
+        bool hardLinked = false;
+        Sc::Isom::Link firstSideLink = Sc::Isom::Link::None;
+        Sc::Isom::Link secondSideLink = Sc::Isom::Link::None;
+        uint16_t terrainType = 0;
+
+        constexpr uint16_t countLinkMatches(const Sc::Isom::ShapeLinks & shapeLinks, Sc::Isom::Quadrant quadrant) const
+        {
+            switch ( quadrant )
+            {
+                case Sc::Isom::Quadrant::TopLeft: return uint16_t(shapeLinks.topLeft.right == firstSideLink) + uint16_t(shapeLinks.topLeft.bottom == secondSideLink);
+                case Sc::Isom::Quadrant::TopRight: return uint16_t(shapeLinks.topRight.left == firstSideLink) + uint16_t(shapeLinks.topRight.bottom == secondSideLink);
+                case Sc::Isom::Quadrant::BottomRight: return uint16_t(shapeLinks.bottomRight.left == firstSideLink) + uint16_t(shapeLinks.bottomRight.top == secondSideLink);
+                default: /*Sc::Isom::Quadrant::BottomLeft*/ return uint16_t(shapeLinks.bottomLeft.top == firstSideLink) + uint16_t(shapeLinks.bottomLeft.right == secondSideLink);
+            }
+        }
+    };
+    inline void loadTileQuadrants(Chk::IsomDiamond isomDiamond, TileQuadrant (&tileQuadrants)[4], const std::vector<u16> & sourceTiles, const Chk::IsomCache & cache) const
+    {
+        size_t totalTileGroups = std::min(size_t(1024), cache.tileGroups.size()); // Doodad tile groups never come from ISOM
+        for ( auto quadrant : Sc::Isom::quadrants )
+        {
+            Chk::IsomRect::Point rectCoords = isomDiamond.getRectangleCoords(quadrant);
+            if ( rectCoords.x < size_t(tileWidth)/2 && rectCoords.y < size_t(tileHeight) ) // Rects in the final isom row and column have no tiles
+            {
+                auto tileGroup = Sc::Terrain::getTileGroup(sourceTiles[rectCoords.y*size_t(tileWidth) + 2*rectCoords.x]);
+                if ( tileGroup < totalTileGroups )
+                {
+                    Sc::Isom::ProjectedQuadrant projectedQuadrant {quadrant};
+                    const auto & links = cache.tileGroups[tileGroup].links;
+                    TileQuadrant & tileQuadrant = tileQuadrants[size_t(quadrant)];
+                    tileQuadrant.known = true;
+                    tileQuadrant.firstSideLink = getTileGroupLink(links, projectedQuadrant.firstSide);
+                    tileQuadrant.secondSideLink = getTileGroupLink(links, projectedQuadrant.secondSide);
+                    tileQuadrant.hardLinked = tileQuadrant.firstSideLink > Sc::Isom::Link::HardLinks || tileQuadrant.secondSideLink > Sc::Isom::Link::HardLinks;
+                    tileQuadrant.terrainType = cache.tileGroups[tileGroup].terrainType;
+                }
+            }
+        }
+    }
+    inline size_t reconstructIsomRows(size_t startY, size_t endY, const std::vector<u16> & sourceTiles, const Chk::IsomCache & cache)
+    {
+        size_t inexactDiamonds = 0;
+        size_t isomWidth = getIsomWidth();
+        for ( size_t y=startY; y<endY; ++y )
+        {
+            for ( size_t x=y%2; x<isomWidth; x+=2 ) // Only visit valid diamonds, where (x+y)%2 == 0
+            {
+                Chk::IsomDiamond isomDiamond {x, y};
+                TileQuadrant tileQuadrants[4] {};
+                loadTileQuadrants(isomDiamond, tileQuadrants, sourceTiles, cache);
+
+                uint16_t maxLinkMatches = 0;
+                uint16_t bestIsomValue = 0;
+                uint16_t bestScore = 0;
+                auto scoreIsomValue = [&](uint16_t isomValue) {
+                    const auto & shapeLinks = cache.isomLinks[isomValue];
+                    uint16_t linkMatches = 0;
+                    uint16_t terrainTypeMatches = 0;
+                    for ( auto quadrant : Sc::Isom::quadrants )
+                    {
+                        const TileQuadrant & tileQuadrant = tileQuadrants[size_t(quadrant)];
+                        if ( tileQuadrant.known )
+                        {
+                            linkMatches += tileQuadrant.countLinkMatches(shapeLinks, quadrant);
+                            if ( tileQuadrant.hardLinked && tileQuadrant.terrainType == shapeLinks.terrainType )
+                                ++terrainTypeMatches;
+                        }
+                    }
+                    uint16_t score = 8*linkMatches + terrainTypeMatches; // Links take priority, terrain types of hard-linked tile groups break ties
+                    if ( score > bestScore || (score == bestScore && isomValue < bestIsomValue) )
+                    {
+                        bestScore = score;
+                        bestIsomValue = isomValue;
+                    }
+                };
+
+                for ( auto quadrant : Sc::Isom::quadrants ) // Only isomValues sharing at least one quadrant with the tiles are candidates
+                {
+                    const TileQuadrant & tileQuadrant = tileQuadrants[size_t(quadrant)];
+                    if ( tileQuadrant.known )
+                    {
+                        maxLinkMatches += 2;
+                        auto candidates = cache.quadrantHashToIsomValues->find(
+                            Sc::Isom::ShapeLinks::getQuadrantHash(quadrant, tileQuadrant.firstSideLink, tileQuadrant.secondSideLink));
+                        if ( candidates != cache.quadrantHashToIsomValues->end() )
+                        {
+                            for ( auto isomValue : candidates->second )
+                                scoreIsomValue(isomValue);
+                        }
+                    }
+                }
+
+                if ( bestIsomValue == 0 ) // No quadrant matched exactly, fall back to the closest match in the whole table
+                {
+                    for ( uint16_t isomValue=1; isomValue<cache.isomLinks.size(); ++isomValue )
+                    {
+                        if ( cache.isomLinks[isomValue].terrainType != 0 )
+                            scoreIsomValue(isomValue);
+                    }
+                }
+
+                if ( bestScore/8 != maxLinkMatches || bestIsomValue == 0 )
+                    ++inexactDiamonds;
+
+                if ( bestIsomValue != 0 )
+                {
+                    for ( auto quadrant : Sc::Isom::quadrants )
+                    {
+                        Chk::IsomRect::Point rectCoords = isomDiamond.getRectangleCoords(quadrant);
+                        if ( isInBounds(rectCoords) )
+                            isomRectAt(rectCoords).set(quadrant, bestIsomValue);
+                    }
+                }
+            }
+        }
+        return inexactDiamonds;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+#ifndef ISOMDIFF_H
+#define ISOMDIFF_H
+#include "IsomApi.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ISOM_DIFF_SSE2
+#endif
+
+// Compares the ISOM, TILE & MTXM sections of two maps, reporting how many values differ & coalesced rectangles around the differences
+// Rows are compared eight values at a time with SSE2 where available so matching stretches of large maps are skipped quickly
+
+struct MapDiff
+{
+    struct Section
+    {
+        size_t mismatches = 0; // Differing isomRect sides for ISOM, differing tiles for TILE & MTXM
+        std::vector<Sc::BoundingBox> regions {}; // Inclusive bounds around groups of differing cells (isom coordinates for ISOM, tile coordinates otherwise)
+
+        inline bool identical() const { return mismatches == 0; }
+    };
+
+    bool sizeMismatch = false; // The maps or their sections differ in size, nothing else was compared
+    Section isom {};
+    Section editorTiles {};
+    Section tiles {};
+
+    inline bool identical() const { return !sizeMismatch && isom.identical() && editorTiles.identical() && tiles.identical(); }
+};
+
+// Builds coalesced regions from runs of differing cells which are added in row-major order
+class DiffRegions
+{
+    std::vector<Sc::BoundingBox> closed {};
+    std::vector<Sc::BoundingBox> open {}; // Regions which reached the previous or current row and may still grow
+
+    static constexpr bool touches(const Sc::BoundingBox & region, size_t left, size_t right, size_t y)
+    {
+        return region.bottom+1 >= y && region.left <= right+1 && left <= region.right+1;
+    }
+
+public:
+    inline void startRow(size_t y)
+    {
+        for ( size_t i=0; i<open.size(); )
+        {
+            if ( open[i].bottom+1 < y )
+            {
+                closed.push_back(open[i]);
+                open[i] = open.back();
+                open.pop_back();
+            }
+            else
+                ++i;
+        }
+    }
+
+    inline void addRun(size_t left, size_t right, size_t y)
+    {
+        Sc::BoundingBox* merged = nullptr;
+        for ( size_t i=0; i<open.size(); )
+        {
+            if ( !touches(open[i], left, right, y) )
+                ++i;
+            else if ( merged == nullptr )
+            {
+                merged = &open[i];
+                merged->expandToInclude(left, y);
+                merged->expandToInclude(right, y);
+                ++i;
+            }
+            else // The run bridges two regions, fold this one into the first
+            {
+                merged->expandToInclude(open[i].left, open[i].top);
+                merged->expandToInclude(open[i].right, open[i].bottom);
+                open[i] = open.back(); // merged came before i so it isn't moved
+                open.pop_back();
+            }
+        }
+        if ( merged == nullptr )
+            open.push_back(Sc::BoundingBox{left, y, right, y});
+    }
+
+    inline std::vector<Sc::BoundingBox> finish()
+    {
+        closed.insert(closed.end(), open.begin(), open.end());
+        open.clear();
+        std::sort(closed.begin(), closed.end(), [](const Sc::BoundingBox & l, const Sc::BoundingBox & r) {
+            return l.top < r.top || (l.top == r.top && l.left < r.left);
+        });
+        return std::move(closed);
+    }
+};
+
+// Calls onMismatch(index) in ascending order for every index where (values[index] & mask) != (comparison[index] & mask)
+template <typename OnMismatch>
+inline void forEachMismatch(const uint16_t* values, const uint16_t* comparison, size_t count, uint16_t mask, OnMismatch && onMismatch)
+{
+    size_t i = 0;
+#ifdef ISOM_DIFF_SSE2
+    const __m128i maskVector = _mm_set1_epi16(int16_t(mask));
+    for ( ; i+8 <= count; i+=8 )
+    {
+        __m128i lhs = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&values[i])), maskVector);
+        __m128i rhs = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&comparison[i])), maskVector);
+        int equalBits = _mm_movemask_epi8(_mm_cmpeq_epi16(lhs, rhs)); // Two bits per value
+        if ( equalBits != 0xFFFF )
+        {
+            for ( size_t lane=0; lane<8; ++lane )
+            {
+                if ( (equalBits & (1 << (2*lane))) == 0 )
+                    onMismatch(i+lane);
+            }
+        }
+    }
+#endif
+    for ( ; i<count; ++i )
+    {
+        if ( (values[i] & mask) != (comparison[i] & mask) )
+            onMismatch(i);
+    }
+}
+
+// Compares two equally sized sections laid out in rows of rowWidth cells, each cell holding valuesPerCell uint16_t values
+inline MapDiff::Section diffSection(const uint16_t* values, const uint16_t* comparison, size_t totalValues, size_t rowWidth, size_t valuesPerCell, uint16_t mask)
+{
+    MapDiff::Section section {};
+    if ( rowWidth == 0 )
+        return section;
+
+    DiffRegions regions {};
+    size_t rowValues = rowWidth*valuesPerCell;
+    for ( size_t y=0; y*rowValues < totalValues; ++y )
+    {
+        size_t rowStart = y*rowValues;
+        bool hasRun = false;
+        size_t runLeft = 0;
+        size_t runRight = 0;
+        regions.startRow(y);
+        forEachMismatch(&values[rowStart], &comparison[rowStart], std::min(rowValues, totalValues-rowStart), mask, [&](size_t index) {
+            ++section.mismatches;
+            size_t x = index/valuesPerCell;
+            if ( hasRun && x <= runRight+1 )
+                runRight = x;
+            else
+            {
+                if ( hasRun )
+                    regions.addRun(runLeft, runRight, y);
+
+                hasRun = true;
+                runLeft = x;
+                runRight = x;
+            }
+        });
+        if ( hasRun )
+            regions.addRun(runLeft, runRight, y);
+    }
+    section.regions = regions.finish();
+    return section;
+}
+
+// ISOM is always compared exactly, ignoreSubtiles compares tiles by tile group (Sc::Terrain::getTileGroup) so differing random subtile picks aren't reported
+inline MapDiff diffMaps(const ScMap & map, const ScMap & comparison, bool ignoreSubtiles = false)
+{
+    MapDiff diff {};
+    if ( map.tileWidth != comparison.tileWidth || map.tileHeight != comparison.tileHeight ||
+        map.isomRects.size() != comparison.isomRects.size() ||
+        map.editorTiles.size() != comparison.editorTiles.size() ||
+        map.tiles.size() != comparison.tiles.size() )
+    {
+        diff.sizeMismatch = true;
+        return diff;
+    }
+
+    static_assert(sizeof(Chk::IsomRect) == 4*sizeof(uint16_t), "IsomRect must be four packed uint16_t sides");
+    uint16_t tileMask = ignoreSubtiles ? uint16_t(0xFFF0) : uint16_t(0xFFFF); // getTileGroup is tileValue/16
+    diff.isom = diffSection(reinterpret_cast<const uint16_t*>(map.isomRects.data()), reinterpret_cast<const uint16_t*>(comparison.isomRects.data()),
+        4*map.isomRects.size(), map.getIsomWidth(), 4, 0xFFFF);
+    diff.editorTiles = diffSection(map.editorTiles.data(), comparison.editorTiles.data(), map.editorTiles.size(), map.tileWidth, 1, tileMask);
+    diff.tiles = diffSection(map.tiles.data(), comparison.tiles.data(), map.tiles.size(), map.tileWidth, 1, tileMask);
+    return diff;
+}
+
+#endif
\ No newline at end of file
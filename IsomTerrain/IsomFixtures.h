@@ -0,0 +1,278 @@
+#ifndef ISOMFIXTURES_H
+#define ISOMFIXTURES_H
+#include "IsomApi.h"
+#include <unordered_map>
+
+// The isomLink tables generated from each tileset's CV5 (as extracted from StarCraft), and synthetic tilesets built from them for running without game data
+
+namespace TestData
+{
+    inline constexpr uint16_t badlandsIsomLinks[] {
+        0,0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,1,1,1,1,3,4,4,2,4,4,2,4,4,2,4,4,2,5,5,5,3,5,5,3,5,5,3,5,5,3,6,2,2,5,2,2,5,2,2,5,2,2,5,14,10,10,9,10,10,
+        9,10,10,9,10,10,9,15,11,11,10,11,11,10,11,11,10,11,11,10,7,3,3,6,3,3,6,3,3,6,3,3,6,18,14,14,7,14,14,7,14,14,7,14,14,7,4,15,15,4,15,15,4,15,15,4,15,
+        15,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,34,1,1,1,1,51,255,51,51,2,1,51,255,34,1,49,257,1,1,1,49,1,257,
+        49,49,2,34,52,52,2,52,30,256,30,30,1,52,30,256,34,50,31,258,50,50,2,31,50,258,31,31,1,34,1,1,1,1,1,1,49,1,257,1,51,255,34,1,54,257,1,1,1,1,1,1,54,
+        33,256,34,50,31,258,52,30,256,30,30,1,31,31,1,34,1,1,1,1,53,255,32,53,258,1,1,1,34,50,31,258,56,56,2,56,56,2,31,51,255,34,55,55,2,52,30,256,49,30,
+        257,55,55,2,34,1,49,257,1,51,255,51,51,2,49,49,2,34,52,52,2,50,50,2,31,50,258,52,30,256,34,50,31,258,52,30,256,49,30,257,31,51,255,34,1,54,257,1,
+        53,255,32,53,258,54,33,256,35,5,5,3,5,51,255,51,51,1,5,51,255,35,5,49,257,5,5,3,49,5,257,49,49,1,35,52,52,1,52,34,256,34,34,3,52,34,256,35,50,35,
+        258,50,50,1,35,50,258,35,35,3,35,5,5,3,5,5,3,49,5,257,5,51,255,35,5,54,257,5,5,3,5,5,3,54,37,256,35,50,35,258,52,34,256,34,34,3,35,35,3,35,5,5,3,5,
+        53,255,36,53,258,5,5,3,35,50,35,258,56,56,1,56,56,1,35,51,255,35,55,55,1,52,34,256,49,34,257,55,55,1,35,5,49,257,5,51,255,51,51,1,49,49,1,35,52,52,
+        1,50,50,1,35,50,258,52,34,256,35,50,35,258,52,34,256,49,34,257,35,51,255,35,5,54,257,5,53,255,36,53,258,54,37,256,20,1,1,1,1,51,255,51,51,5,1,51,
+        255,20,1,49,257,1,1,1,49,1,257,49,49,5,20,52,52,5,52,1,256,1,1,1,52,1,256,20,50,1,258,50,50,5,1,50,258,1,1,1,20,1,1,1,1,1,1,49,1,257,1,51,255,20,1,
+        54,257,1,1,1,1,1,1,54,1,256,20,50,1,258,52,1,256,1,1,1,1,1,1,20,1,1,1,1,53,255,1,53,258,1,1,1,20,50,1,258,56,56,5,56,56,5,1,51,255,20,55,55,5,52,1,
+        256,49,1,257,55,55,5,20,1,49,257,1,51,255,51,51,5,49,49,5,20,52,52,5,50,50,5,1,50,258,52,1,256,20,50,1,258,52,1,256,49,1,257,1,51,255,20,1,54,257,
+        1,53,255,1,53,258,54,1,256,28,1,1,1,1,51,255,51,51,10,1,51,255,28,1,49,257,1,1,1,49,1,257,49,49,10,28,52,52,10,52,1,256,1,1,1,52,1,256,28,50,1,258,
+        50,50,10,1,50,258,1,1,1,28,1,1,1,1,1,1,49,1,257,1,51,255,28,1,54,257,1,1,1,1,1,1,54,1,256,28,50,1,258,52,1,256,1,1,1,1,1,1,28,1,1,1,1,53,255,1,53,
+        258,1,1,1,28,50,1,258,11,11,10,11,11,10,1,51,255,28,11,11,10,52,1,256,49,1,257,11,11,10,28,1,49,257,1,51,255,51,51,10,49,49,10,28,52,52,10,50,50,
+        10,1,50,258,52,1,256,28,50,1,258,52,1,256,49,1,257,1,51,255,28,1,54,257,1,53,255,1,53,258,54,1,256,21,4,4,2,4,51,255,51,51,6,4,51,255,21,4,49,257,
+        4,4,2,49,4,257,49,49,6,21,52,52,6,52,4,256,4,4,2,52,4,256,21,50,4,258,50,50,6,4,50,258,4,4,2,21,4,4,2,4,4,2,49,4,257,4,51,255,21,4,54,257,4,4,2,4,
+        4,2,54,4,256,21,50,4,258,52,4,256,4,4,2,4,4,2,21,4,4,2,4,53,255,4,53,258,4,4,2,21,50,4,258,56,56,6,56,56,6,4,51,255,21,55,55,6,52,4,256,49,4,257,
+        55,55,6,21,4,49,257,4,51,255,51,51,6,49,49,6,21,52,52,6,50,50,6,4,50,258,52,4,256,21,50,4,258,52,4,256,49,4,257,4,51,255,21,4,54,257,4,53,255,4,53,
+        258,54,4,256,27,1,1,1,1,51,255,51,51,9,1,51,255,27,1,49,257,1,1,1,49,1,257,49,49,9,27,52,52,9,52,1,256,1,1,1,52,1,256,27,50,1,258,50,50,9,1,50,258,
+        1,1,1,27,1,1,1,1,1,1,49,1,257,1,51,255,27,1,54,257,1,1,1,1,1,1,54,1,256,27,50,1,258,52,1,256,1,1,1,1,1,1,27,1,1,1,1,53,255,1,53,258,1,1,1,27,50,1,
+        258,56,56,9,56,56,9,1,51,255,27,55,55,9,52,1,256,49,1,257,55,55,9,27,1,49,257,1,51,255,51,51,9,49,49,9,27,52,52,9,50,50,9,1,50,258,52,1,256,27,50,
+        1,258,52,1,256,49,1,257,1,51,255,27,1,54,257,1,53,255,1,53,258,54,1,256,31,10,10,9,10,51,255,51,51,7,10,51,255,31,10,49,257,10,10,9,49,10,257,49,
+        49,7,31,52,52,7,52,26,256,26,26,9,52,26,256,31,50,27,258,50,50,7,27,50,258,27,27,9,31,10,10,9,10,10,9,49,10,257,10,51,255,31,10,54,257,10,10,9,10,
+        10,9,54,29,256,31,50,27,258,52,26,256,26,26,9,27,27,9,31,10,10,9,10,53,255,28,53,258,10,10,9,31,50,27,258,56,56,7,56,56,7,27,51,255,31,55,55,7,52,
+        26,256,49,26,257,55,55,7,31,10,49,257,10,51,255,51,51,7,49,49,7,31,52,52,7,50,50,7,27,50,258,52,26,256,31,50,27,258,52,26,256,49,26,257,27,51,255,
+        31,10,54,257,10,53,255,28,53,258,54,29,256,22,1,1,1,1,51,255,51,51,4,1,51,255,22,1,49,257,1,1,1,49,1,257,49,49,4,22,52,52,4,52,1,256,1,1,1,52,1,
+        256,22,50,1,258,50,50,4,1,50,258,1,1,1,22,1,1,1,1,1,1,49,1,257,1,51,255,22,1,54,257,1,1,1,1,1,1,54,1,256,22,50,1,258,52,1,256,1,1,1,1,1,1,22,1,1,1,
+        1,53,255,1,53,258,1,1,1,22,50,1,258,56,56,4,56,56,4,1,51,255,22,55,55,4,52,1,256,49,1,257,55,55,4,22,1,49,257,1,51,255,51,51,4,49,49,4,22,52,52,4,
+        50,50,4,1,50,258,52,1,256,22,50,1,258,52,1,256,49,1,257,1,51,255,22,1,54,257,1,53,255,1,53,258,54,1,256
+    };
+
+    inline constexpr uint16_t spaceIsomLinks[] {
+        0,0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,1,1,1,1,3,2,2,3,2,2,3,2,2,3,2,2,3,0,0,0,0,0,0,0,0,0,0,0,0,0,5,4,4,5,4,4,5,4,4,5,4,4,5,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,6,6,7,6,6,7,6,6,7,6,6,7,8,13,13,8,13,13,8,13,13,8,13,13,8,9,18,18,9,18,18,9,18,18,
+        9,18,18,9,4,3,3,4,3,3,4,3,3,4,3,3,4,6,5,5,6,5,5,6,5,5,6,5,5,6,10,8,8,10,8,8,10,8,8,10,8,8,10,11,7,7,2,7,7,2,7,7,2,7,7,2,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,1,1,1,1,51,255,51,51,3,1,51,255,20,1,49,257,1,1,1,49,1,257,49,49,3,20,52,52,3,52,
+        23,256,23,23,1,52,23,256,20,50,24,258,50,50,3,24,50,258,24,24,1,20,1,1,1,1,1,1,49,1,257,1,51,255,20,1,54,257,1,1,1,1,1,1,54,26,256,20,50,24,258,52,
+        23,256,23,23,1,24,24,1,20,1,1,1,1,53,255,25,53,258,1,1,1,20,50,24,258,56,56,3,56,56,3,24,51,255,20,55,55,3,52,23,256,49,23,257,55,55,3,20,1,49,257,
+        1,51,255,51,51,3,49,49,3,20,52,52,3,50,50,3,24,50,258,52,23,256,20,50,24,258,52,23,256,49,23,257,24,51,255,20,1,54,257,1,53,255,25,53,258,54,26,
+        256,21,2,2,3,2,51,255,51,51,5,2,51,255,21,2,49,257,2,2,3,49,2,257,49,49,5,21,52,52,5,52,27,256,27,27,3,52,27,256,21,50,28,258,50,50,5,28,50,258,28,
+        28,3,21,2,2,3,2,2,3,49,2,257,2,51,255,21,2,54,257,2,2,3,2,2,3,54,30,256,21,50,28,258,52,27,256,27,27,3,28,28,3,21,2,2,3,2,53,255,29,53,258,2,2,3,
+        21,50,28,258,56,56,5,56,56,5,28,51,255,21,55,55,5,52,27,256,49,27,257,55,55,5,21,2,49,257,2,51,255,51,51,5,49,49,5,21,52,52,5,50,50,5,28,50,258,52,
+        27,256,21,50,28,258,52,27,256,49,27,257,28,51,255,21,2,54,257,2,53,255,29,53,258,54,30,256,16,2,2,3,2,51,255,51,51,7,2,51,255,16,2,49,257,2,2,3,49,
+        2,257,49,49,7,16,52,52,7,52,2,256,2,2,3,52,2,256,16,50,2,258,50,50,7,2,50,258,2,2,3,16,2,2,3,2,2,3,49,2,257,2,51,255,16,2,54,257,2,2,3,2,2,3,54,2,
+        256,16,50,2,258,52,2,256,2,2,3,2,2,3,16,2,2,3,2,53,255,2,53,258,2,2,3,16,50,2,258,56,56,7,56,56,7,2,51,255,16,55,55,7,52,2,256,49,2,257,55,55,7,16,
+        2,49,257,2,51,255,51,51,7,49,49,7,16,52,52,7,50,50,7,2,50,258,52,2,256,16,50,2,258,52,2,256,49,2,257,2,51,255,16,2,54,257,2,53,255,2,53,258,54,2,
+        256,17,13,13,8,13,51,255,51,51,3,13,51,255,17,13,49,257,13,13,8,49,13,257,49,49,3,17,52,52,3,52,14,256,14,14,8,52,14,256,17,50,15,258,50,50,3,15,
+        50,258,15,15,8,17,13,13,8,13,13,8,49,13,257,13,51,255,17,13,54,257,13,13,8,13,13,8,54,17,256,17,50,15,258,52,14,256,14,14,8,15,15,8,17,13,13,8,13,
+        53,255,16,53,258,13,13,8,17,50,15,258,56,56,3,56,56,3,15,51,255,17,55,55,3,52,14,256,49,14,257,55,55,3,17,13,49,257,13,51,255,51,51,3,49,49,3,17,
+        52,52,3,50,50,3,15,50,258,52,14,256,17,50,15,258,52,14,256,49,14,257,15,51,255,17,13,54,257,13,53,255,16,53,258,54,17,256,18,18,18,9,18,51,255,51,
+        51,3,18,51,255,18,18,49,257,18,18,9,49,18,257,49,49,3,18,52,52,3,52,19,256,19,19,9,52,19,256,18,50,20,258,50,50,3,20,50,258,20,20,9,18,18,18,9,18,
+        18,9,49,18,257,18,51,255,18,18,54,257,18,18,9,18,18,9,54,22,256,18,50,20,258,52,19,256,19,19,9,20,20,9,18,18,18,9,18,53,255,21,53,258,18,18,9,18,
+        50,20,258,56,56,3,56,56,3,20,51,255,18,55,55,3,52,19,256,49,19,257,55,55,3,18,18,49,257,18,51,255,51,51,3,49,49,3,18,52,52,3,50,50,3,20,50,258,52,
+        19,256,18,50,20,258,52,19,256,49,19,257,20,51,255,18,18,54,257,18,53,255,21,53,258,54,22,256,14,2,2,3,2,51,255,51,51,4,2,51,255,14,2,49,257,2,2,3,
+        49,2,257,49,49,4,14,52,52,4,52,2,256,2,2,3,52,2,256,14,50,2,258,50,50,4,2,50,258,2,2,3,14,2,2,3,2,2,3,49,2,257,2,51,255,14,2,54,257,2,2,3,2,2,3,54,
+        2,256,14,50,2,258,52,2,256,2,2,3,2,2,3,14,2,2,3,2,53,255,2,53,258,2,2,3,14,50,2,258,56,56,4,56,56,4,2,51,255,14,55,55,4,52,2,256,49,2,257,55,55,4,
+        14,2,49,257,2,51,255,51,51,4,49,49,4,14,52,52,4,50,50,4,2,50,258,52,2,256,14,50,2,258,52,2,256,49,2,257,2,51,255,14,2,54,257,2,53,255,2,53,258,54,
+        2,256,15,4,4,5,4,51,255,51,51,6,4,51,255,15,4,49,257,4,4,5,49,4,257,49,49,6,15,52,52,6,52,4,256,4,4,5,52,4,256,15,50,4,258,50,50,6,4,50,258,4,4,5,
+        15,4,4,5,4,4,5,49,4,257,4,51,255,15,4,54,257,4,4,5,4,4,5,54,4,256,15,50,4,258,52,4,256,4,4,5,4,4,5,15,4,4,5,4,53,255,4,53,258,4,4,5,15,50,4,258,56,
+        56,6,56,56,6,4,51,255,15,55,55,6,52,4,256,49,4,257,55,55,6,15,4,49,257,4,51,255,51,51,6,49,49,6,15,52,52,6,50,50,6,4,50,258,52,4,256,15,50,4,258,
+        52,4,256,49,4,257,4,51,255,15,4,54,257,4,53,255,4,53,258,54,4,256,19,2,2,3,2,51,255,51,51,10,2,51,255,19,2,49,257,2,2,3,49,2,257,49,49,10,19,52,52,
+        10,52,9,256,9,9,3,52,9,256,19,50,10,258,50,50,10,10,50,258,10,10,3,19,2,2,3,2,2,3,49,2,257,2,51,255,19,2,54,257,2,2,3,2,2,3,54,12,256,19,50,10,258,
+        52,9,256,9,9,3,10,10,3,19,2,2,3,2,53,255,11,53,258,2,2,3,19,50,10,258,56,56,10,56,56,10,10,51,255,19,55,55,10,52,9,256,49,9,257,55,55,10,19,2,49,
+        257,2,51,255,51,51,10,49,49,10,19,52,52,10,50,50,10,10,50,258,52,9,256,19,50,10,258,52,9,256,49,9,257,10,51,255,19,2,54,257,2,53,255,11,53,258,54,
+        12,256,13,2,2,3,2,51,255,51,51,2,2,51,255,13,2,49,257,2,2,3,49,2,257,49,49,2,13,52,52,2,52,2,256,2,2,3,52,2,256,13,50,2,258,50,50,2,2,50,258,2,2,3,
+        13,2,2,3,2,2,3,49,2,257,2,51,255,13,2,54,257,2,2,3,2,2,3,54,2,256,13,50,2,258,52,2,256,2,2,3,2,2,3,13,2,2,3,2,53,255,2,53,258,2,2,3,13,50,2,258,56,
+        56,2,56,56,2,2,51,255,13,55,55,2,52,2,256,49,2,257,55,55,2,13,2,49,257,2,51,255,51,51,2,49,49,2,13,52,52,2,50,50,2,2,50,258,52,2,256,13,50,2,258,
+        52,2,256,49,2,257,2,51,255,13,2,54,257,2,53,255,2,53,258,54,2,256
+    };
+
+    inline constexpr uint16_t installationIsomLinks[] {
+        0,0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,1,1,1,1,3,2,2,2,2,2,2,2,2,2,2,2,2,6,3,3,3,3,3,3,3,3,3,3,3,3,4,4,4,4,4,4,4,4,4,4,4,4,4,5,5,5,5,5,5,5,5,
+        5,5,5,5,5,8,7,7,6,7,7,6,7,7,6,7,7,6,7,6,6,7,6,6,7,6,6,7,6,6,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,12,1,1,1,1,
+        51,255,51,51,2,1,51,255,12,1,49,257,1,1,1,49,1,257,49,49,2,12,52,52,2,52,8,256,8,8,1,52,8,256,12,50,9,258,50,50,2,9,50,258,9,9,1,12,1,1,1,1,1,1,49,
+        1,257,1,51,255,12,1,54,257,1,1,1,1,1,1,54,11,256,12,50,9,258,52,8,256,8,8,1,9,9,1,12,1,1,1,1,53,255,10,53,258,1,1,1,12,50,9,258,56,56,2,56,56,2,9,
+        51,255,12,55,55,2,52,8,256,49,8,257,55,55,2,12,1,49,257,1,51,255,51,51,2,49,49,2,12,52,52,2,50,50,2,9,50,258,52,8,256,12,50,9,258,52,8,256,49,8,
+        257,9,51,255,12,1,54,257,1,53,255,10,53,258,54,11,256,13,2,2,2,2,51,255,51,51,3,2,51,255,13,2,49,257,2,2,2,49,2,257,49,49,3,13,52,52,3,52,12,256,
+        12,12,2,52,12,256,13,50,13,258,50,50,3,13,50,258,13,13,2,13,2,2,2,2,2,2,49,2,257,2,51,255,13,2,54,257,2,2,2,2,2,2,54,15,256,13,50,13,258,52,12,256,
+        12,12,2,13,13,2,13,2,2,2,2,53,255,14,53,258,2,2,2,13,50,13,258,56,56,3,56,56,3,13,51,255,13,55,55,3,52,12,256,49,12,257,55,55,3,13,2,49,257,2,51,
+        255,51,51,3,49,49,3,13,52,52,3,50,50,3,13,50,258,52,12,256,13,50,13,258,52,12,256,49,12,257,13,51,255,13,2,54,257,2,53,255,14,53,258,54,15,256,10,
+        1,1,1,1,51,255,51,51,4,1,51,255,10,1,49,257,1,1,1,49,1,257,49,49,4,10,52,52,4,52,1,256,1,1,1,52,1,256,10,50,1,258,50,50,4,1,50,258,1,1,1,10,1,1,1,
+        1,1,1,49,1,257,1,51,255,10,1,54,257,1,1,1,1,1,1,54,1,256,10,50,1,258,52,1,256,1,1,1,1,1,1,10,1,1,1,1,53,255,1,53,258,1,1,1,10,50,1,258,56,56,4,56,
+        56,4,1,51,255,10,55,55,4,52,1,256,49,1,257,55,55,4,10,1,49,257,1,51,255,51,51,4,49,49,4,10,52,52,4,50,50,4,1,50,258,52,1,256,10,50,1,258,52,1,256,
+        49,1,257,1,51,255,10,1,54,257,1,53,255,1,53,258,54,1,256,11,2,2,2,2,51,255,51,51,5,2,51,255,11,2,49,257,2,2,2,49,2,257,49,49,5,11,52,52,5,52,2,256,
+        2,2,2,52,2,256,11,50,2,258,50,50,5,2,50,258,2,2,2,11,2,2,2,2,2,2,49,2,257,2,51,255,11,2,54,257,2,2,2,2,2,2,54,2,256,11,50,2,258,52,2,256,2,2,2,2,2,
+        2,11,2,2,2,2,53,255,2,53,258,2,2,2,11,50,2,258,56,56,5,56,56,5,2,51,255,11,55,55,5,52,2,256,49,2,257,55,55,5,11,2,49,257,2,51,255,51,51,5,49,49,5,
+        11,52,52,5,50,50,5,2,50,258,52,2,256,11,50,2,258,52,2,256,49,2,257,2,51,255,11,2,54,257,2,53,255,2,53,258,54,2,256,14,1,1,1,1,51,255,51,51,6,1,51,
+        255,14,1,49,257,1,1,1,49,1,257,49,49,6,14,52,52,6,52,1,256,1,1,1,52,1,256,14,50,1,258,50,50,6,1,50,258,1,1,1,14,1,1,1,1,1,1,49,1,257,1,51,255,14,1,
+        54,257,1,1,1,1,1,1,54,1,256,14,50,1,258,52,1,256,1,1,1,1,1,1,14,1,1,1,1,53,255,1,53,258,1,1,1,14,50,1,258,56,56,6,56,56,6,1,51,255,14,55,55,6,52,1,
+        256,49,1,257,55,55,6,14,1,49,257,1,51,255,51,51,6,49,49,6,14,52,52,6,50,50,6,1,50,258,52,1,256,14,50,1,258,52,1,256,49,1,257,1,51,255,14,1,54,257,
+        1,53,255,1,53,258,54,1,256,15,6,6,7,6,51,255,51,51,1,6,51,255,15,6,49,257,6,6,7,49,6,257,49,49,1,15,52,52,1,52,16,256,16,16,7,52,16,256,15,50,17,
+        258,50,50,1,17,50,258,17,17,7,15,6,6,7,6,6,7,49,6,257,6,51,255,15,6,54,257,6,6,7,6,6,7,54,19,256,15,50,17,258,52,16,256,16,16,7,17,17,7,15,6,6,7,6,
+        53,255,18,53,258,6,6,7,15,50,17,258,56,56,1,56,56,1,17,51,255,15,55,55,1,52,16,256,49,16,257,55,55,1,15,6,49,257,6,51,255,51,51,1,49,49,1,15,52,52,
+        1,50,50,1,17,50,258,52,16,256,15,50,17,258,52,16,256,49,16,257,17,51,255,15,6,54,257,6,53,255,18,53,258,54,19,256
+    };
+
+    inline constexpr uint16_t ashworldIsomLinks[] {
+        0,0,0,0,0,0,0,0,0,0,0,0,0,8,7,7,1,7,7,1,7,7,1,7,7,1,2,1,1,2,1,1,2,1,1,2,1,1,2,3,2,2,3,2,2,3,2,2,3,2,2,3,6,5,5,4,5,5,4,5,5,4,5,5,4,4,3,3,5,3,3,5,3,
+        3,5,3,3,5,5,4,4,6,4,4,6,4,4,6,4,4,6,7,6,6,7,6,6,7,6,6,7,6,6,7,9,8,8,8,8,8,8,8,8,8,8,8,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,17,7,7,1,7,51,255,51,51,2,7,
+        51,255,17,7,49,257,7,7,1,49,7,257,49,49,2,17,52,52,2,52,9,256,9,9,1,52,9,256,17,50,10,258,50,50,2,10,50,258,10,10,1,17,7,7,1,7,7,1,49,7,257,7,51,
+        255,17,7,54,257,7,7,1,7,7,1,54,12,256,17,50,10,258,52,9,256,9,9,1,10,10,1,17,7,7,1,7,53,255,11,53,258,7,7,1,17,50,10,258,56,56,2,56,56,2,10,51,255,
+        17,55,55,2,52,9,256,49,9,257,55,55,2,17,7,49,257,7,51,255,51,51,2,49,49,2,17,52,52,2,50,50,2,10,50,258,52,9,256,17,50,10,258,52,9,256,49,9,257,10,
+        51,255,17,7,54,257,7,53,255,11,53,258,54,12,256,16,1,1,2,1,51,255,51,51,5,1,51,255,16,1,49,257,1,1,2,49,1,257,49,49,5,16,52,52,5,52,13,256,13,13,2,
+        52,13,256,16,50,14,258,50,50,5,14,50,258,14,14,2,16,1,1,2,1,1,2,49,1,257,1,51,255,16,1,54,257,1,1,2,1,1,2,54,16,256,16,50,14,258,52,13,256,13,13,2,
+        14,14,2,16,1,1,2,1,53,255,15,53,258,1,1,2,16,50,14,258,56,56,5,56,56,5,14,51,255,16,55,55,5,52,13,256,49,13,257,55,55,5,16,1,49,257,1,51,255,51,51,
+        5,49,49,5,16,52,52,5,50,50,5,14,50,258,52,13,256,16,50,14,258,52,13,256,49,13,257,14,51,255,16,1,54,257,1,53,255,15,53,258,54,16,256,11,1,1,2,1,51,
+        255,51,51,3,1,51,255,11,1,49,257,1,1,2,49,1,257,49,49,3,11,52,52,3,52,1,256,1,1,2,52,1,256,11,50,1,258,50,50,3,1,50,258,1,1,2,11,1,1,2,1,1,2,49,1,
+        257,1,51,255,11,1,54,257,1,1,2,1,1,2,54,1,256,11,50,1,258,52,1,256,1,1,2,1,1,2,11,1,1,2,1,53,255,1,53,258,1,1,2,11,50,1,258,56,56,3,56,56,3,1,51,
+        255,11,55,55,3,52,1,256,49,1,257,55,55,3,11,1,49,257,1,51,255,51,51,3,49,49,3,11,52,52,3,50,50,3,1,50,258,52,1,256,11,50,1,258,52,1,256,49,1,257,1,
+        51,255,11,1,54,257,1,53,255,1,53,258,54,1,256,12,3,3,5,3,51,255,51,51,6,3,51,255,12,3,49,257,3,3,5,49,3,257,49,49,6,12,52,52,6,52,3,256,3,3,5,52,3,
+        256,12,50,3,258,50,50,6,3,50,258,3,3,5,12,3,3,5,3,3,5,49,3,257,3,51,255,12,3,54,257,3,3,5,3,3,5,54,3,256,12,50,3,258,52,3,256,3,3,5,3,3,5,12,3,3,5,
+        3,53,255,3,53,258,3,3,5,12,50,3,258,56,56,6,56,56,6,3,51,255,12,55,55,6,52,3,256,49,3,257,55,55,6,12,3,49,257,3,51,255,51,51,6,49,49,6,12,52,52,6,
+        50,50,6,3,50,258,52,3,256,12,50,3,258,52,3,256,49,3,257,3,51,255,12,3,54,257,3,53,255,3,53,258,54,3,256,13,1,1,2,1,51,255,51,51,4,1,51,255,13,1,49,
+        257,1,1,2,49,1,257,49,49,4,13,52,52,4,52,1,256,1,1,2,52,1,256,13,50,1,258,50,50,4,1,50,258,1,1,2,13,1,1,2,1,1,2,49,1,257,1,51,255,13,1,54,257,1,1,
+        2,1,1,2,54,1,256,13,50,1,258,52,1,256,1,1,2,1,1,2,13,1,1,2,1,53,255,1,53,258,1,1,2,13,50,1,258,5,5,4,5,5,4,1,51,255,13,5,5,4,52,1,256,49,1,257,5,5,
+        4,13,1,49,257,1,51,255,51,51,4,49,49,4,13,52,52,4,50,50,4,1,50,258,52,1,256,13,50,1,258,52,1,256,49,1,257,1,51,255,13,1,54,257,1,53,255,1,53,258,
+        54,1,256,14,3,3,5,3,51,255,51,51,7,3,51,255,14,3,49,257,3,3,5,49,3,257,49,49,7,14,52,52,7,52,3,256,3,3,5,52,3,256,14,50,3,258,50,50,7,3,50,258,3,3,
+        5,14,3,3,5,3,3,5,49,3,257,3,51,255,14,3,54,257,3,3,5,3,3,5,54,3,256,14,50,3,258,52,3,256,3,3,5,3,3,5,14,3,3,5,3,53,255,3,53,258,3,3,5,14,50,3,258,
+        6,6,7,6,6,7,3,51,255,14,6,6,7,52,3,256,49,3,257,6,6,7,14,3,49,257,3,51,255,51,51,7,49,49,7,14,52,52,7,50,50,7,3,50,258,52,3,256,14,50,3,258,52,3,
+        256,49,3,257,3,51,255,14,3,54,257,3,53,255,3,53,258,54,3,256,15,1,1,2,1,51,255,51,51,8,1,51,255,15,1,49,257,1,1,2,49,1,257,49,49,8,15,52,52,8,52,1,
+        256,1,1,2,52,1,256,15,50,1,258,50,50,8,1,50,258,1,1,2,15,1,1,2,1,1,2,49,1,257,1,51,255,15,1,54,257,1,1,2,1,1,2,54,1,256,15,50,1,258,52,1,256,1,1,2,
+        1,1,2,15,1,1,2,1,53,255,1,53,258,1,1,2,15,50,1,258,56,56,8,56,56,8,1,51,255,15,55,55,8,52,1,256,49,1,257,55,55,8,15,1,49,257,1,51,255,51,51,8,49,
+        49,8,15,52,52,8,50,50,8,1,50,258,52,1,256,15,50,1,258,52,1,256,49,1,257,1,51,255,15,1,54,257,1,53,255,1,53,258,54,1,256
+    };
+
+    inline constexpr uint16_t jungleIsomLinks[] {
+        0,0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,1,1,1,1,3,4,4,2,4,4,2,4,4,2,4,4,2,5,5,5,3,5,5,3,5,5,3,5,5,3,8,8,8,8,8,8,8,8,8,8,8,8,8,9,12,12,11,12,12,
+        11,12,12,11,12,12,11,15,11,11,10,11,11,10,11,11,10,11,11,10,11,6,6,12,6,6,12,6,6,12,6,6,12,16,16,16,13,16,16,13,16,16,13,16,16,13,10,9,9,14,9,9,14,
+        9,9,14,9,9,14,12,7,7,15,7,7,15,7,7,15,7,7,15,13,13,13,16,13,13,16,13,13,16,13,13,16,17,17,17,17,17,17,17,17,17,17,17,17,17,4,15,15,4,15,15,4,15,15,
+        4,15,15,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,34,1,1,1,1,51,255,51,51,2,1,51,255,34,1,49,257,1,1,1,49,1,
+        257,49,49,2,34,52,52,2,52,30,256,30,30,1,52,30,256,34,50,31,258,50,50,2,31,50,258,31,31,1,34,1,1,1,1,1,1,49,1,257,1,51,255,34,1,54,257,1,1,1,1,1,1,
+        54,33,256,34,50,31,258,52,30,256,30,30,1,31,31,1,34,1,1,1,1,53,255,32,53,258,1,1,1,34,50,31,258,56,56,2,56,56,2,31,51,255,34,55,55,2,52,30,256,49,
+        30,257,55,55,2,34,1,49,257,1,51,255,51,51,2,49,49,2,34,52,52,2,50,50,2,31,50,258,52,30,256,34,50,31,258,52,30,256,49,30,257,31,51,255,34,1,54,257,
+        1,53,255,32,53,258,54,33,256,35,5,5,3,5,51,255,51,51,1,5,51,255,35,5,49,257,5,5,3,49,5,257,49,49,1,35,52,52,1,52,34,256,34,34,3,52,34,256,35,50,35,
+        258,50,50,1,35,50,258,35,35,3,35,5,5,3,5,5,3,49,5,257,5,51,255,35,5,54,257,5,5,3,5,5,3,54,37,256,35,50,35,258,52,34,256,34,34,3,35,35,3,35,5,5,3,5,
+        53,255,36,53,258,5,5,3,35,50,35,258,56,56,1,56,56,1,35,51,255,35,55,55,1,52,34,256,49,34,257,55,55,1,35,5,49,257,5,51,255,51,51,1,49,49,1,35,52,52,
+        1,50,50,1,35,50,258,52,34,256,35,50,35,258,52,34,256,49,34,257,35,51,255,35,5,54,257,5,53,255,36,53,258,54,37,256,23,1,1,1,1,51,255,51,51,8,1,51,
+        255,23,1,49,257,1,1,1,49,1,257,49,49,8,23,52,52,8,52,1,256,1,1,1,52,1,256,23,50,1,258,50,50,8,1,50,258,1,1,1,23,1,1,1,1,1,1,49,1,257,1,51,255,23,1,
+        54,257,1,1,1,1,1,1,54,1,256,23,50,1,258,52,1,256,1,1,1,1,1,1,23,1,1,1,1,53,255,1,53,258,1,1,1,23,50,1,258,56,56,8,56,56,8,1,51,255,23,55,55,8,52,1,
+        256,49,1,257,55,55,8,23,1,49,257,1,51,255,51,51,8,49,49,8,23,52,52,8,50,50,8,1,50,258,52,1,256,23,50,1,258,52,1,256,49,1,257,1,51,255,23,1,54,257,
+        1,53,255,1,53,258,54,1,256,28,1,1,1,1,51,255,51,51,10,1,51,255,28,1,49,257,1,1,1,49,1,257,49,49,10,28,52,52,10,52,1,256,1,1,1,52,1,256,28,50,1,258,
+        50,50,10,1,50,258,1,1,1,28,1,1,1,1,1,1,49,1,257,1,51,255,28,1,54,257,1,1,1,1,1,1,54,1,256,28,50,1,258,52,1,256,1,1,1,1,1,1,28,1,1,1,1,53,255,1,53,
+        258,1,1,1,28,50,1,258,11,11,10,11,11,10,1,51,255,28,11,11,10,52,1,256,49,1,257,11,11,10,28,1,49,257,1,51,255,51,51,10,49,49,10,28,52,52,10,50,50,
+        10,1,50,258,52,1,256,28,50,1,258,52,1,256,49,1,257,1,51,255,28,1,54,257,1,53,255,1,53,258,54,1,256,29,8,8,8,8,51,255,51,51,11,8,51,255,29,8,49,257,
+        8,8,8,49,8,257,49,49,11,29,52,52,11,52,8,256,8,8,8,52,8,256,29,50,8,258,50,50,11,8,50,258,8,8,8,29,8,8,8,8,8,8,49,8,257,8,51,255,29,8,54,257,8,8,8,
+        8,8,8,54,8,256,29,50,8,258,52,8,256,8,8,8,8,8,8,29,8,8,8,8,53,255,8,53,258,8,8,8,29,50,8,258,12,12,11,12,12,11,8,51,255,29,12,12,11,52,8,256,49,8,
+        257,12,12,11,29,8,49,257,8,51,255,51,51,11,49,49,11,29,52,52,11,50,50,11,8,50,258,52,8,256,29,50,8,258,52,8,256,49,8,257,8,51,255,29,8,54,257,8,53,
+        255,8,53,258,54,8,256,25,8,8,8,8,51,255,51,51,12,8,51,255,25,8,49,257,8,8,8,49,8,257,49,49,12,25,52,52,12,52,8,256,8,8,8,52,8,256,25,50,8,258,50,
+        50,12,8,50,258,8,8,8,25,8,8,8,8,8,8,49,8,257,8,51,255,25,8,54,257,8,8,8,8,8,8,54,8,256,25,50,8,258,52,8,256,8,8,8,8,8,8,25,8,8,8,8,53,255,8,53,258,
+        8,8,8,25,50,8,258,6,6,12,6,6,12,8,51,255,25,6,6,12,52,8,256,49,8,257,6,6,12,25,8,49,257,8,51,255,51,51,12,49,49,12,25,52,52,12,50,50,12,8,50,258,
+        52,8,256,25,50,8,258,52,8,256,49,8,257,8,51,255,25,8,54,257,8,53,255,8,53,258,54,8,256,32,8,8,8,8,51,255,51,51,13,8,51,255,32,8,49,257,8,8,8,49,8,
+        257,49,49,13,32,52,52,13,52,18,256,18,18,8,52,18,256,32,50,19,258,50,50,13,19,50,258,19,19,8,32,8,8,8,8,8,8,49,8,257,8,51,255,32,8,54,257,8,8,8,8,
+        8,8,54,21,256,32,50,19,258,52,18,256,18,18,8,19,19,8,32,8,8,8,8,53,255,20,53,258,8,8,8,32,50,19,258,56,56,13,56,56,13,19,51,255,32,55,55,13,52,18,
+        256,49,18,257,55,55,13,32,8,49,257,8,51,255,51,51,13,49,49,13,32,52,52,13,50,50,13,19,50,258,52,18,256,32,50,19,258,52,18,256,49,18,257,19,51,255,
+        32,8,54,257,8,53,255,20,53,258,54,21,256,24,4,4,2,4,51,255,51,51,14,4,51,255,24,4,49,257,4,4,2,49,4,257,49,49,14,24,52,52,14,52,4,256,4,4,2,52,4,
+        256,24,50,4,258,50,50,14,4,50,258,4,4,2,24,4,4,2,4,4,2,49,4,257,4,51,255,24,4,54,257,4,4,2,4,4,2,54,4,256,24,50,4,258,52,4,256,4,4,2,4,4,2,24,4,4,
+        2,4,53,255,4,53,258,4,4,2,24,50,4,258,56,56,14,56,56,14,4,51,255,24,55,55,14,52,4,256,49,4,257,55,55,14,24,4,49,257,4,51,255,51,51,14,49,49,14,24,
+        52,52,14,50,50,14,4,50,258,52,4,256,24,50,4,258,52,4,256,49,4,257,4,51,255,24,4,54,257,4,53,255,4,53,258,54,4,256,26,9,9,14,9,51,255,51,51,15,9,51,
+        255,26,9,49,257,9,9,14,49,9,257,49,49,15,26,52,52,15,52,9,256,9,9,14,52,9,256,26,50,9,258,50,50,15,9,50,258,9,9,14,26,9,9,14,9,9,14,49,9,257,9,51,
+        255,26,9,54,257,9,9,14,9,9,14,54,9,256,26,50,9,258,52,9,256,9,9,14,9,9,14,26,9,9,14,9,53,255,9,53,258,9,9,14,26,50,9,258,7,7,15,7,7,15,9,51,255,26,
+        7,7,15,52,9,256,49,9,257,7,7,15,26,9,49,257,9,51,255,51,51,15,49,49,15,26,52,52,15,50,50,15,9,50,258,52,9,256,26,50,9,258,52,9,256,49,9,257,9,51,
+        255,26,9,54,257,9,53,255,9,53,258,54,9,256,30,9,9,14,9,51,255,51,51,16,9,51,255,30,9,49,257,9,9,14,49,9,257,49,49,16,30,52,52,16,52,9,256,9,9,14,
+        52,9,256,30,50,9,258,50,50,16,9,50,258,9,9,14,30,9,9,14,9,9,14,49,9,257,9,51,255,30,9,54,257,9,9,14,9,9,14,54,9,256,30,50,9,258,52,9,256,9,9,14,9,
+        9,14,30,9,9,14,9,53,255,9,53,258,9,9,14,30,50,9,258,13,13,16,13,13,16,9,51,255,30,13,13,16,52,9,256,49,9,257,13,13,16,30,9,49,257,9,51,255,51,51,
+        16,49,49,16,30,52,52,16,50,50,16,9,50,258,52,9,256,30,50,9,258,52,9,256,49,9,257,9,51,255,30,9,54,257,9,53,255,9,53,258,54,9,256,33,9,9,14,9,51,
+        255,51,51,17,9,51,255,33,9,49,257,9,9,14,49,9,257,49,49,17,33,52,52,17,52,22,256,22,22,14,52,22,256,33,50,23,258,50,50,17,23,50,258,23,23,14,33,9,
+        9,14,9,9,14,49,9,257,9,51,255,33,9,54,257,9,9,14,9,9,14,54,25,256,33,50,23,258,52,22,256,22,22,14,23,23,14,33,9,9,14,9,53,255,24,53,258,9,9,14,33,
+        50,23,258,56,56,17,56,56,17,23,51,255,33,55,55,17,52,22,256,49,22,257,55,55,17,33,9,49,257,9,51,255,51,51,17,49,49,17,33,52,52,17,50,50,17,23,50,
+        258,52,22,256,33,50,23,258,52,22,256,49,22,257,23,51,255,33,9,54,257,9,53,255,24,53,258,54,25,256,22,1,1,1,1,51,255,51,51,4,1,51,255,22,1,49,257,1,
+        1,1,49,1,257,49,49,4,22,52,52,4,52,1,256,1,1,1,52,1,256,22,50,1,258,50,50,4,1,50,258,1,1,1,22,1,1,1,1,1,1,49,1,257,1,51,255,22,1,54,257,1,1,1,1,1,
+        1,54,1,256,22,50,1,258,52,1,256,1,1,1,1,1,1,22,1,1,1,1,53,255,1,53,258,1,1,1,22,50,1,258,56,56,4,56,56,4,1,51,255,22,55,55,4,52,1,256,49,1,257,55,
+        55,4,22,1,49,257,1,51,255,51,51,4,49,49,4,22,52,52,4,50,50,4,1,50,258,52,1,256,22,50,1,258,52,1,256,49,1,257,1,51,255,22,1,54,257,1,53,255,1,53,
+        258,54,1,256
+    };
+
+    inline constexpr Span<uint16_t> isomLinkTables[] { badlandsIsomLinks, spaceIsomLinks, installationIsomLinks, ashworldIsomLinks, jungleIsomLinks };
+    inline constexpr std::string_view fixtureTilesetNames[] { "badlands", "platform", "install", "ashworld", "jungle" };
+    inline constexpr size_t totalFixtureTilesets = sizeof(isomLinkTables)/sizeof(isomLinkTables[0]); // Desert, ice and twilight have no extracted tables
+
+    /**
+        Builds a tileset for the given tileset index from its extracted isomLink table without CV5 data from a StarCraft install
+
+        The table is loaded as-is and a tile group is synthesized for every rect two linking diamonds can form, keyed by the same hash updateTilesFromIsom
+        looks up; the synthesized groups have no stack connections, so placing terrain resolves the same ISOM as with the real CV5 but tiles can differ
+    */
+    inline Sc::Terrain_::Tiles makeFixtureTiles(size_t tilesetIndex)
+    {
+        Sc::Terrain_::Tiles tiles {};
+        if ( tilesetIndex >= totalFixtureTilesets )
+            return tiles;
+
+        tiles.terrainTypes = Sc::Isom::tilesetTerrainTypes[tilesetIndex];
+        tiles.populateTerrainTypeMap(tilesetIndex);
+
+        Span<uint16_t> table = isomLinkTables[tilesetIndex];
+        for ( size_t i=0; i+13<=table.size(); i+=13 )
+        {
+            using Link = Sc::Isom::Link;
+            using LinkId = Sc::Isom::LinkId;
+            tiles.isomLinks.push_back(Sc::Isom::ShapeLinks{uint8_t(table[i]),
+                {Link(table[i+1]), Link(table[i+2]), LinkId(table[i+3])},
+                {Link(table[i+4]), Link(table[i+5]), LinkId(table[i+6])},
+                {Link(table[i+7]), Link(table[i+8]), LinkId(table[i+9])},
+                {Link(table[i+10]), Link(table[i+11]), LinkId(table[i+12])}
+            });
+        }
+
+        auto addTileGroup = [&](const Chk::IsomRect & isomRect) {
+            uint32_t hash = isomRect.getHash(Span<Sc::Isom::ShapeLinks>(&tiles.isomLinks[0], tiles.isomLinks.size()));
+            if ( tiles.hashToTileGroup.find(hash) != tiles.hashToTileGroup.end() )
+                return;
+
+            Sc::Isom::TileGroup tileGroup {};
+            tileGroup.terrainType = uint16_t(hash & 0x3F);
+            tileGroup.links.left = Sc::Isom::Link((hash >> 24) & 0x3F);
+            tileGroup.links.top = Sc::Isom::Link((hash >> 18) & 0x3F);
+            tileGroup.links.right = Sc::Isom::Link((hash >> 12) & 0x3F);
+            tileGroup.links.bottom = Sc::Isom::Link((hash >> 6) & 0x3F);
+            for ( uint16_t i=0; i<4; ++i )
+                tileGroup.megaTileIndex[i] = uint16_t(1 + i); // Gives getRandomSubtile some common tiles to choose from
+
+            tiles.hashToTileGroup.insert(std::make_pair(hash, std::vector<uint16_t>{uint16_t(tiles.tileGroups.size())}));
+            tiles.tileGroups.push_back(tileGroup); // Tile groups come in pairs, the left and right tile of a rect
+            tiles.tileGroups.push_back(tileGroup);
+        };
+
+        for ( size_t first=1; first<tiles.isomLinks.size(); ++first )
+        {
+            const auto & firstShape = tiles.isomLinks[first];
+            if ( firstShape.terrainType == 0 )
+                continue;
+
+            for ( size_t second=1; second<tiles.isomLinks.size(); ++second )
+            {
+                const auto & secondShape = tiles.isomLinks[second];
+                if ( secondShape.terrainType == 0 )
+                    continue;
+
+                Chk::IsomRect isomRect {};
+                if ( Sc::Isom::ShapeLinks::linksMatch(firstShape.bottomRight.linkId, firstShape.terrainType, secondShape.topLeft.linkId, secondShape.terrainType) ) // First diamond above and left of second
+                {
+                    isomRect.set(Sc::Isom::Quadrant::BottomRight, uint16_t(first));
+                    isomRect.set(Sc::Isom::Quadrant::TopLeft, uint16_t(second));
+                    addTileGroup(isomRect);
+                }
+                if ( Sc::Isom::ShapeLinks::linksMatch(firstShape.topRight.linkId, firstShape.terrainType, secondShape.bottomLeft.linkId, secondShape.terrainType) ) // First diamond below and left of second
+                {
+                    isomRect.set(Sc::Isom::Quadrant::TopRight, uint16_t(first));
+                    isomRect.set(Sc::Isom::Quadrant::BottomLeft, uint16_t(second));
+                    addTileGroup(isomRect);
+                }
+            }
+        }
+
+        tiles.populateIsomLookups(tilesetIndex);
+        return tiles;
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,323 @@
+#ifndef ISOMJOURNAL_H
+#define ISOMJOURNAL_H
+#include "IsomApi.h"
+#include "IsomMapFile.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+    A compact binary record of the terrain operations made to one map (placements, flood fills, pastes, resizes & subtile seeds) which can be replayed
+    against the same base map to reproduce an editing session, or replayed at full speed as a benchmark workload
+
+    Layout (little-endian): the header {"ISOJ", u16 version, u16 tileset, u16 tileWidth, u16 tileHeight, u32 seed} is followed by one record per operation,
+    each a u8 Op and that op's fixed-size parameters; pastes are followed by the stamp's isomRects & tiles
+
+    Operations between EndBatch records (e.g. mouse down to mouse up) form a batch, replay regenerates the tiles once per batch rather than once per op
+
+    Set IsomCache::recorder to have placements, flood fills & pastes recorded as they're made, resizes, seeds & batch ends are recorded by the caller
+*/
+class IsomJournal : public Chk::IsomEditRecorder
+{
+public:
+    enum class Op : uint8_t {
+        Place = 1, // u16 x, u16 y, u16 terrainType, u16 brushSize
+        FloodFill = 2, // u16 x, u16 y, u16 terrainType
+        Paste = 3, // u16 x, u16 y, u16 width, u16 height, IsomRect[width*height], u16 tiles[2*width*height]
+        Resize = 4, // u16 newWidth, u16 newHeight, s16 xOffset, s16 yOffset, u16 terrainType
+        Seed = 5, // u32 seed
+        EndBatch = 6
+    };
+
+    static constexpr char magic[4] { 'I', 'S', 'O', 'J' };
+    static constexpr uint16_t version = 1;
+    static constexpr size_t headerSize = 4 + 2 + 2 + 2 + 2 + 4;
+
+    struct ReplayResult
+    {
+        bool success = false;
+        size_t operations = 0; // Places, flood fills, pastes & resizes, seeds & batch ends aren't counted
+        size_t skippedOperations = 0; // Ops which changed nothing when recorded either, e.g. flood filling terrain with its own terrain type
+        size_t batches = 0;
+        std::string error {};
+    };
+
+    inline IsomJournal(Sc::Terrain::Tileset tileset, uint16_t tileWidth, uint16_t tileHeight, uint32_t seed)
+    {
+        bytes.insert(bytes.end(), std::begin(magic), std::end(magic));
+        write(version);
+        write(uint16_t(tileset));
+        write(tileWidth);
+        write(tileHeight);
+        write(seed);
+    }
+
+    inline Sc::Terrain::Tileset getTileset() const { return Sc::Terrain::Tileset(read<uint16_t>(4+2)); }
+    inline uint16_t getTileWidth() const { return read<uint16_t>(4+4); }
+    inline uint16_t getTileHeight() const { return read<uint16_t>(4+6); }
+    inline uint32_t getSeed() const { return read<uint32_t>(4+8); }
+    inline const std::vector<uint8_t> & getBytes() const { return bytes; }
+
+    inline void recordPlace(Chk::IsomDiamond isomDiamond, size_t terrainType, size_t brushSize) override
+    {
+        write(Op::Place);
+        write(uint16_t(isomDiamond.x));
+        write(uint16_t(isomDiamond.y));
+        write(uint16_t(terrainType));
+        write(uint16_t(brushSize));
+    }
+
+    inline void recordFloodFill(Chk::IsomDiamond isomDiamond, size_t terrainType) override
+    {
+        write(Op::FloodFill);
+        write(uint16_t(isomDiamond.x));
+        write(uint16_t(isomDiamond.y));
+        write(uint16_t(terrainType));
+    }
+
+    inline void recordPaste(const Chk::IsomStamp & stamp, Chk::IsomDiamond topLeft) override
+    {
+        write(Op::Paste);
+        write(uint16_t(topLeft.x));
+        write(uint16_t(topLeft.y));
+        write(uint16_t(stamp.width));
+        write(uint16_t(stamp.height));
+        writeArray(stamp.isomRects.data(), stamp.width*stamp.height);
+        writeArray(stamp.tiles.data(), 2*stamp.width*stamp.height);
+    }
+
+    inline void recordResize(uint16_t newWidth, uint16_t newHeight, int16_t xOffset, int16_t yOffset, size_t terrainType)
+    {
+        write(Op::Resize);
+        write(newWidth);
+        write(newHeight);
+        write(xOffset);
+        write(yOffset);
+        write(uint16_t(terrainType));
+    }
+
+    inline void recordSeed(uint32_t seed)
+    {
+        write(Op::Seed);
+        write(seed);
+    }
+
+    inline void recordEndBatch() { write(Op::EndBatch); }
+
+    // Validates the header, the records are validated as they're replayed
+    static inline std::optional<IsomJournal> fromBytes(std::vector<uint8_t> bytes)
+    {
+        if ( bytes.size() < headerSize || std::memcmp(&bytes[0], magic, sizeof(magic)) != 0 )
+            return std::nullopt;
+
+        IsomJournal journal {};
+        journal.bytes.swap(bytes);
+        if ( journal.read<uint16_t>(4) != version || size_t(journal.getTileset()) >= Sc::Terrain::NumTilesets )
+            return std::nullopt;
+
+        return journal;
+    }
+
+    static inline std::optional<IsomJournal> load(const std::string & filePath)
+    {
+        std::ifstream inFile(filePath, std::ios_base::in|std::ios_base::binary);
+        if ( !inFile )
+            return std::nullopt;
+
+        return fromBytes(std::vector<uint8_t>(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>()));
+    }
+
+    inline bool save(const std::string & filePath) const
+    {
+        std::ofstream outFile(filePath, std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+        if ( !outFile )
+            return false;
+
+        outFile.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+        return outFile.good();
+    }
+
+    // Replays every operation against scMap, which must have the tileset & dimensions the journal was started with
+    // One IsomCache is used until a resize, no undos are recorded & tiles are regenerated once per batch; ISOM matches the recorded session exactly
+    // while tiles match by tile group, subtiles differ where the session regenerated a tile more times than the replay does
+    inline ReplayResult replay(ScMap & scMap, const Sc::Terrain_::Tiles & tiles) const
+    {
+        ReplayResult result {};
+        if ( scMap.tileset != getTileset() || scMap.tileWidth != getTileWidth() || scMap.tileHeight != getTileHeight() )
+        {
+            result.error = "Base map does not match the journal's tileset and dimensions";
+            return result;
+        }
+
+        auto cache = std::make_unique<Chk::IsomCache>(scMap.tileset, scMap.tileWidth, scMap.tileHeight, tiles);
+        cache->recordUndos = false;
+        cache->seedSubtiles(getSeed());
+
+        std::vector<Chk::IsomRect> batchStartRects = scMap.isomRects;
+        Sc::BoundingBox batchArea { cache->isomWidth, cache->isomHeight, 0, 0 };
+        bool batchPending = false;
+        auto endBatch = [&]() {
+            if ( batchPending )
+            {
+                scMap.updateTilesFromBatch(batchStartRects, batchArea, *cache);
+                batchStartRects = scMap.isomRects;
+                batchArea = Sc::BoundingBox { cache->isomWidth, cache->isomHeight, 0, 0 };
+                batchPending = false;
+                ++result.batches;
+            }
+        };
+
+        size_t offset = headerSize;
+        while ( offset < bytes.size() )
+        {
+            Op op = Op(bytes[offset++]);
+            bool applied = true;
+            switch ( op )
+            {
+                case Op::Place:
+                {
+                    if ( !hasBytes(offset, 8) )
+                        return truncated(result, offset);
+
+                    Chk::IsomDiamond isomDiamond {readNext<uint16_t>(offset), readNext<uint16_t>(offset)};
+                    uint16_t terrainType = readNext<uint16_t>(offset);
+                    uint16_t brushSize = readNext<uint16_t>(offset);
+                    applied = scMap.placeIsomTerrain(isomDiamond, terrainType, brushSize, *cache);
+                    scMap.deferTileUpdate(batchArea, *cache);
+                    batchPending = true;
+                }
+                break;
+                case Op::FloodFill:
+                {
+                    if ( !hasBytes(offset, 6) )
+                        return truncated(result, offset);
+
+                    Chk::IsomDiamond isomDiamond {readNext<uint16_t>(offset), readNext<uint16_t>(offset)};
+                    uint16_t terrainType = readNext<uint16_t>(offset);
+                    applied = scMap.floodFillIsomTerrain(isomDiamond, terrainType, *cache);
+                    scMap.deferTileUpdate(batchArea, *cache);
+                    batchPending = true;
+                }
+                break;
+                case Op::Paste:
+                {
+                    if ( !hasBytes(offset, 8) )
+                        return truncated(result, offset);
+
+                    Chk::IsomDiamond topLeft {readNext<uint16_t>(offset), readNext<uint16_t>(offset)};
+                    Chk::IsomStamp stamp { scMap.tileset, readNext<uint16_t>(offset), readNext<uint16_t>(offset) };
+                    if ( !hasBytes(offset, stamp.width*stamp.height*(sizeof(Chk::IsomRect) + 2*sizeof(uint16_t))) )
+                        return truncated(result, offset);
+
+                    stamp.isomRects.resize(stamp.width*stamp.height);
+                    stamp.tiles.resize(2*stamp.width*stamp.height);
+                    readArray(offset, stamp.isomRects.data(), stamp.isomRects.size());
+                    readArray(offset, stamp.tiles.data(), stamp.tiles.size());
+
+                    endBatch(); // Pastes keep the stamp's own tiles so they're updated right away rather than regenerated with the batch
+                    applied = scMap.placeIsomStamp(stamp, topLeft, *cache);
+                    scMap.updateTilesFromIsom(*cache);
+                    batchStartRects = scMap.isomRects;
+                }
+                break;
+                case Op::Resize:
+                {
+                    if ( !hasBytes(offset, 10) )
+                        return truncated(result, offset);
+
+                    uint16_t newWidth = readNext<uint16_t>(offset);
+                    uint16_t newHeight = readNext<uint16_t>(offset);
+                    int16_t xOffset = readNext<int16_t>(offset);
+                    int16_t yOffset = readNext<int16_t>(offset);
+                    uint16_t terrainType = readNext<uint16_t>(offset);
+                    endBatch();
+                    scMap = resizeScMap(tiles, scMap, newWidth, newHeight, xOffset, yOffset, terrainType);
+                    cache = std::make_unique<Chk::IsomCache>(scMap.tileset, scMap.tileWidth, scMap.tileHeight, tiles); // Dimensions changed
+                    cache->recordUndos = false;
+                    cache->seedSubtiles(getSeed());
+                    batchStartRects = scMap.isomRects;
+                    batchArea = Sc::BoundingBox { cache->isomWidth, cache->isomHeight, 0, 0 };
+                }
+                break;
+                case Op::Seed:
+                    if ( !hasBytes(offset, 4) )
+                        return truncated(result, offset);
+
+                    cache->seedSubtiles(readNext<uint32_t>(offset));
+                    break;
+                case Op::EndBatch:
+                    endBatch();
+                    break;
+                default:
+                    result.error = "Unknown op " + std::to_string(int(op)) + " at byte " + std::to_string(offset-1);
+                    return result;
+            }
+            if ( !applied )
+                ++result.skippedOperations;
+
+            if ( op != Op::Seed && op != Op::EndBatch )
+                ++result.operations;
+        }
+        endBatch();
+        result.success = true;
+        return result;
+    }
+
+private:
+    std::vector<uint8_t> bytes {};
+
+    IsomJournal() = default;
+
+    template <typename T>
+    inline void write(T value)
+    {
+        uint8_t valueBytes[sizeof(T)] {};
+        std::memcpy(valueBytes, &value, sizeof(T));
+        bytes.insert(bytes.end(), std::begin(valueBytes), std::end(valueBytes));
+    }
+
+    template <typename T>
+    inline void writeArray(const T* values, size_t count)
+    {
+        const uint8_t* valueBytes = reinterpret_cast<const uint8_t*>(values);
+        bytes.insert(bytes.end(), valueBytes, valueBytes + count*sizeof(T));
+    }
+
+    template <typename T>
+    inline T read(size_t offset) const
+    {
+        T value {};
+        std::memcpy(&value, &bytes[offset], sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    inline T readNext(size_t & offset) const
+    {
+        T value = read<T>(offset);
+        offset += sizeof(T);
+        return value;
+    }
+
+    template <typename T>
+    inline void readArray(size_t & offset, T* values, size_t count) const
+    {
+        std::memcpy(values, &bytes[offset], count*sizeof(T));
+        offset += count*sizeof(T);
+    }
+
+    inline bool hasBytes(size_t offset, size_t count) const { return bytes.size() >= offset && bytes.size() - offset >= count; }
+
+    static inline ReplayResult & truncated(ReplayResult & result, size_t offset)
+    {
+        result.error = "Journal truncated at byte " + std::to_string(offset);
+        return result;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef ISOMMAPFILE_H
+#define ISOMMAPFILE_H
+#include "IsomApi.h"
+#include "../MappingCoreLib/MappingCore.h"
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Whole-map ISOM operations on MapFiles (new map, place terrain, resize) shared by the tests and the batch tool
+// The Sc::Terrain_ passed in is only read so one loaded instance can be shared between threads, each operation makes its own IsomCache
+
+struct PlaceTerrainOp {
+    size_t terrainType;
+    size_t x; // x is a tileCoord/2, only even x-coords are valid on even y coords, only odd x-coords are valid on odd y-coords
+    size_t y;
+    size_t brushSize = 1;
+};
+
+// Copying between MapFile and ScMap is unnecessary overhead and isom editing should be built into a map object in a real impl, but the hard separation helps demo this separately
+inline ScMap copyToScMap(const MapFile & src)
+{
+    ScMap dest {};
+    dest.tileWidth = uint16_t(src.getTileWidth());
+    dest.tileHeight = uint16_t(src.getTileHeight());
+    dest.tileset = src.getTileset();
+    dest.isomRects.assign(src.isomRects.size(), {});
+    std::memcpy(&dest.isomRects[0], &src.isomRects[0], src.isomRects.size()*sizeof(Chk::IsomRect)); // ISOM
+    dest.editorTiles = src.editorTiles; // TILE
+    dest.tiles = src.tiles; // MTXM
+    return dest;
+}
+
+inline void copyFromScMap(MapFile & dest, const ScMap & src)
+{
+    dest.markDirty({Chk::SectionName::DIM, Chk::SectionName::ERA, Chk::SectionName::ISOM, Chk::SectionName::TILE, Chk::SectionName::MTXM});
+    dest.dimensions.tileWidth = src.tileWidth;
+    dest.dimensions.tileHeight = src.tileHeight;
+    dest.tileset = src.tileset;
+    dest.isomRects.assign(src.isomRects.size(), {});
+    std::memcpy(&dest.isomRects[0], &src.isomRects[0], src.isomRects.size()*sizeof(Chk::IsomRect)); // ISOM
+    dest.editorTiles = src.editorTiles; // TILE
+    dest.tiles = src.tiles; // MTXM
+}
+
+// Terrain operations only need Scenario::terrainSections, opening with those leaves every other section as-is for a faster load & an unchanged save
+// Batch tools can pass a per-worker memoryResource (e.g. a monotonic_buffer_resource released after each map), it must outlive the returned map
+// Callers that change the map only through MapFile's methods & these helpers can reuseCleanSections so untouched sections are saved from the bytes read
+inline std::unique_ptr<MapFile> openMap(const std::string & mapFilePath, const Scenario::SectionMask* sectionsToParse = nullptr,
+    std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource(), bool reuseCleanSections = false)
+{
+    // Could alternatively use MapFile(MapFile::getDefaultOpenMapBrowser());
+    auto mapFile = std::make_unique<MapFile>(mapFilePath, sectionsToParse, memoryResource, reuseCleanSections);
+    return mapFile && !mapFile->empty() ? std::move(mapFile) : nullptr;
+}
+
+inline std::unique_ptr<MapFile> newMap(const Sc::Terrain_ & terrain, Sc::Terrain::Tileset tileset, uint16_t width, uint16_t height, size_t terrainType)
+{
+    auto mapFile = std::make_unique<MapFile>(tileset, width, height);
+    ScMap scMap = copyToScMap(*mapFile);
+
+    Chk::IsomCache isomCache(tileset, width, height, terrain.get(tileset));
+
+    uint16_t isomValue = ((isomCache.getTerrainTypeIsomValue(terrainType) << 4) | Chk::IsomRect::EditorFlag::Modified);
+    scMap.isomRects.assign(scMap.getIsomWidth()*scMap.getIsomHeight(), Chk::IsomRect{isomValue, isomValue, isomValue, isomValue});
+
+    isomCache.setAllChanged();
+    scMap.updateTilesFromIsom(isomCache);
+    
+    copyFromScMap(*mapFile, scMap);
+    return std::move(mapFile);
+}
+
+// isomX is a tileCoordinate/2, only even x-coordinates are valid on even y coordinates, only odd x-coordinates are valid on odd y-coordinates
+// isomBrush is one of the values from IsomBrush.h, e.g. Sc::Isom::Brush::Badlands::Dirt
+inline bool placeTerrain(const Sc::Terrain_ & terrain, MapFile & mapFile, size_t terrainType, size_t isomX, size_t isomY, size_t brushSize)
+{
+    ScMap scMap = copyToScMap(mapFile);
+    Chk::IsomCache isomCache(scMap.tileset, scMap.tileWidth, scMap.tileHeight, terrain.get(mapFile.tileset));
+    scMap.placeIsomTerrain({isomX, isomY}, terrainType, brushSize, isomCache);
+    scMap.updateTilesFromIsom(isomCache);
+    copyFromScMap(mapFile, scMap);
+    return true;
+}
+
+inline bool placeTerrain(const Sc::Terrain_ & terrain, MapFile & mapFile, const std::vector<PlaceTerrainOp> & ops)
+{
+    for ( const auto & op : ops )
+    {
+        if ( !placeTerrain(terrain, mapFile, op.terrainType, op.x, op.y, op.brushSize) )
+            return false;
+    }
+    return true;
+}
+
+void setMtxmOrTileDimensions(std::vector<u16> & tiles, u16 newTileWidth, u16 newTileHeight, u16 oldTileWidth, u16 oldTileHeight, s32 leftEdge, s32 topEdge);
+
+// Returns a copy of scMap resized to the new dimensions with its terrain shifted by the offsets & any newly exposed area filled with terrainType
+inline ScMap resizeScMap(const Sc::Terrain_::Tiles & tiles, const ScMap & scMap, uint16_t newWidth, uint16_t newHeight, int xOffset, int yOffset, size_t terrainType)
+{
+    ScMap destMap {};
+    destMap.tileset = scMap.tileset;
+    destMap.tileWidth = scMap.tileWidth;
+    destMap.tileHeight = scMap.tileHeight;
+    Chk::IsomCache destIsomCache(scMap.tileset, newWidth, newHeight, tiles);
+
+    destMap.editorTiles = scMap.editorTiles;
+    destMap.tiles = scMap.tiles;
+    setMtxmOrTileDimensions(destMap.tiles, newWidth, newHeight, (uint16_t)scMap.tileWidth, (uint16_t)scMap.tileHeight, 0, 0);
+    setMtxmOrTileDimensions(destMap.editorTiles, newWidth, newHeight, (uint16_t)scMap.tileWidth, (uint16_t)scMap.tileHeight, 0, 0);
+    uint16_t isomValue = ((destIsomCache.getTerrainTypeIsomValue(terrainType) << 4) | Chk::IsomRect::EditorFlag::Modified);
+
+    destMap.tileWidth = newWidth;
+    destMap.tileHeight = newHeight;
+    destMap.isomRects.assign((newWidth/2+1)*(newHeight+1), Chk::IsomRect{ isomValue, isomValue, isomValue, isomValue });
+    
+    destMap.copyIsomFrom(scMap, xOffset, yOffset, false, destIsomCache);
+    destMap.resizeIsom(xOffset, yOffset, scMap.tileWidth, scMap.tileHeight, false, destIsomCache);
+    destMap.updateTilesFromIsom(destIsomCache);
+
+    Sc::BoundingBox tileRect { scMap.tileWidth, scMap.tileHeight, newWidth, newHeight, xOffset, yOffset };
+    size_t destStartX = xOffset < 0 ? 0 : xOffset;
+    size_t destStartY = yOffset < 0 ? 0 : yOffset;
+    size_t copyHeight = tileRect.bottom-tileRect.top;
+    size_t copyWidth = tileRect.right-tileRect.left;
+    for ( size_t y=0; y<copyHeight; ++y )
+    {
+        for ( size_t x=0; x<copyWidth; ++x )
+        {
+            destMap.editorTiles[(y+destStartY)*newWidth+(x+destStartX)] = scMap.editorTiles[(y+tileRect.top)*scMap.tileWidth+(x+tileRect.left)];
+            destMap.tiles[(y+destStartY)*newWidth+(x+destStartX)] = scMap.tiles[(y+tileRect.top)*scMap.tileWidth+(x+tileRect.left)];
+        }
+    }
+    return destMap;
+}
+
+inline bool resizeMap(const Sc::Terrain_ & terrain, MapFile & mapFile, uint16_t newWidth, uint16_t newHeight, int xOffset, int yOffset, size_t terrainType)
+{
+    ScMap destMap = resizeScMap(terrain.get(mapFile.getTileset()), copyToScMap(mapFile), newWidth, newHeight, xOffset, yOffset, terrainType);
+    copyFromScMap(mapFile, destMap);
+    return true;
+}
+
+#endif
\ No newline at end of file
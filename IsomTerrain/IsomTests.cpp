@@ -1,249 +1,101 @@
 #include "IsomTests.h"
 #include "IsomApi.h"
+#include "IsomDiff.h"
+#include "IsomFixtures.h"
+#include "IsomJournal.h"
+#include "IsomMapFile.h"
 #include "../CrossCutLib/Logger.h"
-#include "../CrossCutLib/SimpleIcu.h"
 #include "../MappingCoreLib/MappingCore.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <sstream>
 #include <string>
-#include <Windows.h>
+#include <thread>
 #include <unordered_set>
 
 Logger logger(LogLevel::Warn);
 
-Sc::Terrain_ terrainDat;
+Sc::Terrain_ terrainDat; // Loaded once then shared read-only by every test, each test makes its own IsomCache
 
-enum class EnumFilesResult { Success, PartialSuccess, Failure };
+ThreadPool threadPool;
 
-template <typename FileFound>
-EnumFilesResult EnumDirectoryFiles(const std::string &directoryPath, FileFound && fileFound)
+// Results of one regression test, tests run concurrently so output is buffered and printed in test order once all tests finish
+struct TestResult
 {
-    WIN32_FIND_DATA findData = {};
-    HANDLE hFind = FindFirstFile(icux::toFilestring(directoryPath + "\\*").c_str(), &findData);
-    if ( hFind != INVALID_HANDLE_VALUE )
-    {
-        EnumFilesResult result = EnumFilesResult::Success;
-        do
-        {
-            if ( (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == FILE_ATTRIBUTE_DIRECTORY )
-            {
-                if ( strcmp(icux::toUtf8(findData.cFileName).c_str(), ".") != 0 && strcmp(icux::toUtf8(findData.cFileName).c_str(), "..") != 0 )
-                {
-                    const std::string subDirectory(directoryPath + "\\" + icux::toUtf8(findData.cFileName));
-
-                    if ( EnumDirectoryFiles(subDirectory, fileFound)
-                        != EnumFilesResult::Success )
-                    {
-                        result = EnumFilesResult::PartialSuccess;
-                    }
-                }
-            }
-            else
-                fileFound(directoryPath + '\\' + icux::toUtf8(findData.cFileName));
-
-        } while ( FindNextFile(hFind, &findData) != 0 );
+    std::ostringstream output {};
+    size_t passCount = 0;
+    size_t failCount = 0;
+    double wallMs = 0.0;
 
-        if ( GetLastError() != ERROR_NO_MORE_FILES )
-            result = EnumFilesResult::PartialSuccess;
-
-        FindClose(hFind);
-        return result;
+    std::ostream & pass()
+    {
+        ++passCount;
+        return output << "PASS - ";
     }
-    return EnumFilesResult::Failure;
-}
 
-struct PlaceTerrainOp {
-    size_t terrainType;
-    size_t x; // x is a tileCoord/2, only even x-coords are valid on even y coords, only odd x-coords are valid on odd y-coords
-    size_t y;
-    size_t brushSize = 1;
+    std::ostream & fail()
+    {
+        ++failCount;
+        return output << "FAIL - ";
+    }
 };
 
-// This is unnecessary overhead and isom editing should be built into a map object in a real impl, but the hard separation helps demo this separately
-ScMap copyToScMap(const MapFile & src)
+struct RegressionTest
 {
-    ScMap dest {};
-    dest.tileWidth = uint16_t(src.getTileWidth());
-    dest.tileHeight = uint16_t(src.getTileHeight());
-    dest.tileset = src.getTileset();
-    dest.isomRects.assign(src.isomRects.size(), {});
-    std::memcpy(&dest.isomRects[0], &src.isomRects[0], src.isomRects.size()*sizeof(Chk::IsomRect)); // ISOM
-    dest.editorTiles = src.editorTiles; // TILE
-    dest.tiles = src.tiles; // MTXM
-    return dest;
-}
+    std::string group; // e.g. "New map", results are totaled per group
+    std::string name;
+    std::function<void(TestResult &)> run;
+};
 
-void copyFromScMap(MapFile & dest, const ScMap & src)
+std::ostream & printRegions(std::ostream & out, const std::vector<Sc::BoundingBox> & regions)
 {
-    dest.dimensions.tileWidth = src.tileWidth;
-    dest.dimensions.tileHeight = src.tileHeight;
-    dest.tileset = src.tileset;
-    dest.isomRects.assign(src.isomRects.size(), {});
-    std::memcpy(&dest.isomRects[0], &src.isomRects[0], src.isomRects.size()*sizeof(Chk::IsomRect)); // ISOM
-    dest.editorTiles = src.editorTiles; // TILE
-    dest.tiles = src.tiles; // MTXM
-}
+    constexpr size_t maxPrintedRegions = 4;
+    for ( size_t i=0; i<regions.size() && i<maxPrintedRegions; ++i )
+        out << (i == 0 ? " at " : ", ") << "(" << regions[i].left << ", " << regions[i].top << ")-(" << regions[i].right << ", " << regions[i].bottom << ")";
 
-std::unique_ptr<MapFile> openMap(const std::string & mapFilePath)
-{
-    // Could alternatively use MapFile(MapFile::getDefaultOpenMapBrowser());
-    auto mapFile = std::make_unique<MapFile>(mapFilePath);
-    return mapFile && !mapFile->empty() ? std::move(mapFile) : nullptr;
+    return out << (regions.size() > maxPrintedRegions ? ", ..." : "");
 }
 
-std::unique_ptr<MapFile> newMap(Sc::Terrain::Tileset tileset, uint16_t width, uint16_t height, size_t terrainType)
+// ISOM must match exactly, TILE & MTXM are compared by tile group as subtiles are picked randomly
+void compareToGoldenMap(const std::string & testName, const MapFile & mapFile, const MapFile & comparison, TestResult & result)
 {
-    auto mapFile = std::make_unique<MapFile>(tileset, width, height);
-    ScMap scMap = copyToScMap(*mapFile);
-
-    Chk::IsomCache isomCache(tileset, width, height, terrainDat.get(tileset));
+    MapDiff diff = diffMaps(copyToScMap(mapFile), copyToScMap(comparison), true);
+    if ( diff.sizeMismatch )
+        throw std::logic_error("Section size mismatch");
 
-    uint16_t isomValue = ((isomCache.getTerrainTypeIsomValue(terrainType) << 4) | Chk::IsomRect::EditorFlag::Modified);
-    scMap.isomRects.assign(scMap.getIsomWidth()*scMap.getIsomHeight(), Chk::IsomRect{isomValue, isomValue, isomValue, isomValue});
-
-    isomCache.setAllChanged();
-    scMap.updateTilesFromIsom(isomCache);
-    
-    copyFromScMap(*mapFile, scMap);
-    return std::move(mapFile);
-}
-
-// isomX is a tileCoordinate/2, only even x-coordinates are valid on even y coordinates, only odd x-coordinates are valid on odd y-coordinates
-// isomBrush is one of the values from IsomBrush.h, e.g. Sc::Isom::Brush::Badlands::Dirt
-bool placeTerrain(MapFile & mapFile, size_t terrainType, size_t isomX, size_t isomY, size_t brushSize)
-{
-    ScMap scMap = copyToScMap(mapFile);
-    Chk::IsomCache isomCache(scMap.tileset, scMap.tileWidth, scMap.tileHeight, terrainDat.get(mapFile.tileset));
-    scMap.placeIsomTerrain({isomX, isomY}, terrainType, brushSize, isomCache);
-    scMap.updateTilesFromIsom(isomCache);
-    copyFromScMap(mapFile, scMap);
-    return true;
-}
-
-bool placeTerrain(MapFile & mapFile, const std::vector<PlaceTerrainOp> & ops)
-{
-    for ( const auto & op : ops )
-    {
-        if ( !placeTerrain(mapFile, op.terrainType, op.x, op.y, op.brushSize) )
-            return false;
-    }
-    return true;
-}
-
-void setMtxmOrTileDimensions(std::vector<u16> & tiles, u16 newTileWidth, u16 newTileHeight, u16 oldTileWidth, u16 oldTileHeight, s32 leftEdge, s32 topEdge);
-
-bool resizeMap(MapFile & mapFile, uint16_t newWidth, uint16_t newHeight, int xOffset, int yOffset, size_t terrainType)
-{
-    ScMap scMap = copyToScMap(mapFile);
-    ScMap destMap {};
-    destMap.tileset = scMap.tileset;
-    destMap.tileWidth = scMap.tileWidth;
-    destMap.tileHeight = scMap.tileHeight;
-    Chk::IsomCache destIsomCache(scMap.tileset, newWidth, newHeight, terrainDat.get(scMap.tileset));
-
-    destMap.editorTiles = scMap.editorTiles;
-    destMap.tiles = scMap.tiles;
-    setMtxmOrTileDimensions(destMap.tiles, newWidth, newHeight, (uint16_t)scMap.tileWidth, (uint16_t)scMap.tileHeight, 0, 0);
-    setMtxmOrTileDimensions(destMap.editorTiles, newWidth, newHeight, (uint16_t)scMap.tileWidth, (uint16_t)scMap.tileHeight, 0, 0);
-    uint16_t isomValue = ((destIsomCache.getTerrainTypeIsomValue(terrainType) << 4) | Chk::IsomRect::EditorFlag::Modified);
-
-    destMap.tileWidth = newWidth;
-    destMap.tileHeight = newHeight;
-    destMap.isomRects.assign((newWidth/2+1)*(newHeight+1), Chk::IsomRect{ isomValue, isomValue, isomValue, isomValue });
-    
-    destMap.copyIsomFrom(scMap, xOffset, yOffset, false, destIsomCache);
-    destMap.resizeIsom(xOffset, yOffset, scMap.tileWidth, scMap.tileHeight, false, destIsomCache);
-    destMap.updateTilesFromIsom(destIsomCache);
-
-    Sc::BoundingBox tileRect { scMap.tileWidth, scMap.tileHeight, newWidth, newHeight, xOffset, yOffset };
-    size_t destStartX = xOffset < 0 ? 0 : xOffset;
-    size_t destStartY = yOffset < 0 ? 0 : yOffset;
-    size_t copyHeight = tileRect.bottom-tileRect.top;
-    size_t copyWidth = tileRect.right-tileRect.left;
-    for ( size_t y=0; y<copyHeight; ++y )
-    {
-        for ( size_t x=0; x<copyWidth; ++x )
+    auto reportSection = [&](const char* sectionName, const MapDiff::Section & section) {
+        if ( section.identical() )
+            result.pass() << testName << " perfect " << sectionName << " - " << mapFile.getFileName() << " - " << comparison.getFileName() << std::endl;
+        else
         {
-            destMap.editorTiles[(y+destStartY)*newWidth+(x+destStartX)] = scMap.editorTiles[(y+tileRect.top)*scMap.tileWidth+(x+tileRect.left)];
-            destMap.tiles[(y+destStartY)*newWidth+(x+destStartX)] = scMap.tiles[(y+tileRect.top)*scMap.tileWidth+(x+tileRect.left)];
+            printRegions(result.fail() << testName << " " << sectionName << " mismatch - " << mapFile.getFileName() << " - " << comparison.getFileName()
+                << " - " << section.mismatches << " mismatches in " << section.regions.size() << " regions", section.regions) << std::endl;
         }
-    }
-
-    copyFromScMap(mapFile, destMap);
-    return true;
+    };
+    reportSection("ISOM", diff.isom);
+    reportSection("TILE", diff.editorTiles);
+    reportSection("MTXM", diff.tiles);
 }
 
 void resizeMapTest(const std::string & inputMap, const std::string & comparisonMap, uint16_t width, uint16_t height,
-    int xOffset, int yOffset, size_t terrainType, size_t & resizeMapTestPassCount, size_t & resizeMapTestFailCount)
+    int xOffset, int yOffset, size_t terrainType, TestResult & result)
 {
     if ( auto mapFile = openMap(inputMap) )
     {
-        resizeMap(*mapFile, width, height, xOffset, yOffset, terrainType);
+        resizeMap(terrainDat, *mapFile, width, height, xOffset, yOffset, terrainType);
         if ( auto comparison = openMap(comparisonMap) )
         {
-            if ( mapFile->isomRects.size() != comparison->isomRects.size() ||
-                mapFile->editorTiles.size() != comparison->editorTiles.size() ||
-                mapFile->tiles.size() != comparison->tiles.size() )
-            {
-                throw std::logic_error("Section size mismatch");
-            }
-
-            size_t isomMismatchCount = 0;
-            for ( size_t i=0; i<mapFile->isomRects.size(); ++i )
-            {
-                if ( mapFile->isomRects[i].left != comparison->isomRects[i].left )
-                    isomMismatchCount++;
-                if ( mapFile->isomRects[i].top != comparison->isomRects[i].top )
-                    isomMismatchCount++;
-                if ( mapFile->isomRects[i].right != comparison->isomRects[i].right )
-                    isomMismatchCount++;
-                if ( mapFile->isomRects[i].bottom != comparison->isomRects[i].bottom )
-                    isomMismatchCount++;
-            }
-            if ( isomMismatchCount == 0 )
-            {
-                std::cout << "PASS - Resize map perfect ISOM - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                resizeMapTestPassCount++;
-            }
-            else
-            {
-                std::cout << "FAIL - Resize map ISOM mismatch - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                resizeMapTestFailCount++;
-            }
-
-            size_t tileMismatchCount = 0;
-            for ( size_t i=0; i<mapFile->editorTiles.size(); ++i )
-            {
-                if ( Sc::Terrain::getTileGroup(mapFile->editorTiles[i]) != Sc::Terrain::getTileGroup(comparison->editorTiles[i]) )
-                    tileMismatchCount++;
-            }
-            if ( tileMismatchCount == 0 )
-            {
-                std::cout << "PASS - Resize map perfect TILE - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                resizeMapTestPassCount++;
-            }
-            else
-            {
-                std::cout << "FAIL - Resize map TILE mismatch - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                resizeMapTestFailCount++;
-            }
-
-            size_t mtxmMismatchCount = 0;
-            for ( size_t i=0; i<mapFile->tiles.size(); ++i )
-            {
-                if ( Sc::Terrain::getTileGroup(mapFile->tiles[i]) != Sc::Terrain::getTileGroup(comparison->tiles[i]) )
-                    mtxmMismatchCount++;
-            }
-            if ( mtxmMismatchCount == 0 )
-            {
-                std::cout << "PASS - Resize map perfect MTXM - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                resizeMapTestPassCount++;
-            }
-            else
-            {
-                std::cout << "FAIL - Resize map MTXM mismatch - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                resizeMapTestFailCount++;
-            }
+            compareToGoldenMap("Resize map", *mapFile, *comparison, result);
         }
         else
             throw std::logic_error("Failed to open comparison map");
@@ -252,77 +104,31 @@ void resizeMapTest(const std::string & inputMap, const std::string & comparisonM
         throw std::logic_error("Failed to open source map");
 }
 
-void editMapTest(const std::string & inputMap, const std::string & comparisonMap,
-    size_t & editMapTestPassCount, size_t & editMapTestFailCount, const std::vector<PlaceTerrainOp> & ops)
+void editMapTest(const std::string & inputMap, const std::string & comparisonMap, const std::vector<PlaceTerrainOp> & ops, TestResult & result)
 {
     if ( auto mapFile = openMap(inputMap) )
     {
-        placeTerrain(*mapFile, ops);
+        placeTerrain(terrainDat, *mapFile, ops);
         if ( auto comparison = openMap(comparisonMap) )
         {
-            if ( mapFile->isomRects.size() != comparison->isomRects.size() ||
-                mapFile->editorTiles.size() != comparison->editorTiles.size() ||
-                mapFile->tiles.size() != comparison->tiles.size() )
-            {
-                throw std::logic_error("Section size mismatch");
-            }
+            compareToGoldenMap("Edit map", *mapFile, *comparison, result);
 
-            size_t isomMismatchCount = 0;
-            for ( size_t i=0; i<mapFile->isomRects.size(); ++i )
-            {
-                if ( mapFile->isomRects[i].left != comparison->isomRects[i].left )
-                    isomMismatchCount++;
-                if ( mapFile->isomRects[i].top != comparison->isomRects[i].top )
-                    isomMismatchCount++;
-                if ( mapFile->isomRects[i].right != comparison->isomRects[i].right )
-                    isomMismatchCount++;
-                if ( mapFile->isomRects[i].bottom != comparison->isomRects[i].bottom )
-                    isomMismatchCount++;
-            }
-            if ( isomMismatchCount == 0 )
-            {
-                std::cout << "PASS - Edit map perfect ISOM - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                editMapTestPassCount++;
-            }
+            ScMap scMap = copyToScMap(*mapFile);
+            Chk::IsomCache isomCache(scMap.tileset, scMap.tileWidth, scMap.tileHeight, terrainDat.get(scMap.tileset));
+            auto validationReport = scMap.validateIsom(isomCache); // Serial, tests are already spread across the pool
+            if ( validationReport.isConsistent() )
+                result.pass() << "Edit map consistent ISOM - " << mapFile->getFileName() << std::endl;
             else
             {
-                std::cout << "FAIL - Edit map ISOM mismatch - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                editMapTestFailCount++;
+                result.fail() << "Edit map inconsistent ISOM - " << mapFile->getFileName() << " - " << validationReport.inconsistentDiamonds.size()
+                    << " diamonds in " << validationReport.inconsistentRegions.size() << " regions" << std::endl;
             }
 
-            size_t tileMismatchCount = 0;
-            for ( size_t i=0; i<mapFile->editorTiles.size(); ++i )
-            {
-                if ( Sc::Terrain::getTileGroup(mapFile->editorTiles[i]) != Sc::Terrain::getTileGroup(comparison->editorTiles[i]) )
-                    tileMismatchCount++;
-            }
-            if ( tileMismatchCount == 0 )
-            {
-                std::cout << "PASS - Edit map perfect TILE - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                editMapTestPassCount++;
-            }
-            else
-            {
-                std::cout << "FAIL - Edit map TILE mismatch - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                editMapTestFailCount++;
-            }
-
-            size_t mtxmMismatchCount = 0;
-            for ( size_t i=0; i<mapFile->tiles.size(); ++i )
-            {
-                if ( Sc::Terrain::getTileGroup(mapFile->tiles[i]) != Sc::Terrain::getTileGroup(comparison->tiles[i]) )
-                    mtxmMismatchCount++;
-            }
-            if ( mtxmMismatchCount == 0 )
-            {
-                std::cout << "PASS - Edit map perfect MTXM - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                editMapTestPassCount++;
-            }
+            auto inexactDiamonds = scMap.reconstructIsomFromTiles(isomCache);
+            if ( inexactDiamonds && *inexactDiamonds == 0 && scMap.validateIsom(isomCache).isConsistent() )
+                result.pass() << "Edit map ISOM reconstructed from TILE - " << mapFile->getFileName() << std::endl;
             else
-            {
-                std::cout << "FAIL - Edit map MTXM mismatch - " << mapFile->getFileName() << " - " << comparison->getFileName() << std::endl;
-                editMapTestFailCount++;
-            }
+                result.fail() << "Edit map ISOM reconstruction from TILE - " << mapFile->getFileName() << std::endl;
 
             //if ( comparisonMap.find("ScatterTest.scm") != std::string::npos ) // TODO: Temp
             //    mapFile->save(std::string("C:\\Users\\Justin\\Desktop\\output.scm"), true);
@@ -334,22 +140,42 @@ void editMapTest(const std::string & inputMap, const std::string & comparisonMap
         throw std::logic_error("Failed to open edit source map");
 }
 
-std::string getTestMapDirectory()
+void addResizeMapTest(std::vector<RegressionTest> & tests, const std::filesystem::path & inputMap, const std::filesystem::path & comparisonMap,
+    uint16_t width, uint16_t height, int xOffset, int yOffset, size_t terrainType)
 {
-    std::string directory = *getModuleDirectory();
-    if ( isDirectory(makeSystemFilePath(directory, "Map Testing Pack")) )
-        directory = makeSystemFilePath(directory, "Map Testing Pack");
-    else if ( isDirectory(makeSystemFilePath(getSystemFileDirectory(directory), "Map Testing Pack")) )
-        directory = makeSystemFilePath(getSystemFileDirectory(directory), "Map Testing Pack");
-    else if ( isDirectory(makeSystemFilePath(getSystemFileDirectory(getSystemFileDirectory(directory, false)), "Map Testing Pack")) )
-        directory = makeSystemFilePath(getSystemFileDirectory(getSystemFileDirectory(directory, false)), "Map Testing Pack");
-    else
-        throw std::logic_error("Could not find test map directory.");
+    tests.push_back({"Resize map", comparisonMap.filename().string(), [=](TestResult & result) {
+        resizeMapTest(inputMap.string(), comparisonMap.string(), width, height, xOffset, yOffset, terrainType, result);
+    }});
+}
 
-    return directory;
+void addEditMapTest(std::vector<RegressionTest> & tests, const std::filesystem::path & inputMap, const std::filesystem::path & comparisonMap,
+    const std::vector<PlaceTerrainOp> & ops)
+{
+    tests.push_back({"Edit map", (comparisonMap.parent_path().filename() / comparisonMap.filename()).generic_string(), [=](TestResult & result) {
+        editMapTest(inputMap.string(), comparisonMap.string(), ops, result);
+    }});
 }
 
-void runNewMapTests(const std::string & mapDir, size_t & newMapTestPassCount, size_t & newMapTestFailCount)
+std::filesystem::path getTestMapDirectory()
+{
+    std::vector<std::filesystem::path> searchRoots {};
+    if ( auto moduleDirectory = getModuleDirectory() )
+        searchRoots.push_back(std::filesystem::u8path(*moduleDirectory));
+
+    searchRoots.push_back(std::filesystem::current_path());
+    for ( const auto & searchRoot : searchRoots )
+    {
+        auto directory = searchRoot;
+        for ( size_t i=0; i<3 && !directory.empty(); ++i, directory = directory.parent_path() ) // Check the directory and its parent & grandparent
+        {
+            if ( std::filesystem::is_directory(directory / "Map Testing Pack") )
+                return directory / "Map Testing Pack";
+        }
+    }
+    throw std::logic_error("Could not find test map directory.");
+}
+
+void addNewMapTests(const std::filesystem::path & mapDir, std::vector<RegressionTest> & tests)
 {
     std::unordered_map<std::string, Sc::Terrain::Tileset> directoryToTileset {
         {"Badlands", Sc::Terrain::Tileset::Badlands},
@@ -375,23 +201,32 @@ void runNewMapTests(const std::string & mapDir, size_t & newMapTestPassCount, si
             tilesetToBrushNameToTerrainType.find(tilesetIndex)->second.insert(std::make_pair(brush.name, brush.index));
     }
 
-    EnumDirectoryFiles(makeSystemFilePath(mapDir, "Clean New Maps"), [&](auto filePath) {
-        auto fileName = ::getSystemFileName(filePath);
+    std::vector<std::filesystem::path> filePaths {};
+    for ( const auto & entry : std::filesystem::recursive_directory_iterator(mapDir / "Clean New Maps") )
+    {
+        if ( entry.is_regular_file() )
+            filePaths.push_back(entry.path());
+    }
+    std::sort(filePaths.begin(), filePaths.end()); // Directory iteration order is unspecified, keep test order stable
+
+    for ( const auto & path : filePaths )
+    {
+        std::string filePath = path.string();
+        auto fileName = path.filename().string();
         auto extensionStart = fileName.find(".");
         if ( extensionStart == std::string::npos )
         {
             logger.error() << "No extension on filePath: " << filePath << std::endl;
-            return;
+            continue;
         }
         auto brushName = fileName.substr(0, extensionStart);
 
-        auto fileDirectory = ::getSystemFileDirectory(filePath, false);
-        auto containingDirectoryName = ::getSystemFileName(fileDirectory);
+        auto containingDirectoryName = path.parent_path().filename().string();
         auto foundTileset = directoryToTileset.find(containingDirectoryName);
         if ( foundTileset == directoryToTileset.end() )
         {
             logger.error() << "Error on filePath: " << filePath << std::endl;
-            return;
+            continue;
         }
         Sc::Terrain::Tileset tileset = foundTileset->second;
         auto & brushNameToBrush = tilesetToBrushNameToTerrainType.find(tileset)->second;
@@ -399,180 +234,157 @@ void runNewMapTests(const std::string & mapDir, size_t & newMapTestPassCount, si
         if ( foundBrush == brushNameToBrush.end() )
         {
             logger.error() << "Error finding brush on filePath: " << filePath << std::endl;
-            return;
+            continue;
         }
         auto brush = foundBrush->second;
-        
-        std::map<uint16_t, size_t> isomValueCount {};
-        std::map<uint16_t, size_t> tileGroupCount {};
-        std::map<uint16_t, size_t> mtxmGroupCount {};
-        if ( auto examine = openMap(filePath) )
-        {
-            for ( auto & isomRect : examine->isomRects )
-            {
-                isomValueCount[isomRect.left]++;
-                isomValueCount[isomRect.top]++;
-                isomValueCount[isomRect.right]++;
-                isomValueCount[isomRect.bottom]++;
-            }
-            for ( auto tile : examine->editorTiles )
-                tileGroupCount[Sc::Terrain::getTileGroup(tile)]++;
-            for ( auto tile : examine->tiles )
-                mtxmGroupCount[Sc::Terrain::getTileGroup(tile)]++;
-        }
 
-        uint16_t mostPresentIsom = 0;
-        for ( auto & count : isomValueCount )
-        {
-            if ( count.second > 100 )
-            {
-                if ( mostPresentIsom != 0 )
-                    throw std::logic_error("Multiple ISOM values highly present in source map");
-                else
-                    mostPresentIsom = count.first;
-            }
-        }
-        uint16_t mostPresentEditorTileGroup = 0;
-        uint16_t otherMostPresentEditorTileGroup = 0;
-        for ( auto & count : tileGroupCount )
-        {
-            if ( count.second > 100 )
-            {
-                if ( mostPresentEditorTileGroup == 0 )
-                    mostPresentEditorTileGroup = count.first;
-                else if ( otherMostPresentEditorTileGroup == 0 )
-                    otherMostPresentEditorTileGroup = count.first;
-                else
-                    throw std::logic_error("More than 2 TILE values highly present in source map");
-            }
-        }
-        uint16_t mostPresentTileGroup = 0;
-        uint16_t otherMostPresentTileGroup = 0;
-        for ( auto & count : mtxmGroupCount )
-        {
-            if ( count.second > 100 )
-            {
-                if ( mostPresentTileGroup == 0 )
-                    mostPresentTileGroup = count.first;
-                else if ( otherMostPresentTileGroup == 0 )
-                    otherMostPresentTileGroup = count.first;
-                else
-                    throw std::logic_error("More than 2 TILE values highly present in source map");
-            }
-        }
-        
-        size_t isomMismatchCount = 0;
-        size_t tileMismatchCount = 0;
-        size_t mtxmMismatchCount = 0;
-        if ( auto mapFile = newMap(tileset, 128, 128, brush) )
-        {
-            for ( auto & isomRect : mapFile->isomRects )
-            {
-                if ( isomRect.left != mostPresentIsom )
-                    isomMismatchCount ++;
-                if ( isomRect.top != mostPresentIsom )
-                    isomMismatchCount ++;
-                if ( isomRect.right != mostPresentIsom )
-                    isomMismatchCount ++;
-                if ( isomRect.bottom != mostPresentIsom )
-                    isomMismatchCount ++;
-            }
-            if ( isomMismatchCount == 0 )
-            {
-                std::cout << "PASS - New map perfect ISOM - " << containingDirectoryName << " - " << brushName << std::endl;
-                newMapTestPassCount++;
-            }
-            else
+        tests.push_back({"New map", containingDirectoryName + " - " + brushName, [=](TestResult & result) {
+            std::map<uint16_t, size_t> isomValueCount {};
+            std::map<uint16_t, size_t> tileGroupCount {};
+            std::map<uint16_t, size_t> mtxmGroupCount {};
+            if ( auto examine = openMap(filePath) )
             {
-                std::cout << "FAIL - New map ISOM mismatch - " << containingDirectoryName << " - " << brushName << std::endl;
-                newMapTestFailCount++;
+                for ( auto & isomRect : examine->isomRects )
+                {
+                    isomValueCount[isomRect.left]++;
+                    isomValueCount[isomRect.top]++;
+                    isomValueCount[isomRect.right]++;
+                    isomValueCount[isomRect.bottom]++;
+                }
+                for ( auto tile : examine->editorTiles )
+                    tileGroupCount[Sc::Terrain::getTileGroup(tile)]++;
+                for ( auto tile : examine->tiles )
+                    mtxmGroupCount[Sc::Terrain::getTileGroup(tile)]++;
             }
 
-            for ( auto tile : mapFile->editorTiles )
+            uint16_t mostPresentIsom = 0;
+            for ( auto & count : isomValueCount )
             {
-                auto group = Sc::Terrain::getTileGroup(tile);
-                if ( tile == 0 || (group != mostPresentEditorTileGroup && group != otherMostPresentEditorTileGroup) )
-                    tileMismatchCount++;
+                if ( count.second > 100 )
+                {
+                    if ( mostPresentIsom != 0 )
+                        throw std::logic_error("Multiple ISOM values highly present in source map");
+                    else
+                        mostPresentIsom = count.first;
+                }
             }
-            if ( tileMismatchCount == 0 )
+            uint16_t mostPresentEditorTileGroup = 0;
+            uint16_t otherMostPresentEditorTileGroup = 0;
+            for ( auto & count : tileGroupCount )
             {
-                std::cout << "PASS - New map perfect TILE - " << containingDirectoryName << " - " << brushName << std::endl;
-                newMapTestPassCount++;
+                if ( count.second > 100 )
+                {
+                    if ( mostPresentEditorTileGroup == 0 )
+                        mostPresentEditorTileGroup = count.first;
+                    else if ( otherMostPresentEditorTileGroup == 0 )
+                        otherMostPresentEditorTileGroup = count.first;
+                    else
+                        throw std::logic_error("More than 2 TILE values highly present in source map");
+                }
             }
-            else
+            uint16_t mostPresentTileGroup = 0;
+            uint16_t otherMostPresentTileGroup = 0;
+            for ( auto & count : mtxmGroupCount )
             {
-                std::cout << "FAIL - New map TILE mismatch - " << containingDirectoryName << " - " << brushName << std::endl;
-                newMapTestFailCount++;
+                if ( count.second > 100 )
+                {
+                    if ( mostPresentTileGroup == 0 )
+                        mostPresentTileGroup = count.first;
+                    else if ( otherMostPresentTileGroup == 0 )
+                        otherMostPresentTileGroup = count.first;
+                    else
+                        throw std::logic_error("More than 2 TILE values highly present in source map");
+                }
             }
 
-            for ( auto tile : mapFile->tiles )
-            {
-                auto group = Sc::Terrain::getTileGroup(tile);
-                if ( tile == 0 || (group != mostPresentTileGroup && group != otherMostPresentTileGroup) )
-                    mtxmMismatchCount++;
-            }
-            if ( mtxmMismatchCount == 0 )
+            size_t isomMismatchCount = 0;
+            size_t tileMismatchCount = 0;
+            size_t mtxmMismatchCount = 0;
+            if ( auto mapFile = newMap(terrainDat, tileset, 128, 128, brush) )
             {
-                std::cout << "PASS - New map perfect MTXM - " << containingDirectoryName << " - " << brushName << std::endl;
-                newMapTestPassCount++;
+                for ( auto & isomRect : mapFile->isomRects )
+                {
+                    if ( isomRect.left != mostPresentIsom )
+                        isomMismatchCount ++;
+                    if ( isomRect.top != mostPresentIsom )
+                        isomMismatchCount ++;
+                    if ( isomRect.right != mostPresentIsom )
+                        isomMismatchCount ++;
+                    if ( isomRect.bottom != mostPresentIsom )
+                        isomMismatchCount ++;
+                }
+                if ( isomMismatchCount == 0 )
+                    result.pass() << "New map perfect ISOM - " << containingDirectoryName << " - " << brushName << std::endl;
+                else
+                    result.fail() << "New map ISOM mismatch - " << containingDirectoryName << " - " << brushName << std::endl;
+
+                for ( auto tile : mapFile->editorTiles )
+                {
+                    auto group = Sc::Terrain::getTileGroup(tile);
+                    if ( tile == 0 || (group != mostPresentEditorTileGroup && group != otherMostPresentEditorTileGroup) )
+                        tileMismatchCount++;
+                }
+                if ( tileMismatchCount == 0 )
+                    result.pass() << "New map perfect TILE - " << containingDirectoryName << " - " << brushName << std::endl;
+                else
+                    result.fail() << "New map TILE mismatch - " << containingDirectoryName << " - " << brushName << std::endl;
+
+                for ( auto tile : mapFile->tiles )
+                {
+                    auto group = Sc::Terrain::getTileGroup(tile);
+                    if ( tile == 0 || (group != mostPresentTileGroup && group != otherMostPresentTileGroup) )
+                        mtxmMismatchCount++;
+                }
+                if ( mtxmMismatchCount == 0 )
+                    result.pass() << "New map perfect MTXM - " << containingDirectoryName << " - " << brushName << std::endl;
+                else
+                    result.fail() << "New map MTXM mismatch - " << containingDirectoryName << " - " << brushName << std::endl;
             }
             else
-            {
-                std::cout << "FAIL - New map MTXM mismatch - " << containingDirectoryName << " - " << brushName << std::endl;
-                newMapTestFailCount++;
-            }
-        }
-        else
-        {
-            std::cout << "FAIL - New map creation error - " << containingDirectoryName << " - " << brushName << std::endl;
-            newMapTestFailCount++;
-        }
-    });
-    
-    std::cout << "-----------------------------------------------------------------------" << std::endl;
+                result.fail() << "New map creation error - " << containingDirectoryName << " - " << brushName << std::endl;
+        }});
+    }
 }
 
-void runResizeMapTests(const std::string & mapDir, size_t & resizeMapTestPassCount, size_t & resizeMapTestFailCount)
+void addResizeMapTests(const std::filesystem::path & mapDir, std::vector<RegressionTest> & tests)
 {
-    resizeMapTest(mapDir + "\\Resize Source Maps\\dirt.scm",
-        mapDir + "\\ScmDraft Resized Maps\\dirtToGrass64.scm",
-        64, 64, 0, 0, Sc::Isom::Brush::Badlands::Grass, resizeMapTestPassCount, resizeMapTestFailCount);
-    resizeMapTest(mapDir + "\\Resize Source Maps\\dirt.scm",
-        mapDir + "\\ScmDraft Resized Maps\\dirtToGrass256.scm",
-        256, 256, 0, 0, Sc::Isom::Brush::Badlands::Grass, resizeMapTestPassCount, resizeMapTestFailCount);
-    resizeMapTest(mapDir + "\\Resize Source Maps\\dirt.scm",
-        mapDir + "\\ScmDraft Resized Maps\\dirtToGrass256_p12_p9.scm",
-        256, 256, 12, 9, Sc::Isom::Brush::Badlands::Grass, resizeMapTestPassCount, resizeMapTestFailCount);
-    resizeMapTest(mapDir + "\\Resize Source Maps\\dirt.scm",
-        mapDir + "\\ScmDraft Resized Maps\\dirtToGrass256_p12_m9.scm",
-        256, 256, 12, -9, Sc::Isom::Brush::Badlands::Grass, resizeMapTestPassCount, resizeMapTestFailCount);
-    resizeMapTest(mapDir + "\\Resize Source Maps\\dirt.scm",
-        mapDir + "\\ScmDraft Resized Maps\\dirtToGrass256_m12_p9.scm",
-        256, 256, -12, 9, Sc::Isom::Brush::Badlands::Grass, resizeMapTestPassCount, resizeMapTestFailCount);
-    resizeMapTest(mapDir + "\\Resize Source Maps\\dirt.scm",
-        mapDir + "\\ScmDraft Resized Maps\\dirtToGrass256_m12_m9.scm",
-        256, 256, -12, -9, Sc::Isom::Brush::Badlands::Grass, resizeMapTestPassCount, resizeMapTestFailCount);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "dirt.scm",
+        mapDir / "ScmDraft Resized Maps" / "dirtToGrass64.scm",
+        64, 64, 0, 0, Sc::Isom::Brush::Badlands::Grass);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "dirt.scm",
+        mapDir / "ScmDraft Resized Maps" / "dirtToGrass256.scm",
+        256, 256, 0, 0, Sc::Isom::Brush::Badlands::Grass);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "dirt.scm",
+        mapDir / "ScmDraft Resized Maps" / "dirtToGrass256_p12_p9.scm",
+        256, 256, 12, 9, Sc::Isom::Brush::Badlands::Grass);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "dirt.scm",
+        mapDir / "ScmDraft Resized Maps" / "dirtToGrass256_p12_m9.scm",
+        256, 256, 12, -9, Sc::Isom::Brush::Badlands::Grass);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "dirt.scm",
+        mapDir / "ScmDraft Resized Maps" / "dirtToGrass256_m12_p9.scm",
+        256, 256, -12, 9, Sc::Isom::Brush::Badlands::Grass);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "dirt.scm",
+        mapDir / "ScmDraft Resized Maps" / "dirtToGrass256_m12_m9.scm",
+        256, 256, -12, -9, Sc::Isom::Brush::Badlands::Grass);
     
-    resizeMapTest(mapDir + "\\Resize Source Maps\\Helms Deep Annatar East 8.7.scx",
-        mapDir + "\\ScmDraft Resized Maps\\hde64.scm",
-        64, 64, 0, 0, Sc::Isom::Brush::Jungle::Water, resizeMapTestPassCount, resizeMapTestFailCount);
-    resizeMapTest(mapDir + "\\Resize Source Maps\\Helms Deep Annatar East 8.7.scx",
-        mapDir + "\\ScmDraft Resized Maps\\hde256.scm",
-        256, 256, 0, 0, Sc::Isom::Brush::Jungle::Water, resizeMapTestPassCount, resizeMapTestFailCount);
-    resizeMapTest(mapDir + "\\Resize Source Maps\\Helms Deep Annatar East 8.7.scx",
-        mapDir + "\\ScmDraft Resized Maps\\hde256_p12_p9.scm",
-        256, 256, 12, 9, Sc::Isom::Brush::Jungle::Water, resizeMapTestPassCount, resizeMapTestFailCount);
-    resizeMapTest(mapDir + "\\Resize Source Maps\\Helms Deep Annatar East 8.7.scx",
-        mapDir + "\\ScmDraft Resized Maps\\hde256_m12_m9.scm",
-        256, 256, -12, -9, Sc::Isom::Brush::Jungle::Water, resizeMapTestPassCount, resizeMapTestFailCount);
-
-    std::cout << "-----------------------------------------------------------------------" << std::endl;
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "Helms Deep Annatar East 8.7.scx",
+        mapDir / "ScmDraft Resized Maps" / "hde64.scm",
+        64, 64, 0, 0, Sc::Isom::Brush::Jungle::Water);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "Helms Deep Annatar East 8.7.scx",
+        mapDir / "ScmDraft Resized Maps" / "hde256.scm",
+        256, 256, 0, 0, Sc::Isom::Brush::Jungle::Water);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "Helms Deep Annatar East 8.7.scx",
+        mapDir / "ScmDraft Resized Maps" / "hde256_p12_p9.scm",
+        256, 256, 12, 9, Sc::Isom::Brush::Jungle::Water);
+    addResizeMapTest(tests, mapDir / "Resize Source Maps" / "Helms Deep Annatar East 8.7.scx",
+        mapDir / "ScmDraft Resized Maps" / "hde256_m12_m9.scm",
+        256, 256, -12, -9, Sc::Isom::Brush::Jungle::Water);
 }
 
-void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount, size_t & editMapTestFailCount)
+void addEditMapTests(const std::filesystem::path & mapDir, std::vector<RegressionTest> & tests)
 {
-    editMapTest(mapDir + "\\Edit Source Maps\\Jungle.scm",
-        mapDir + "\\ScmDraft Edited Maps\\LimitTest.scm", editMapTestPassCount, editMapTestFailCount,
+    addEditMapTest(tests, mapDir / "Edit Source Maps" / "Jungle.scm",
+        mapDir / "ScmDraft Edited Maps" / "LimitTest.scm",
         {
             {Sc::Isom::Brush::Jungle::HighTemple, 0, 0},
             {Sc::Isom::Brush::Jungle::HighTemple, 128, 0},
@@ -580,8 +392,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Jungle::HighTemple, 128, 256}
         });
     
-    editMapTest(mapDir + "\\Edit Source Maps\\Jungle.scm",
-        mapDir + "\\ScmDraft Edited Maps\\ScatterTest.scm", editMapTestPassCount, editMapTestFailCount,
+    addEditMapTest(tests, mapDir / "Edit Source Maps" / "Jungle.scm",
+        mapDir / "ScmDraft Edited Maps" / "ScatterTest.scm",
         {
             {Sc::Isom::Brush::Jungle::HighTemple, 64, 128, 10},
             {Sc::Isom::Brush::Jungle::HighRaisedJungle, 67, 121, 1},
@@ -598,8 +410,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Jungle::Water, 77, 133, 1}
         });
 
-    editMapTest(mapDir + "\\Clean New Maps\\Badlands\\Dirt.scm",
-        mapDir + "\\ScmDraft Edited Maps\\Badlands\\Dirt.scm", editMapTestPassCount, editMapTestFailCount, {
+    addEditMapTest(tests, mapDir / "Clean New Maps" / "Badlands" / "Dirt.scm",
+        mapDir / "ScmDraft Edited Maps" / "Badlands" / "Dirt.scm", {
             {Sc::Isom::Brush::Badlands::Dirt, 8, 16, 1},
             {Sc::Isom::Brush::Badlands::Dirt, 16, 16, 2},
             {Sc::Isom::Brush::Badlands::Dirt, 24, 16, 3},
@@ -629,8 +441,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Badlands::RockyGround, 48, 32, 3},
         });
 
-    editMapTest(mapDir + "\\Clean New Maps\\Space\\Space.scm",
-        mapDir + "\\ScmDraft Edited Maps\\Space\\Space.scm", editMapTestPassCount, editMapTestFailCount, {
+    addEditMapTest(tests, mapDir / "Clean New Maps" / "Space" / "Space.scm",
+        mapDir / "ScmDraft Edited Maps" / "Space" / "Space.scm", {
             {Sc::Isom::Brush::Space::Space_, 8, 16, 1},
             {Sc::Isom::Brush::Space::Space_, 16, 16, 2},
             {Sc::Isom::Brush::Space::Space_, 24, 16, 3},
@@ -663,8 +475,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Space::ElevatedCatwalk, 56, 48, 3},
         });
 
-    editMapTest(mapDir + "\\Clean New Maps\\Installation\\Substructure.scm",
-        mapDir + "\\ScmDraft Edited Maps\\Installation\\Substructure.scm", editMapTestPassCount, editMapTestFailCount, {
+    addEditMapTest(tests, mapDir / "Clean New Maps" / "Installation" / "Substructure.scm",
+        mapDir / "ScmDraft Edited Maps" / "Installation" / "Substructure.scm", {
             {Sc::Isom::Brush::Installation::Substructure, 8, 16, 1},
             {Sc::Isom::Brush::Installation::Substructure, 16, 16, 2},
             {Sc::Isom::Brush::Installation::Substructure, 24, 16, 3},
@@ -688,8 +500,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Installation::BottomlessPit, 24, 112, 3}
         });
 
-    editMapTest(mapDir + "\\Clean New Maps\\Ashworld\\Magma.scm",
-        mapDir + "\\ScmDraft Edited Maps\\Ashworld\\Magma.scm", editMapTestPassCount, editMapTestFailCount, {
+    addEditMapTest(tests, mapDir / "Clean New Maps" / "Ashworld" / "Magma.scm",
+        mapDir / "ScmDraft Edited Maps" / "Ashworld" / "Magma.scm", {
             {Sc::Isom::Brush::Ashworld::Magma, 8, 16, 1},
             {Sc::Isom::Brush::Ashworld::Magma, 16, 16, 2},
             {Sc::Isom::Brush::Ashworld::Magma, 24, 16, 3},
@@ -716,8 +528,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Ashworld::HighShale, 56, 16, 3},
         });
 
-    editMapTest(mapDir + "\\Clean New Maps\\Jungle\\Water.scm",
-        mapDir + "\\ScmDraft Edited Maps\\Jungle\\Water.scm", editMapTestPassCount, editMapTestFailCount, {
+    addEditMapTest(tests, mapDir / "Clean New Maps" / "Jungle" / "Water.scm",
+        mapDir / "ScmDraft Edited Maps" / "Jungle" / "Water.scm", {
             {Sc::Isom::Brush::Jungle::Water, 8, 16, 1},
             {Sc::Isom::Brush::Jungle::Water, 16, 16, 2},
             {Sc::Isom::Brush::Jungle::Water, 24, 16, 3},
@@ -759,8 +571,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Jungle::HighTemple, 56, 96, 3},
         });
 
-    editMapTest(mapDir + "\\Clean New Maps\\Desert\\Tar.scx",
-        mapDir + "\\ScmDraft Edited Maps\\Desert\\Tar.scx", editMapTestPassCount, editMapTestFailCount, {
+    addEditMapTest(tests, mapDir / "Clean New Maps" / "Desert" / "Tar.scx",
+        mapDir / "ScmDraft Edited Maps" / "Desert" / "Tar.scx", {
             {Sc::Isom::Brush::Desert::Tar, 8, 16, 1},
             {Sc::Isom::Brush::Desert::Tar, 16, 16, 2},
             {Sc::Isom::Brush::Desert::Tar, 24, 16, 3},
@@ -802,8 +614,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Desert::HighCompound, 56, 96, 3},
         });
 
-    editMapTest(mapDir + "\\Clean New Maps\\Arctic\\Ice.scx",
-        mapDir + "\\ScmDraft Edited Maps\\Arctic\\Ice.scx", editMapTestPassCount, editMapTestFailCount, {
+    addEditMapTest(tests, mapDir / "Clean New Maps" / "Arctic" / "Ice.scx",
+        mapDir / "ScmDraft Edited Maps" / "Arctic" / "Ice.scx", {
             {Sc::Isom::Brush::Arctic::Ice, 8, 16, 1},
             {Sc::Isom::Brush::Arctic::Ice, 16, 16, 2},
             {Sc::Isom::Brush::Arctic::Ice, 24, 16, 3},
@@ -845,8 +657,8 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Arctic::HighOutpost, 56, 96, 3},
         });
 
-    editMapTest(mapDir + "\\Clean New Maps\\Twilight\\Water.scx",
-        mapDir + "\\ScmDraft Edited Maps\\Twilight\\Water.scx", editMapTestPassCount, editMapTestFailCount, {
+    addEditMapTest(tests, mapDir / "Clean New Maps" / "Twilight" / "Water.scx",
+        mapDir / "ScmDraft Edited Maps" / "Twilight" / "Water.scx", {
             {Sc::Isom::Brush::Twilight::Water, 8, 16, 1},
             {Sc::Isom::Brush::Twilight::Water, 16, 16, 2},
             {Sc::Isom::Brush::Twilight::Water, 24, 16, 3},
@@ -887,227 +699,1114 @@ void runEditMapTests(const std::string & mapDir, size_t & editMapTestPassCount,
             {Sc::Isom::Brush::Twilight::HighBasilica, 48, 96, 2},
             {Sc::Isom::Brush::Twilight::HighBasilica, 56, 96, 3},
         });
+}
 
-    std::cout << "-----------------------------------------------------------------------" << std::endl;
+ScMap newFixtureMap(Sc::Terrain::Tileset tileset, uint16_t mapSize, size_t terrainType, Chk::IsomCache & cache)
+{
+    ScMap scMap {};
+    scMap.tileWidth = mapSize;
+    scMap.tileHeight = mapSize;
+    scMap.tileset = tileset;
+    scMap.tiles.assign(size_t(mapSize)*size_t(mapSize), 0);
+    scMap.editorTiles.assign(size_t(mapSize)*size_t(mapSize), 0);
+    uint16_t isomValue = ((cache.getTerrainTypeIsomValue(terrainType) << 4) | Chk::IsomRect::EditorFlag::Modified);
+    scMap.isomRects.assign(scMap.getIsomWidth()*scMap.getIsomHeight(), Chk::IsomRect{isomValue, isomValue, isomValue, isomValue});
+    cache.setAllChanged();
+    scMap.updateTilesFromIsom(cache);
+    return scMap;
 }
 
-void runTests()
+// Applies the same pseudo-random brush strokes for a given seed, used to compare maps edited concurrently against maps edited serially
+ScMap editFixtureMap(size_t tilesetIndex, const Sc::Terrain_::Tiles & tiles, uint32_t seed)
 {
-    size_t newMapTestPassCount = 0;
-    size_t newMapTestFailCount = 0;
-    size_t resizeMapTestPassCount = 0;
-    size_t resizeMapTestFailCount = 0;
-    size_t editMapTestPassCount = 0;
-    size_t editMapTestFailCount = 0;
-    auto mapDir = getTestMapDirectory();
-    runNewMapTests(mapDir, newMapTestPassCount, newMapTestFailCount);
-    runResizeMapTests(mapDir, resizeMapTestPassCount, resizeMapTestFailCount);
-    runEditMapTests(mapDir, editMapTestPassCount, editMapTestFailCount);
-    
-    size_t totalNewMapTests = newMapTestPassCount + newMapTestFailCount;
-    if ( newMapTestFailCount == 0 )
-        std::cout << "PASS - New map tests - " << newMapTestPassCount << " / " << totalNewMapTests << std::endl;
-    else
-        std::cout << "FAIL - New map tests - " << newMapTestPassCount << " / " << totalNewMapTests << std::endl;
+    constexpr uint16_t mapSize = 128;
+    constexpr size_t totalEdits = 200;
+    Sc::Terrain::Tileset tileset = Sc::Terrain::Tileset(tilesetIndex);
+    Chk::IsomCache cache(tileset, mapSize, mapSize, tiles); // Each map gets its own cache, only the tiles are shared
+    cache.seedSubtiles(seed);
+    ScMap scMap = newFixtureMap(tileset, mapSize, size_t(tiles.defaultBrush.index), cache);
+
+    std::mt19937 random(seed);
+    for ( size_t i=0; i<totalEdits; ++i )
+    {
+        size_t y = random() % scMap.getIsomHeight();
+        size_t x = random() % scMap.getIsomWidth();
+        if ( (x+y)%2 != 0 ) // Only diamonds with an even x+y are valid
+            x = x > 0 ? x-1 : x+1;
+
+        size_t terrainType = size_t(tiles.brushes[random() % tiles.brushes.size()].index);
+        scMap.placeIsomTerrain({x, y}, terrainType, 1 + random() % 6, cache);
+        scMap.updateTilesFromIsom(cache);
+    }
+    return scMap;
+}
 
-    size_t totalResizeMapTests = resizeMapTestPassCount + resizeMapTestFailCount;
-    if ( resizeMapTestFailCount == 0 )
-        std::cout << "PASS - Resize map tests - " << resizeMapTestPassCount << " / " << totalResizeMapTests << std::endl;
-    else
-        std::cout << "FAIL - Resize map tests - " << resizeMapTestPassCount << " / " << totalResizeMapTests << std::endl;
+// Edits one map per thread with every thread sharing the same read-only tiles, the results must match editing the same maps one at a time
+// Runs on the fixture tilesets so it doesn't depend on a StarCraft install
+void concurrentEditTest()
+{
+    std::vector<Sc::Terrain_::Tiles> fixtureTiles {};
+    for ( size_t tilesetIndex=0; tilesetIndex<TestData::totalFixtureTilesets; ++tilesetIndex )
+        fixtureTiles.push_back(TestData::makeFixtureTiles(tilesetIndex));
+
+    const std::vector<Sc::Terrain_::Tiles> & sharedTiles = fixtureTiles;
+    size_t totalMaps = std::max(size_t(4), size_t(std::thread::hardware_concurrency()));
+    auto editMap = [&](size_t i) {
+        return editFixtureMap(i % sharedTiles.size(), sharedTiles[i % sharedTiles.size()], uint32_t(0x3600 + i));
+    };
 
-    size_t totalEditMapTests = editMapTestPassCount + editMapTestFailCount;
-    if ( editMapTestFailCount == 0 )
-        std::cout << "PASS - Edit map tests - " << editMapTestPassCount << " / " << totalEditMapTests << std::endl;
-    else
-        std::cout << "FAIL - Edit map tests - " << editMapTestPassCount << " / " << totalEditMapTests << std::endl;
+    std::vector<ScMap> serialMaps {};
+    for ( size_t i=0; i<totalMaps; ++i )
+        serialMaps.push_back(editMap(i));
+
+    std::vector<ScMap> concurrentMaps(totalMaps);
+    std::vector<std::thread> threads {};
+    for ( size_t i=0; i<totalMaps; ++i )
+        threads.emplace_back([&, i]() { concurrentMaps[i] = editMap(i); });
+
+    for ( auto & thread : threads )
+        thread.join();
+
+    size_t failCount = 0;
+    for ( size_t i=0; i<totalMaps; ++i )
+    {
+        if ( !diffMaps(concurrentMaps[i], serialMaps[i]).identical() )
+        {
+            ++failCount;
+            std::cout << "FAIL - Concurrent edit test - map " << i << " (" << TestData::fixtureTilesetNames[i % sharedTiles.size()]
+                << ") differs from the same map edited serially" << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Concurrent edit tests - " << (totalMaps - failCount) << " / " << totalMaps
+        << " maps edited on " << totalMaps << " threads" << std::endl;
 }
 
-namespace TestData
+// Logs whole lines from many threads through a logger & its aggregator, half as messages & half stream-style with a filtered debug line between each,
+// then checks every line came out intact in both streams & no debug line came out
+void concurrentLogTest()
 {
-    inline constexpr uint16_t badlandsIsomLinks[] {
-        0,0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,1,1,1,1,3,4,4,2,4,4,2,4,4,2,4,4,2,5,5,5,3,5,5,3,5,5,3,5,5,3,6,2,2,5,2,2,5,2,2,5,2,2,5,14,10,10,9,10,10,
-        9,10,10,9,10,10,9,15,11,11,10,11,11,10,11,11,10,11,11,10,7,3,3,6,3,3,6,3,3,6,3,3,6,18,14,14,7,14,14,7,14,14,7,14,14,7,4,15,15,4,15,15,4,15,15,4,15,
-        15,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,34,1,1,1,1,51,255,51,51,2,1,51,255,34,1,49,257,1,1,1,49,1,257,
-        49,49,2,34,52,52,2,52,30,256,30,30,1,52,30,256,34,50,31,258,50,50,2,31,50,258,31,31,1,34,1,1,1,1,1,1,49,1,257,1,51,255,34,1,54,257,1,1,1,1,1,1,54,
-        33,256,34,50,31,258,52,30,256,30,30,1,31,31,1,34,1,1,1,1,53,255,32,53,258,1,1,1,34,50,31,258,56,56,2,56,56,2,31,51,255,34,55,55,2,52,30,256,49,30,
-        257,55,55,2,34,1,49,257,1,51,255,51,51,2,49,49,2,34,52,52,2,50,50,2,31,50,258,52,30,256,34,50,31,258,52,30,256,49,30,257,31,51,255,34,1,54,257,1,
-        53,255,32,53,258,54,33,256,35,5,5,3,5,51,255,51,51,1,5,51,255,35,5,49,257,5,5,3,49,5,257,49,49,1,35,52,52,1,52,34,256,34,34,3,52,34,256,35,50,35,
-        258,50,50,1,35,50,258,35,35,3,35,5,5,3,5,5,3,49,5,257,5,51,255,35,5,54,257,5,5,3,5,5,3,54,37,256,35,50,35,258,52,34,256,34,34,3,35,35,3,35,5,5,3,5,
-        53,255,36,53,258,5,5,3,35,50,35,258,56,56,1,56,56,1,35,51,255,35,55,55,1,52,34,256,49,34,257,55,55,1,35,5,49,257,5,51,255,51,51,1,49,49,1,35,52,52,
-        1,50,50,1,35,50,258,52,34,256,35,50,35,258,52,34,256,49,34,257,35,51,255,35,5,54,257,5,53,255,36,53,258,54,37,256,20,1,1,1,1,51,255,51,51,5,1,51,
-        255,20,1,49,257,1,1,1,49,1,257,49,49,5,20,52,52,5,52,1,256,1,1,1,52,1,256,20,50,1,258,50,50,5,1,50,258,1,1,1,20,1,1,1,1,1,1,49,1,257,1,51,255,20,1,
-        54,257,1,1,1,1,1,1,54,1,256,20,50,1,258,52,1,256,1,1,1,1,1,1,20,1,1,1,1,53,255,1,53,258,1,1,1,20,50,1,258,56,56,5,56,56,5,1,51,255,20,55,55,5,52,1,
-        256,49,1,257,55,55,5,20,1,49,257,1,51,255,51,51,5,49,49,5,20,52,52,5,50,50,5,1,50,258,52,1,256,20,50,1,258,52,1,256,49,1,257,1,51,255,20,1,54,257,
-        1,53,255,1,53,258,54,1,256,28,1,1,1,1,51,255,51,51,10,1,51,255,28,1,49,257,1,1,1,49,1,257,49,49,10,28,52,52,10,52,1,256,1,1,1,52,1,256,28,50,1,258,
-        50,50,10,1,50,258,1,1,1,28,1,1,1,1,1,1,49,1,257,1,51,255,28,1,54,257,1,1,1,1,1,1,54,1,256,28,50,1,258,52,1,256,1,1,1,1,1,1,28,1,1,1,1,53,255,1,53,
-        258,1,1,1,28,50,1,258,11,11,10,11,11,10,1,51,255,28,11,11,10,52,1,256,49,1,257,11,11,10,28,1,49,257,1,51,255,51,51,10,49,49,10,28,52,52,10,50,50,
-        10,1,50,258,52,1,256,28,50,1,258,52,1,256,49,1,257,1,51,255,28,1,54,257,1,53,255,1,53,258,54,1,256,21,4,4,2,4,51,255,51,51,6,4,51,255,21,4,49,257,
-        4,4,2,49,4,257,49,49,6,21,52,52,6,52,4,256,4,4,2,52,4,256,21,50,4,258,50,50,6,4,50,258,4,4,2,21,4,4,2,4,4,2,49,4,257,4,51,255,21,4,54,257,4,4,2,4,
-        4,2,54,4,256,21,50,4,258,52,4,256,4,4,2,4,4,2,21,4,4,2,4,53,255,4,53,258,4,4,2,21,50,4,258,56,56,6,56,56,6,4,51,255,21,55,55,6,52,4,256,49,4,257,
-        55,55,6,21,4,49,257,4,51,255,51,51,6,49,49,6,21,52,52,6,50,50,6,4,50,258,52,4,256,21,50,4,258,52,4,256,49,4,257,4,51,255,21,4,54,257,4,53,255,4,53,
-        258,54,4,256,27,1,1,1,1,51,255,51,51,9,1,51,255,27,1,49,257,1,1,1,49,1,257,49,49,9,27,52,52,9,52,1,256,1,1,1,52,1,256,27,50,1,258,50,50,9,1,50,258,
-        1,1,1,27,1,1,1,1,1,1,49,1,257,1,51,255,27,1,54,257,1,1,1,1,1,1,54,1,256,27,50,1,258,52,1,256,1,1,1,1,1,1,27,1,1,1,1,53,255,1,53,258,1,1,1,27,50,1,
-        258,56,56,9,56,56,9,1,51,255,27,55,55,9,52,1,256,49,1,257,55,55,9,27,1,49,257,1,51,255,51,51,9,49,49,9,27,52,52,9,50,50,9,1,50,258,52,1,256,27,50,
-        1,258,52,1,256,49,1,257,1,51,255,27,1,54,257,1,53,255,1,53,258,54,1,256,31,10,10,9,10,51,255,51,51,7,10,51,255,31,10,49,257,10,10,9,49,10,257,49,
-        49,7,31,52,52,7,52,26,256,26,26,9,52,26,256,31,50,27,258,50,50,7,27,50,258,27,27,9,31,10,10,9,10,10,9,49,10,257,10,51,255,31,10,54,257,10,10,9,10,
-        10,9,54,29,256,31,50,27,258,52,26,256,26,26,9,27,27,9,31,10,10,9,10,53,255,28,53,258,10,10,9,31,50,27,258,56,56,7,56,56,7,27,51,255,31,55,55,7,52,
-        26,256,49,26,257,55,55,7,31,10,49,257,10,51,255,51,51,7,49,49,7,31,52,52,7,50,50,7,27,50,258,52,26,256,31,50,27,258,52,26,256,49,26,257,27,51,255,
-        31,10,54,257,10,53,255,28,53,258,54,29,256,22,1,1,1,1,51,255,51,51,4,1,51,255,22,1,49,257,1,1,1,49,1,257,49,49,4,22,52,52,4,52,1,256,1,1,1,52,1,
-        256,22,50,1,258,50,50,4,1,50,258,1,1,1,22,1,1,1,1,1,1,49,1,257,1,51,255,22,1,54,257,1,1,1,1,1,1,54,1,256,22,50,1,258,52,1,256,1,1,1,1,1,1,22,1,1,1,
-        1,53,255,1,53,258,1,1,1,22,50,1,258,56,56,4,56,56,4,1,51,255,22,55,55,4,52,1,256,49,1,257,55,55,4,22,1,49,257,1,51,255,51,51,4,49,49,4,22,52,52,4,
-        50,50,4,1,50,258,52,1,256,22,50,1,258,52,1,256,49,1,257,1,51,255,22,1,54,257,1,53,255,1,53,258,54,1,256
+    size_t totalThreads = std::max(size_t(8), size_t(std::thread::hardware_concurrency()));
+    constexpr size_t linesPerThread = 2000;
+    std::shared_ptr<std::stringstream> aggregatorOutput = std::make_shared<std::stringstream>();
+    std::shared_ptr<std::stringstream> loggerOutput = std::make_shared<std::stringstream>();
+    std::shared_ptr<Logger> aggregator = std::make_shared<Logger>(aggregatorOutput, LogLevel::Info);
+    Logger threadLogger(loggerOutput, aggregator, LogLevel::Info);
+
+    std::vector<std::thread> threads {};
+    for ( size_t i=0; i<totalThreads; ++i )
+    {
+        threads.emplace_back([&, i]() {
+            for ( size_t line=0; line<linesPerThread; ++line )
+            {
+                if ( i%2 == 0 )
+                    threadLogger.info("thread " + std::to_string(i) + " line " + std::to_string(line));
+                else
+                {
+                    threadLogger.info() << "thread " << i << " line " << line << std::endl;
+                    threadLogger.debug() << "thread " << i << " debug line " << line << std::endl;
+                }
+            }
+        });
+    }
+    for ( auto & thread : threads )
+        thread.join();
+
+    size_t debugLines = 0;
+    auto countIntactLines = [&](std::stringstream & output) {
+        std::vector<size_t> linesByThread(totalThreads, 0);
+        std::string line {};
+        while ( std::getline(output, line) )
+        {
+            if ( line.find("debug line") != std::string::npos )
+                ++debugLines;
+
+            size_t thread = 0, lineNumber = 0;
+            size_t messageStart = line.find(" INFO: thread ");
+            if ( messageStart != std::string::npos &&
+                std::sscanf(line.c_str() + messageStart, " INFO: thread %zu line %zu", &thread, &lineNumber) == 2 && thread < totalThreads &&
+                line.substr(messageStart) == " INFO: thread " + std::to_string(thread) + " line " + std::to_string(lineNumber) )
+            {
+                ++linesByThread[thread];
+            }
+        }
+        return size_t(std::count(linesByThread.begin(), linesByThread.end(), linesPerThread));
     };
+    size_t loggerThreadsIntact = countIntactLines(*loggerOutput);
+    size_t aggregatorThreadsIntact = countIntactLines(*aggregatorOutput);
+    std::cout << (loggerThreadsIntact == totalThreads && aggregatorThreadsIntact == totalThreads && debugLines == 0 ? "PASS - " : "FAIL - ")
+        << "Concurrent log tests - " << loggerThreadsIntact << " / " << totalThreads << " threads logged intact, "
+        << aggregatorThreadsIntact << " / " << totalThreads << " aggregated intact, " << debugLines << " debug lines logged" << std::endl;
+}
 
-    inline constexpr uint16_t spaceIsomLinks[] {
-        0,0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,1,1,1,1,3,2,2,3,2,2,3,2,2,3,2,2,3,0,0,0,0,0,0,0,0,0,0,0,0,0,5,4,4,5,4,4,5,4,4,5,4,4,5,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,6,6,7,6,6,7,6,6,7,6,6,7,8,13,13,8,13,13,8,13,13,8,13,13,8,9,18,18,9,18,18,9,18,18,
-        9,18,18,9,4,3,3,4,3,3,4,3,3,4,3,3,4,6,5,5,6,5,5,6,5,5,6,5,5,6,10,8,8,10,8,8,10,8,8,10,8,8,10,11,7,7,2,7,7,2,7,7,2,7,7,2,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,1,1,1,1,51,255,51,51,3,1,51,255,20,1,49,257,1,1,1,49,1,257,49,49,3,20,52,52,3,52,
-        23,256,23,23,1,52,23,256,20,50,24,258,50,50,3,24,50,258,24,24,1,20,1,1,1,1,1,1,49,1,257,1,51,255,20,1,54,257,1,1,1,1,1,1,54,26,256,20,50,24,258,52,
-        23,256,23,23,1,24,24,1,20,1,1,1,1,53,255,25,53,258,1,1,1,20,50,24,258,56,56,3,56,56,3,24,51,255,20,55,55,3,52,23,256,49,23,257,55,55,3,20,1,49,257,
-        1,51,255,51,51,3,49,49,3,20,52,52,3,50,50,3,24,50,258,52,23,256,20,50,24,258,52,23,256,49,23,257,24,51,255,20,1,54,257,1,53,255,25,53,258,54,26,
-        256,21,2,2,3,2,51,255,51,51,5,2,51,255,21,2,49,257,2,2,3,49,2,257,49,49,5,21,52,52,5,52,27,256,27,27,3,52,27,256,21,50,28,258,50,50,5,28,50,258,28,
-        28,3,21,2,2,3,2,2,3,49,2,257,2,51,255,21,2,54,257,2,2,3,2,2,3,54,30,256,21,50,28,258,52,27,256,27,27,3,28,28,3,21,2,2,3,2,53,255,29,53,258,2,2,3,
-        21,50,28,258,56,56,5,56,56,5,28,51,255,21,55,55,5,52,27,256,49,27,257,55,55,5,21,2,49,257,2,51,255,51,51,5,49,49,5,21,52,52,5,50,50,5,28,50,258,52,
-        27,256,21,50,28,258,52,27,256,49,27,257,28,51,255,21,2,54,257,2,53,255,29,53,258,54,30,256,16,2,2,3,2,51,255,51,51,7,2,51,255,16,2,49,257,2,2,3,49,
-        2,257,49,49,7,16,52,52,7,52,2,256,2,2,3,52,2,256,16,50,2,258,50,50,7,2,50,258,2,2,3,16,2,2,3,2,2,3,49,2,257,2,51,255,16,2,54,257,2,2,3,2,2,3,54,2,
-        256,16,50,2,258,52,2,256,2,2,3,2,2,3,16,2,2,3,2,53,255,2,53,258,2,2,3,16,50,2,258,56,56,7,56,56,7,2,51,255,16,55,55,7,52,2,256,49,2,257,55,55,7,16,
-        2,49,257,2,51,255,51,51,7,49,49,7,16,52,52,7,50,50,7,2,50,258,52,2,256,16,50,2,258,52,2,256,49,2,257,2,51,255,16,2,54,257,2,53,255,2,53,258,54,2,
-        256,17,13,13,8,13,51,255,51,51,3,13,51,255,17,13,49,257,13,13,8,49,13,257,49,49,3,17,52,52,3,52,14,256,14,14,8,52,14,256,17,50,15,258,50,50,3,15,
-        50,258,15,15,8,17,13,13,8,13,13,8,49,13,257,13,51,255,17,13,54,257,13,13,8,13,13,8,54,17,256,17,50,15,258,52,14,256,14,14,8,15,15,8,17,13,13,8,13,
-        53,255,16,53,258,13,13,8,17,50,15,258,56,56,3,56,56,3,15,51,255,17,55,55,3,52,14,256,49,14,257,55,55,3,17,13,49,257,13,51,255,51,51,3,49,49,3,17,
-        52,52,3,50,50,3,15,50,258,52,14,256,17,50,15,258,52,14,256,49,14,257,15,51,255,17,13,54,257,13,53,255,16,53,258,54,17,256,18,18,18,9,18,51,255,51,
-        51,3,18,51,255,18,18,49,257,18,18,9,49,18,257,49,49,3,18,52,52,3,52,19,256,19,19,9,52,19,256,18,50,20,258,50,50,3,20,50,258,20,20,9,18,18,18,9,18,
-        18,9,49,18,257,18,51,255,18,18,54,257,18,18,9,18,18,9,54,22,256,18,50,20,258,52,19,256,19,19,9,20,20,9,18,18,18,9,18,53,255,21,53,258,18,18,9,18,
-        50,20,258,56,56,3,56,56,3,20,51,255,18,55,55,3,52,19,256,49,19,257,55,55,3,18,18,49,257,18,51,255,51,51,3,49,49,3,18,52,52,3,50,50,3,20,50,258,52,
-        19,256,18,50,20,258,52,19,256,49,19,257,20,51,255,18,18,54,257,18,53,255,21,53,258,54,22,256,14,2,2,3,2,51,255,51,51,4,2,51,255,14,2,49,257,2,2,3,
-        49,2,257,49,49,4,14,52,52,4,52,2,256,2,2,3,52,2,256,14,50,2,258,50,50,4,2,50,258,2,2,3,14,2,2,3,2,2,3,49,2,257,2,51,255,14,2,54,257,2,2,3,2,2,3,54,
-        2,256,14,50,2,258,52,2,256,2,2,3,2,2,3,14,2,2,3,2,53,255,2,53,258,2,2,3,14,50,2,258,56,56,4,56,56,4,2,51,255,14,55,55,4,52,2,256,49,2,257,55,55,4,
-        14,2,49,257,2,51,255,51,51,4,49,49,4,14,52,52,4,50,50,4,2,50,258,52,2,256,14,50,2,258,52,2,256,49,2,257,2,51,255,14,2,54,257,2,53,255,2,53,258,54,
-        2,256,15,4,4,5,4,51,255,51,51,6,4,51,255,15,4,49,257,4,4,5,49,4,257,49,49,6,15,52,52,6,52,4,256,4,4,5,52,4,256,15,50,4,258,50,50,6,4,50,258,4,4,5,
-        15,4,4,5,4,4,5,49,4,257,4,51,255,15,4,54,257,4,4,5,4,4,5,54,4,256,15,50,4,258,52,4,256,4,4,5,4,4,5,15,4,4,5,4,53,255,4,53,258,4,4,5,15,50,4,258,56,
-        56,6,56,56,6,4,51,255,15,55,55,6,52,4,256,49,4,257,55,55,6,15,4,49,257,4,51,255,51,51,6,49,49,6,15,52,52,6,50,50,6,4,50,258,52,4,256,15,50,4,258,
-        52,4,256,49,4,257,4,51,255,15,4,54,257,4,53,255,4,53,258,54,4,256,19,2,2,3,2,51,255,51,51,10,2,51,255,19,2,49,257,2,2,3,49,2,257,49,49,10,19,52,52,
-        10,52,9,256,9,9,3,52,9,256,19,50,10,258,50,50,10,10,50,258,10,10,3,19,2,2,3,2,2,3,49,2,257,2,51,255,19,2,54,257,2,2,3,2,2,3,54,12,256,19,50,10,258,
-        52,9,256,9,9,3,10,10,3,19,2,2,3,2,53,255,11,53,258,2,2,3,19,50,10,258,56,56,10,56,56,10,10,51,255,19,55,55,10,52,9,256,49,9,257,55,55,10,19,2,49,
-        257,2,51,255,51,51,10,49,49,10,19,52,52,10,50,50,10,10,50,258,52,9,256,19,50,10,258,52,9,256,49,9,257,10,51,255,19,2,54,257,2,53,255,11,53,258,54,
-        12,256,13,2,2,3,2,51,255,51,51,2,2,51,255,13,2,49,257,2,2,3,49,2,257,49,49,2,13,52,52,2,52,2,256,2,2,3,52,2,256,13,50,2,258,50,50,2,2,50,258,2,2,3,
-        13,2,2,3,2,2,3,49,2,257,2,51,255,13,2,54,257,2,2,3,2,2,3,54,2,256,13,50,2,258,52,2,256,2,2,3,2,2,3,13,2,2,3,2,53,255,2,53,258,2,2,3,13,50,2,258,56,
-        56,2,56,56,2,2,51,255,13,55,55,2,52,2,256,49,2,257,55,55,2,13,2,49,257,2,51,255,51,51,2,49,49,2,13,52,52,2,50,50,2,2,50,258,52,2,256,13,50,2,258,
-        52,2,256,49,2,257,2,51,255,13,2,54,257,2,53,255,2,53,258,54,2,256
-    };
+// Runs a test's checks on each fixture tileset & prints the PASS/FAIL summary, the checks print their own FAIL line & return false when a tileset fails
+template <typename Checks>
+void forEachFixtureTileset(const std::string & name, const std::string & summary, Checks && checks)
+{
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<TestData::totalFixtureTilesets; ++tilesetIndex )
+    {
+        if ( !checks(tilesetIndex) )
+            ++failCount;
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << name << " - " << (TestData::totalFixtureTilesets - failCount) << " / "
+        << TestData::totalFixtureTilesets << " " << summary << std::endl;
+}
 
-    inline constexpr uint16_t installationIsomLinks[] {
-        0,0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,1,1,1,1,3,2,2,2,2,2,2,2,2,2,2,2,2,6,3,3,3,3,3,3,3,3,3,3,3,3,4,4,4,4,4,4,4,4,4,4,4,4,4,5,5,5,5,5,5,5,5,
-        5,5,5,5,5,8,7,7,6,7,7,6,7,7,6,7,7,6,7,6,6,7,6,6,7,6,6,7,6,6,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,12,1,1,1,1,
-        51,255,51,51,2,1,51,255,12,1,49,257,1,1,1,49,1,257,49,49,2,12,52,52,2,52,8,256,8,8,1,52,8,256,12,50,9,258,50,50,2,9,50,258,9,9,1,12,1,1,1,1,1,1,49,
-        1,257,1,51,255,12,1,54,257,1,1,1,1,1,1,54,11,256,12,50,9,258,52,8,256,8,8,1,9,9,1,12,1,1,1,1,53,255,10,53,258,1,1,1,12,50,9,258,56,56,2,56,56,2,9,
-        51,255,12,55,55,2,52,8,256,49,8,257,55,55,2,12,1,49,257,1,51,255,51,51,2,49,49,2,12,52,52,2,50,50,2,9,50,258,52,8,256,12,50,9,258,52,8,256,49,8,
-        257,9,51,255,12,1,54,257,1,53,255,10,53,258,54,11,256,13,2,2,2,2,51,255,51,51,3,2,51,255,13,2,49,257,2,2,2,49,2,257,49,49,3,13,52,52,3,52,12,256,
-        12,12,2,52,12,256,13,50,13,258,50,50,3,13,50,258,13,13,2,13,2,2,2,2,2,2,49,2,257,2,51,255,13,2,54,257,2,2,2,2,2,2,54,15,256,13,50,13,258,52,12,256,
-        12,12,2,13,13,2,13,2,2,2,2,53,255,14,53,258,2,2,2,13,50,13,258,56,56,3,56,56,3,13,51,255,13,55,55,3,52,12,256,49,12,257,55,55,3,13,2,49,257,2,51,
-        255,51,51,3,49,49,3,13,52,52,3,50,50,3,13,50,258,52,12,256,13,50,13,258,52,12,256,49,12,257,13,51,255,13,2,54,257,2,53,255,14,53,258,54,15,256,10,
-        1,1,1,1,51,255,51,51,4,1,51,255,10,1,49,257,1,1,1,49,1,257,49,49,4,10,52,52,4,52,1,256,1,1,1,52,1,256,10,50,1,258,50,50,4,1,50,258,1,1,1,10,1,1,1,
-        1,1,1,49,1,257,1,51,255,10,1,54,257,1,1,1,1,1,1,54,1,256,10,50,1,258,52,1,256,1,1,1,1,1,1,10,1,1,1,1,53,255,1,53,258,1,1,1,10,50,1,258,56,56,4,56,
-        56,4,1,51,255,10,55,55,4,52,1,256,49,1,257,55,55,4,10,1,49,257,1,51,255,51,51,4,49,49,4,10,52,52,4,50,50,4,1,50,258,52,1,256,10,50,1,258,52,1,256,
-        49,1,257,1,51,255,10,1,54,257,1,53,255,1,53,258,54,1,256,11,2,2,2,2,51,255,51,51,5,2,51,255,11,2,49,257,2,2,2,49,2,257,49,49,5,11,52,52,5,52,2,256,
-        2,2,2,52,2,256,11,50,2,258,50,50,5,2,50,258,2,2,2,11,2,2,2,2,2,2,49,2,257,2,51,255,11,2,54,257,2,2,2,2,2,2,54,2,256,11,50,2,258,52,2,256,2,2,2,2,2,
-        2,11,2,2,2,2,53,255,2,53,258,2,2,2,11,50,2,258,56,56,5,56,56,5,2,51,255,11,55,55,5,52,2,256,49,2,257,55,55,5,11,2,49,257,2,51,255,51,51,5,49,49,5,
-        11,52,52,5,50,50,5,2,50,258,52,2,256,11,50,2,258,52,2,256,49,2,257,2,51,255,11,2,54,257,2,53,255,2,53,258,54,2,256,14,1,1,1,1,51,255,51,51,6,1,51,
-        255,14,1,49,257,1,1,1,49,1,257,49,49,6,14,52,52,6,52,1,256,1,1,1,52,1,256,14,50,1,258,50,50,6,1,50,258,1,1,1,14,1,1,1,1,1,1,49,1,257,1,51,255,14,1,
-        54,257,1,1,1,1,1,1,54,1,256,14,50,1,258,52,1,256,1,1,1,1,1,1,14,1,1,1,1,53,255,1,53,258,1,1,1,14,50,1,258,56,56,6,56,56,6,1,51,255,14,55,55,6,52,1,
-        256,49,1,257,55,55,6,14,1,49,257,1,51,255,51,51,6,49,49,6,14,52,52,6,50,50,6,1,50,258,52,1,256,14,50,1,258,52,1,256,49,1,257,1,51,255,14,1,54,257,
-        1,53,255,1,53,258,54,1,256,15,6,6,7,6,51,255,51,51,1,6,51,255,15,6,49,257,6,6,7,49,6,257,49,49,1,15,52,52,1,52,16,256,16,16,7,52,16,256,15,50,17,
-        258,50,50,1,17,50,258,17,17,7,15,6,6,7,6,6,7,49,6,257,6,51,255,15,6,54,257,6,6,7,6,6,7,54,19,256,15,50,17,258,52,16,256,16,16,7,17,17,7,15,6,6,7,6,
-        53,255,18,53,258,6,6,7,15,50,17,258,56,56,1,56,56,1,17,51,255,15,55,55,1,52,16,256,49,16,257,55,55,1,15,6,49,257,6,51,255,51,51,1,49,49,1,15,52,52,
-        1,50,50,1,17,50,258,52,16,256,15,50,17,258,52,16,256,49,16,257,17,51,255,15,6,54,257,6,53,255,18,53,258,54,19,256
+// Records a session of brushes, flood fills, a paste & a resize made the way an editor would (undoable, tiles updated after every op), then checks that
+// replaying the journal against the same base map reproduces the session's ISOM exactly & its tiles by tile group
+void journalReplayTest()
+{
+    constexpr uint16_t mapSize = 64;
+    constexpr uint32_t seed = 0x4000;
+    forEachFixtureTileset("Journal replay tests", "tilesets replayed", [&](size_t tilesetIndex) {
+        Sc::Terrain::Tileset tileset = Sc::Terrain::Tileset(tilesetIndex);
+        Sc::Terrain_::Tiles tiles = TestData::makeFixtureTiles(tilesetIndex);
+        Chk::IsomCache baseCache(tileset, mapSize, mapSize, tiles);
+        const ScMap baseMap = newFixtureMap(tileset, mapSize, size_t(tiles.defaultBrush.index), baseCache);
+
+        ScMap session = baseMap;
+        auto cache = std::make_unique<Chk::IsomCache>(tileset, mapSize, mapSize, tiles);
+        cache->seedSubtiles(seed);
+        IsomJournal journal(tileset, mapSize, mapSize, seed);
+        cache->recorder = &journal; // Places, flood fills & pastes are recorded by the edits themselves
+        size_t totalOperations = 0;
+        std::mt19937 random(seed + uint32_t(tilesetIndex));
+        auto randomDiamond = [&]() {
+            size_t y = random() % session.getIsomHeight();
+            size_t x = random() % session.getIsomWidth();
+            return Chk::IsomDiamond{(x+y)%2 == 0 ? x : (x > 0 ? x-1 : x+1), y};
+        };
+        auto randomTerrainType = [&]() { return size_t(tiles.brushes[random() % tiles.brushes.size()].index); };
+
+        for ( size_t stroke=0; stroke<30; ++stroke ) // Each stroke is a batch, e.g. mouse down, a few brushes as the mouse moves, then mouse up
+        {
+            if ( stroke == 10 )
+            {
+                auto stamp = session.captureIsomStamp({2, 2}, 8, 6);
+                Chk::IsomDiamond topLeft {20, 20};
+                if ( stamp )
+                {
+                    session.placeIsomStamp(*stamp, topLeft, *cache);
+                    session.updateTilesFromIsom(*cache);
+                    ++totalOperations;
+                }
+            }
+            else if ( stroke == 20 )
+            {
+                size_t terrainType = randomTerrainType();
+                session = resizeScMap(tiles, session, mapSize+16, mapSize-8, 4, -2, terrainType);
+                journal.recordResize(mapSize+16, mapSize-8, 4, -2, terrainType);
+                cache = std::make_unique<Chk::IsomCache>(tileset, session.tileWidth, session.tileHeight, tiles);
+                cache->seedSubtiles(seed);
+                cache->recorder = &journal;
+                ++totalOperations;
+            }
+            else if ( stroke % 7 == 6 )
+            {
+                Chk::IsomDiamond isomDiamond = randomDiamond();
+                size_t terrainType = randomTerrainType();
+                session.floodFillIsomTerrain(isomDiamond, terrainType, *cache);
+                session.updateTilesFromIsom(*cache);
+                ++totalOperations;
+            }
+            else
+            {
+                size_t terrainType = randomTerrainType();
+                size_t brushSize = 1 + random() % 4;
+                for ( size_t i=0; i<5; ++i )
+                {
+                    Chk::IsomDiamond isomDiamond = randomDiamond();
+                    session.placeIsomTerrain(isomDiamond, terrainType, brushSize, *cache);
+                    session.updateTilesFromIsom(*cache);
+                    ++totalOperations;
+                }
+            }
+            cache->finalizeUndoableOperation();
+            journal.recordEndBatch();
+        }
+
+        auto loadedJournal = IsomJournal::fromBytes(journal.getBytes());
+        ScMap replayed = baseMap;
+        auto replayResult = loadedJournal ? loadedJournal->replay(replayed, tiles) : IsomJournal::ReplayResult{};
+        MapDiff diff = diffMaps(session, replayed, true);
+        if ( !replayResult.success || !diff.identical() || replayResult.operations != totalOperations )
+        {
+            std::cout << "FAIL - Journal replay test - " << TestData::fixtureTilesetNames[tilesetIndex] << " - " << replayResult.error
+                << " " << replayResult.operations << " / " << totalOperations << " operations replayed,"
+                << (diff.sizeMismatch ? " size mismatch" : "") << " " << diff.isom.mismatches << " ISOM, " << diff.editorTiles.mismatches << " TILE & "
+                << diff.tiles.mismatches << " MTXM mismatches" << std::endl;
+            return false;
+        }
+        return true;
+    });
+}
+
+// Clears the ISOM section of brushed fixture maps & rebuilds it from TILE, serially & on the thread pool, the isomValues of every diamond whose quadrants
+// all have tiles must match the original (diamonds along the map edges are partly off the tiles & new maps have no edge flags, so neither is compared)
+void reconstructIsomTest()
+{
+    auto countMismatchedDiamonds = [](const ScMap & map, const ScMap & original) {
+        auto hasTiles = [&](Chk::IsomRect::Point rectCoords) { return rectCoords.x < original.getIsomWidth()-1 && rectCoords.y < original.getIsomHeight()-1; };
+        auto isomValue = [](const ScMap & scMap, Chk::IsomRect::Point rectCoords, Sc::Isom::Side side) {
+            return scMap.isomRects[rectCoords.y*scMap.getIsomWidth() + rectCoords.x].getIsomValue(side) >> 4;
+        };
+        size_t mismatchedDiamonds = 0;
+        for ( size_t y=0; y<original.getIsomHeight(); ++y )
+        {
+            for ( size_t x=y%2; x<original.getIsomWidth(); x+=2 )
+            {
+                Chk::IsomDiamond isomDiamond {x, y};
+                bool covered = true;
+                bool matches = true;
+                for ( auto quadrant : Sc::Isom::quadrants )
+                {
+                    Sc::Isom::ProjectedQuadrant projectedQuadrant {quadrant};
+                    Chk::IsomRect::Point rectCoords = isomDiamond.getRectangleCoords(quadrant);
+                    covered = covered && hasTiles(rectCoords);
+                    matches = matches && covered && isomValue(map, rectCoords, projectedQuadrant.firstSide) == isomValue(original, rectCoords, projectedQuadrant.firstSide) &&
+                        isomValue(map, rectCoords, projectedQuadrant.secondSide) == isomValue(original, rectCoords, projectedQuadrant.secondSide);
+                }
+                if ( covered && !matches )
+                    ++mismatchedDiamonds;
+            }
+        }
+        return mismatchedDiamonds;
     };
 
-    inline constexpr uint16_t ashworldIsomLinks[] {
-        0,0,0,0,0,0,0,0,0,0,0,0,0,8,7,7,1,7,7,1,7,7,1,7,7,1,2,1,1,2,1,1,2,1,1,2,1,1,2,3,2,2,3,2,2,3,2,2,3,2,2,3,6,5,5,4,5,5,4,5,5,4,5,5,4,4,3,3,5,3,3,5,3,
-        3,5,3,3,5,5,4,4,6,4,4,6,4,4,6,4,4,6,7,6,6,7,6,6,7,6,6,7,6,6,7,9,8,8,8,8,8,8,8,8,8,8,8,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,17,7,7,1,7,51,255,51,51,2,7,
-        51,255,17,7,49,257,7,7,1,49,7,257,49,49,2,17,52,52,2,52,9,256,9,9,1,52,9,256,17,50,10,258,50,50,2,10,50,258,10,10,1,17,7,7,1,7,7,1,49,7,257,7,51,
-        255,17,7,54,257,7,7,1,7,7,1,54,12,256,17,50,10,258,52,9,256,9,9,1,10,10,1,17,7,7,1,7,53,255,11,53,258,7,7,1,17,50,10,258,56,56,2,56,56,2,10,51,255,
-        17,55,55,2,52,9,256,49,9,257,55,55,2,17,7,49,257,7,51,255,51,51,2,49,49,2,17,52,52,2,50,50,2,10,50,258,52,9,256,17,50,10,258,52,9,256,49,9,257,10,
-        51,255,17,7,54,257,7,53,255,11,53,258,54,12,256,16,1,1,2,1,51,255,51,51,5,1,51,255,16,1,49,257,1,1,2,49,1,257,49,49,5,16,52,52,5,52,13,256,13,13,2,
-        52,13,256,16,50,14,258,50,50,5,14,50,258,14,14,2,16,1,1,2,1,1,2,49,1,257,1,51,255,16,1,54,257,1,1,2,1,1,2,54,16,256,16,50,14,258,52,13,256,13,13,2,
-        14,14,2,16,1,1,2,1,53,255,15,53,258,1,1,2,16,50,14,258,56,56,5,56,56,5,14,51,255,16,55,55,5,52,13,256,49,13,257,55,55,5,16,1,49,257,1,51,255,51,51,
-        5,49,49,5,16,52,52,5,50,50,5,14,50,258,52,13,256,16,50,14,258,52,13,256,49,13,257,14,51,255,16,1,54,257,1,53,255,15,53,258,54,16,256,11,1,1,2,1,51,
-        255,51,51,3,1,51,255,11,1,49,257,1,1,2,49,1,257,49,49,3,11,52,52,3,52,1,256,1,1,2,52,1,256,11,50,1,258,50,50,3,1,50,258,1,1,2,11,1,1,2,1,1,2,49,1,
-        257,1,51,255,11,1,54,257,1,1,2,1,1,2,54,1,256,11,50,1,258,52,1,256,1,1,2,1,1,2,11,1,1,2,1,53,255,1,53,258,1,1,2,11,50,1,258,56,56,3,56,56,3,1,51,
-        255,11,55,55,3,52,1,256,49,1,257,55,55,3,11,1,49,257,1,51,255,51,51,3,49,49,3,11,52,52,3,50,50,3,1,50,258,52,1,256,11,50,1,258,52,1,256,49,1,257,1,
-        51,255,11,1,54,257,1,53,255,1,53,258,54,1,256,12,3,3,5,3,51,255,51,51,6,3,51,255,12,3,49,257,3,3,5,49,3,257,49,49,6,12,52,52,6,52,3,256,3,3,5,52,3,
-        256,12,50,3,258,50,50,6,3,50,258,3,3,5,12,3,3,5,3,3,5,49,3,257,3,51,255,12,3,54,257,3,3,5,3,3,5,54,3,256,12,50,3,258,52,3,256,3,3,5,3,3,5,12,3,3,5,
-        3,53,255,3,53,258,3,3,5,12,50,3,258,56,56,6,56,56,6,3,51,255,12,55,55,6,52,3,256,49,3,257,55,55,6,12,3,49,257,3,51,255,51,51,6,49,49,6,12,52,52,6,
-        50,50,6,3,50,258,52,3,256,12,50,3,258,52,3,256,49,3,257,3,51,255,12,3,54,257,3,53,255,3,53,258,54,3,256,13,1,1,2,1,51,255,51,51,4,1,51,255,13,1,49,
-        257,1,1,2,49,1,257,49,49,4,13,52,52,4,52,1,256,1,1,2,52,1,256,13,50,1,258,50,50,4,1,50,258,1,1,2,13,1,1,2,1,1,2,49,1,257,1,51,255,13,1,54,257,1,1,
-        2,1,1,2,54,1,256,13,50,1,258,52,1,256,1,1,2,1,1,2,13,1,1,2,1,53,255,1,53,258,1,1,2,13,50,1,258,5,5,4,5,5,4,1,51,255,13,5,5,4,52,1,256,49,1,257,5,5,
-        4,13,1,49,257,1,51,255,51,51,4,49,49,4,13,52,52,4,50,50,4,1,50,258,52,1,256,13,50,1,258,52,1,256,49,1,257,1,51,255,13,1,54,257,1,53,255,1,53,258,
-        54,1,256,14,3,3,5,3,51,255,51,51,7,3,51,255,14,3,49,257,3,3,5,49,3,257,49,49,7,14,52,52,7,52,3,256,3,3,5,52,3,256,14,50,3,258,50,50,7,3,50,258,3,3,
-        5,14,3,3,5,3,3,5,49,3,257,3,51,255,14,3,54,257,3,3,5,3,3,5,54,3,256,14,50,3,258,52,3,256,3,3,5,3,3,5,14,3,3,5,3,53,255,3,53,258,3,3,5,14,50,3,258,
-        6,6,7,6,6,7,3,51,255,14,6,6,7,52,3,256,49,3,257,6,6,7,14,3,49,257,3,51,255,51,51,7,49,49,7,14,52,52,7,50,50,7,3,50,258,52,3,256,14,50,3,258,52,3,
-        256,49,3,257,3,51,255,14,3,54,257,3,53,255,3,53,258,54,3,256,15,1,1,2,1,51,255,51,51,8,1,51,255,15,1,49,257,1,1,2,49,1,257,49,49,8,15,52,52,8,52,1,
-        256,1,1,2,52,1,256,15,50,1,258,50,50,8,1,50,258,1,1,2,15,1,1,2,1,1,2,49,1,257,1,51,255,15,1,54,257,1,1,2,1,1,2,54,1,256,15,50,1,258,52,1,256,1,1,2,
-        1,1,2,15,1,1,2,1,53,255,1,53,258,1,1,2,15,50,1,258,56,56,8,56,56,8,1,51,255,15,55,55,8,52,1,256,49,1,257,55,55,8,15,1,49,257,1,51,255,51,51,8,49,
-        49,8,15,52,52,8,50,50,8,1,50,258,52,1,256,15,50,1,258,52,1,256,49,1,257,1,51,255,15,1,54,257,1,53,255,1,53,258,54,1,256
+    forEachFixtureTileset("Reconstruct ISOM tests", "maps rebuilt from TILE", [&](size_t tilesetIndex) {
+        Sc::Terrain::Tileset tileset = Sc::Terrain::Tileset(tilesetIndex);
+        Sc::Terrain_::Tiles tiles = TestData::makeFixtureTiles(tilesetIndex);
+        const ScMap original = editFixtureMap(tilesetIndex, tiles, 0x2700 + uint32_t(tilesetIndex));
+        Chk::IsomCache cache(tileset, original.tileWidth, original.tileHeight, tiles);
+
+        ScMap serial = original;
+        serial.isomRects.assign(serial.isomRects.size(), Chk::IsomRect{});
+        auto serialInexact = serial.reconstructIsomFromTiles(cache);
+
+        ScMap pooled = original;
+        pooled.isomRects.assign(pooled.isomRects.size(), Chk::IsomRect{});
+        auto pooledInexact = pooled.reconstructIsomFromTiles(cache, threadPool);
+
+        bool exact = serialInexact && *serialInexact == 0 && pooledInexact && *pooledInexact == 0;
+        size_t serialMismatches = countMismatchedDiamonds(serial, original);
+        size_t pooledMismatches = countMismatchedDiamonds(pooled, original);
+        bool consistent = serial.validateIsom(cache).isConsistent() && pooled.validateIsom(cache).isConsistent();
+        if ( !exact || serialMismatches > 0 || pooledMismatches > 0 || !consistent )
+        {
+            std::cout << "FAIL - Reconstruct ISOM test - " << TestData::fixtureTilesetNames[tilesetIndex] << (exact ? "" : " inexact diamonds")
+                << (consistent ? "" : " inconsistent ISOM") << " - " << serialMismatches << " serial & " << pooledMismatches << " pooled diamonds differ" << std::endl;
+            return false;
+        }
+        return true;
+    });
+}
+
+// Corrupts three separate spots of a brushed fixture map, validating serially & on the thread pool must give the same report with one region per spot,
+// the band boundaries of the pooled validation fall within the first spot; repairIsom must then leave the map consistent
+void validateRepairTest()
+{
+    constexpr uint16_t mapSize = 128;
+    const Chk::IsomDiamond corruptDiamonds[] { {20, 16}, {50, 60}, {40, 100} };
+    auto sameRegion = [](const Sc::BoundingBox & lhs, const Sc::BoundingBox & rhs) {
+        return lhs.left == rhs.left && lhs.top == rhs.top && lhs.right == rhs.right && lhs.bottom == rhs.bottom;
     };
+    forEachFixtureTileset("Validate & repair tests", "corrupted maps validated & repaired", [&](size_t tilesetIndex) {
+        Sc::Terrain::Tileset tileset = Sc::Terrain::Tileset(tilesetIndex);
+        Sc::Terrain_::Tiles tiles = TestData::makeFixtureTiles(tilesetIndex);
+        Chk::IsomCache cache(tileset, mapSize, mapSize, tiles);
+        ScMap scMap = newFixtureMap(tileset, mapSize, size_t(tiles.defaultBrush.index), cache);
+        std::mt19937 random(0x2600 + uint32_t(tilesetIndex));
+        for ( size_t i=0; i<8; ++i )
+        {
+            size_t y = 24 + random() % 64;
+            size_t x = 24 + random() % 16;
+            scMap.placeIsomTerrain({x + (x+y)%2, y}, size_t(tiles.brushes[random() % tiles.brushes.size()].index), 1 + random() % 4, cache);
+            scMap.updateTilesFromIsom(cache);
+        }
+        bool initiallyConsistent = scMap.validateIsom(cache).isConsistent();
+
+        auto setQuadrant = [&](Chk::IsomDiamond isomDiamond, Sc::Isom::Quadrant quadrant, uint16_t isomValue) {
+            Chk::IsomRect::Point rectCoords = isomDiamond.getRectangleCoords(quadrant);
+            scMap.isomRects[rectCoords.y*scMap.getIsomWidth() + rectCoords.x].set(Sc::Isom::ProjectedQuadrant{quadrant}, isomValue);
+        };
+        size_t otherBrush = tiles.brushes[0].index == tiles.defaultBrush.index ? 1 : 0;
+        uint16_t otherIsomValue = cache.getTerrainTypeIsomValue(size_t(tiles.brushes[otherBrush].index));
+        for ( auto quadrant : Sc::Isom::quadrants ) // Links no longer match the neighbors
+            setQuadrant(corruptDiamonds[0], quadrant, otherIsomValue);
+
+        setQuadrant(corruptDiamonds[1], Sc::Isom::Quadrant::TopLeft, otherIsomValue); // Quadrants no longer match
+        for ( auto quadrant : Sc::Isom::quadrants ) // Value is past the end of the isomLinks table
+            setQuadrant(corruptDiamonds[2], quadrant, uint16_t(cache.isomLinks.size()));
+
+        Chk::IsomValidationReport serialReport = scMap.validateIsom(cache);
+        Chk::IsomValidationReport pooledReport = scMap.validateIsom(cache, threadPool);
+        bool reportsMatch = serialReport.diamondsChecked == pooledReport.diamondsChecked && serialReport.invalidValues == pooledReport.invalidValues &&
+            serialReport.quadrantMismatches == pooledReport.quadrantMismatches && serialReport.linkMismatches == pooledReport.linkMismatches &&
+            serialReport.inconsistentRegions.size() == pooledReport.inconsistentRegions.size() &&
+            std::equal(serialReport.inconsistentDiamonds.begin(), serialReport.inconsistentDiamonds.end(), pooledReport.inconsistentDiamonds.begin(),
+                pooledReport.inconsistentDiamonds.end(), [](const auto & lhs, const auto & rhs) { return lhs.x == rhs.x && lhs.y == rhs.y; }) &&
+            std::equal(serialReport.inconsistentRegions.begin(), serialReport.inconsistentRegions.end(), pooledReport.inconsistentRegions.begin(), sameRegion);
+
+        bool regionsFound = serialReport.inconsistentRegions.size() == std::size(corruptDiamonds);
+        for ( size_t i=0; regionsFound && i<std::size(corruptDiamonds); ++i )
+        {
+            const auto & region = serialReport.inconsistentRegions[i];
+            regionsFound = corruptDiamonds[i].x >= region.left && corruptDiamonds[i].x <= region.right &&
+                corruptDiamonds[i].y >= region.top && corruptDiamonds[i].y <= region.bottom;
+        }
+
+        scMap.repairIsom(serialReport, false, cache);
+        scMap.updateTilesFromIsom(cache);
+        bool repaired = scMap.validateIsom(cache).isConsistent();
+        if ( !initiallyConsistent || serialReport.isConsistent() || !reportsMatch || !regionsFound || !repaired )
+        {
+            std::cout << "FAIL - Validate & repair test - " << TestData::fixtureTilesetNames[tilesetIndex] << (initiallyConsistent ? "" : " brushed map was inconsistent")
+                << (serialReport.isConsistent() ? " corruption not found" : "") << (reportsMatch ? "" : " serial & pooled reports differ")
+                << (regionsFound ? "" : " regions don't match the corrupted spots") << (repaired ? "" : " repaired map is inconsistent") << " - regions";
+            printRegions(std::cout, serialReport.inconsistentRegions) << std::endl;
+            return false;
+        }
+        return true;
+    });
+}
+
+// Brushes two separate patches of one terrain type on fixture maps & flood fills the first with another type, every diamond of the first patch must take the
+// new terrain type while the second patch & everything around it is left as it was, and the filled map must validate
+void floodFillTest()
+{
+    constexpr uint16_t mapSize = 128;
+    const Chk::IsomDiamond filledPatch {30, 40};
+    const Chk::IsomDiamond otherPatch {30, 100};
+    forEachFixtureTileset("Flood fill tests", "patches filled", [&](size_t tilesetIndex) {
+        Sc::Terrain::Tileset tileset = Sc::Terrain::Tileset(tilesetIndex);
+        Sc::Terrain_::Tiles tiles = TestData::makeFixtureTiles(tilesetIndex);
+        Chk::IsomCache cache(tileset, mapSize, mapSize, tiles);
+        ScMap scMap = newFixtureMap(tileset, mapSize, size_t(tiles.defaultBrush.index), cache);
+        size_t patchBrush = tiles.brushes[0].index == tiles.defaultBrush.index ? 1 : 0;
+        size_t fillBrush = tiles.brushes.back().index == tiles.defaultBrush.index ? tiles.brushes.size()-2 : tiles.brushes.size()-1;
+        for ( auto patch : { filledPatch, otherPatch } )
+        {
+            scMap.placeIsomTerrain(patch, size_t(tiles.brushes[patchBrush].index), 4, cache);
+            scMap.updateTilesFromIsom(cache);
+        }
+
+        size_t isomWidth = scMap.getIsomWidth();
+        auto terrainTypeAt = [&](Chk::IsomDiamond isomDiamond) {
+            return cache.isomLinks[scMap.isomRects[isomDiamond.y*isomWidth + isomDiamond.x].left >> 4].terrainType;
+        };
+        uint16_t patchTerrainType = terrainTypeAt(filledPatch);
+        std::vector<bool> inRegion(scMap.isomRects.size(), false);
+        std::vector<Chk::IsomDiamond> region { filledPatch };
+        inRegion[filledPatch.y*isomWidth + filledPatch.x] = true;
+        for ( size_t i=0; i<region.size(); ++i )
+        {
+            for ( auto neighborIndex : Chk::IsomDiamond::neighbors )
+            {
+                Chk::IsomDiamond neighbor = region[i].getNeighbor(neighborIndex);
+                if ( neighbor.x < isomWidth && neighbor.y < scMap.getIsomHeight() && !inRegion[neighbor.y*isomWidth + neighbor.x] && terrainTypeAt(neighbor) == patchTerrainType )
+                {
+                    inRegion[neighbor.y*isomWidth + neighbor.x] = true;
+                    region.push_back(neighbor);
+                }
+            }
+        }
+        std::vector<Chk::IsomRect> priorRects = scMap.isomRects;
+
+        bool filled = scMap.floodFillIsomTerrain(filledPatch, size_t(tiles.brushes[fillBrush].index), cache);
+        scMap.updateTilesFromIsom(cache);
+
+        uint16_t fillTerrainType = cache.isomLinks[cache.getTerrainTypeIsomValue(size_t(tiles.brushes[fillBrush].index))].terrainType;
+        size_t unfilledDiamonds = 0;
+        for ( const auto & isomDiamond : region )
+            unfilledDiamonds += terrainTypeAt(isomDiamond) == fillTerrainType ? 0 : 1;
+
+        size_t otherChanges = 0;
+        for ( size_t i=(otherPatch.y-otherPatch.y/4)*isomWidth; i<scMap.isomRects.size(); ++i ) // Everything from midway between the patches down
+            otherChanges += (scMap.isomRects[i].left >> 4) == (priorRects[i].left >> 4) && (scMap.isomRects[i].right >> 4) == (priorRects[i].right >> 4) ? 0 : 1;
+
+        Chk::IsomValidationReport report = scMap.validateIsom(cache);
+        if ( !filled || region.size() < 2 || unfilledDiamonds > 0 || otherChanges > 0 || !report.isConsistent() )
+        {
+            std::cout << "FAIL - Flood fill test - " << TestData::fixtureTilesetNames[tilesetIndex] << (filled ? "" : " fill was rejected")
+                << (region.size() < 2 ? " patch wasn't brushed" : "") << " - " << unfilledDiamonds << " / " << region.size() << " diamonds unfilled, "
+                << otherChanges << " rects changed outside the region, " << report.inconsistentDiamonds.size() << " inconsistent diamonds" << std::endl;
+            return false;
+        }
+        return true;
+    });
+}
+
+// Brushes patches of terrain types with a same-named brush in another fixture tileset & converts the map to that tileset by name, the converted map must
+// validate & keep the mapped terrain type at each patch; caches made for other map dimensions must be rejected without touching the map
+void convertTilesetTest()
+{
+    constexpr uint16_t mapSize = 128;
+    const Chk::IsomDiamond patches[] { {20, 20}, {50, 56}, {20, 90} };
+    forEachFixtureTileset("Convert tileset tests", "maps converted by brush name", [&](size_t sourceIndex) {
+        Sc::Terrain_::Tiles sourceTiles = TestData::makeFixtureTiles(sourceIndex);
+        auto sharedBrushes = [&](const std::vector<uint16_t> & terrainTypeMapping) {
+            return std::count_if(sourceTiles.brushes.begin(), sourceTiles.brushes.end(), [&](const Sc::Isom::TerrainTypeInfo & brush) {
+                return brush.index != sourceTiles.defaultBrush.index && terrainTypeMapping[brush.index] != 0; });
+        };
+        size_t destIndex = (sourceIndex+1) % TestData::totalFixtureTilesets; // Convert to whichever fixture tileset shares the most brush names
+        for ( size_t i=0; i<TestData::totalFixtureTilesets; ++i )
+        {
+            if ( i != sourceIndex && sharedBrushes(Sc::Isom::getTerrainTypeMappingByName(sourceIndex, i)) >
+                sharedBrushes(Sc::Isom::getTerrainTypeMappingByName(sourceIndex, destIndex)) )
+            {
+                destIndex = i;
+            }
+        }
+        std::vector<uint16_t> terrainTypeMapping = Sc::Isom::getTerrainTypeMappingByName(sourceIndex, destIndex);
+        Sc::Terrain_::Tiles destTiles = TestData::makeFixtureTiles(destIndex);
+        Chk::IsomCache sourceCache(Sc::Terrain::Tileset(sourceIndex), mapSize, mapSize, sourceTiles);
+        Chk::IsomCache destCache(Sc::Terrain::Tileset(destIndex), mapSize, mapSize, destTiles);
+        Chk::IsomCache undersizedCache(Sc::Terrain::Tileset(destIndex), mapSize/2, mapSize, destTiles);
+        ScMap scMap = newFixtureMap(Sc::Terrain::Tileset(sourceIndex), mapSize, size_t(sourceTiles.defaultBrush.index), sourceCache);
+
+        std::vector<uint16_t> patchTerrainTypes {};
+        for ( const auto & brush : sourceTiles.brushes )
+        {
+            if ( patchTerrainTypes.size() < std::size(patches) && brush.index != sourceTiles.defaultBrush.index && terrainTypeMapping[brush.index] != 0 )
+            {
+                scMap.placeIsomTerrain(patches[patchTerrainTypes.size()], size_t(brush.index), 4, sourceCache);
+                scMap.updateTilesFromIsom(sourceCache);
+                patchTerrainTypes.push_back(uint16_t(brush.index));
+            }
+        }
 
-    inline constexpr uint16_t jungleIsomLinks[] {
-        0,0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,1,1,1,1,3,4,4,2,4,4,2,4,4,2,4,4,2,5,5,5,3,5,5,3,5,5,3,5,5,3,8,8,8,8,8,8,8,8,8,8,8,8,8,9,12,12,11,12,12,
-        11,12,12,11,12,12,11,15,11,11,10,11,11,10,11,11,10,11,11,10,11,6,6,12,6,6,12,6,6,12,6,6,12,16,16,16,13,16,16,13,16,16,13,16,16,13,10,9,9,14,9,9,14,
-        9,9,14,9,9,14,12,7,7,15,7,7,15,7,7,15,7,7,15,13,13,13,16,13,13,16,13,13,16,13,13,16,17,17,17,17,17,17,17,17,17,17,17,17,17,4,15,15,4,15,15,4,15,15,
-        4,15,15,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,34,1,1,1,1,51,255,51,51,2,1,51,255,34,1,49,257,1,1,1,49,1,
-        257,49,49,2,34,52,52,2,52,30,256,30,30,1,52,30,256,34,50,31,258,50,50,2,31,50,258,31,31,1,34,1,1,1,1,1,1,49,1,257,1,51,255,34,1,54,257,1,1,1,1,1,1,
-        54,33,256,34,50,31,258,52,30,256,30,30,1,31,31,1,34,1,1,1,1,53,255,32,53,258,1,1,1,34,50,31,258,56,56,2,56,56,2,31,51,255,34,55,55,2,52,30,256,49,
-        30,257,55,55,2,34,1,49,257,1,51,255,51,51,2,49,49,2,34,52,52,2,50,50,2,31,50,258,52,30,256,34,50,31,258,52,30,256,49,30,257,31,51,255,34,1,54,257,
-        1,53,255,32,53,258,54,33,256,35,5,5,3,5,51,255,51,51,1,5,51,255,35,5,49,257,5,5,3,49,5,257,49,49,1,35,52,52,1,52,34,256,34,34,3,52,34,256,35,50,35,
-        258,50,50,1,35,50,258,35,35,3,35,5,5,3,5,5,3,49,5,257,5,51,255,35,5,54,257,5,5,3,5,5,3,54,37,256,35,50,35,258,52,34,256,34,34,3,35,35,3,35,5,5,3,5,
-        53,255,36,53,258,5,5,3,35,50,35,258,56,56,1,56,56,1,35,51,255,35,55,55,1,52,34,256,49,34,257,55,55,1,35,5,49,257,5,51,255,51,51,1,49,49,1,35,52,52,
-        1,50,50,1,35,50,258,52,34,256,35,50,35,258,52,34,256,49,34,257,35,51,255,35,5,54,257,5,53,255,36,53,258,54,37,256,23,1,1,1,1,51,255,51,51,8,1,51,
-        255,23,1,49,257,1,1,1,49,1,257,49,49,8,23,52,52,8,52,1,256,1,1,1,52,1,256,23,50,1,258,50,50,8,1,50,258,1,1,1,23,1,1,1,1,1,1,49,1,257,1,51,255,23,1,
-        54,257,1,1,1,1,1,1,54,1,256,23,50,1,258,52,1,256,1,1,1,1,1,1,23,1,1,1,1,53,255,1,53,258,1,1,1,23,50,1,258,56,56,8,56,56,8,1,51,255,23,55,55,8,52,1,
-        256,49,1,257,55,55,8,23,1,49,257,1,51,255,51,51,8,49,49,8,23,52,52,8,50,50,8,1,50,258,52,1,256,23,50,1,258,52,1,256,49,1,257,1,51,255,23,1,54,257,
-        1,53,255,1,53,258,54,1,256,28,1,1,1,1,51,255,51,51,10,1,51,255,28,1,49,257,1,1,1,49,1,257,49,49,10,28,52,52,10,52,1,256,1,1,1,52,1,256,28,50,1,258,
-        50,50,10,1,50,258,1,1,1,28,1,1,1,1,1,1,49,1,257,1,51,255,28,1,54,257,1,1,1,1,1,1,54,1,256,28,50,1,258,52,1,256,1,1,1,1,1,1,28,1,1,1,1,53,255,1,53,
-        258,1,1,1,28,50,1,258,11,11,10,11,11,10,1,51,255,28,11,11,10,52,1,256,49,1,257,11,11,10,28,1,49,257,1,51,255,51,51,10,49,49,10,28,52,52,10,50,50,
-        10,1,50,258,52,1,256,28,50,1,258,52,1,256,49,1,257,1,51,255,28,1,54,257,1,53,255,1,53,258,54,1,256,29,8,8,8,8,51,255,51,51,11,8,51,255,29,8,49,257,
-        8,8,8,49,8,257,49,49,11,29,52,52,11,52,8,256,8,8,8,52,8,256,29,50,8,258,50,50,11,8,50,258,8,8,8,29,8,8,8,8,8,8,49,8,257,8,51,255,29,8,54,257,8,8,8,
-        8,8,8,54,8,256,29,50,8,258,52,8,256,8,8,8,8,8,8,29,8,8,8,8,53,255,8,53,258,8,8,8,29,50,8,258,12,12,11,12,12,11,8,51,255,29,12,12,11,52,8,256,49,8,
-        257,12,12,11,29,8,49,257,8,51,255,51,51,11,49,49,11,29,52,52,11,50,50,11,8,50,258,52,8,256,29,50,8,258,52,8,256,49,8,257,8,51,255,29,8,54,257,8,53,
-        255,8,53,258,54,8,256,25,8,8,8,8,51,255,51,51,12,8,51,255,25,8,49,257,8,8,8,49,8,257,49,49,12,25,52,52,12,52,8,256,8,8,8,52,8,256,25,50,8,258,50,
-        50,12,8,50,258,8,8,8,25,8,8,8,8,8,8,49,8,257,8,51,255,25,8,54,257,8,8,8,8,8,8,54,8,256,25,50,8,258,52,8,256,8,8,8,8,8,8,25,8,8,8,8,53,255,8,53,258,
-        8,8,8,25,50,8,258,6,6,12,6,6,12,8,51,255,25,6,6,12,52,8,256,49,8,257,6,6,12,25,8,49,257,8,51,255,51,51,12,49,49,12,25,52,52,12,50,50,12,8,50,258,
-        52,8,256,25,50,8,258,52,8,256,49,8,257,8,51,255,25,8,54,257,8,53,255,8,53,258,54,8,256,32,8,8,8,8,51,255,51,51,13,8,51,255,32,8,49,257,8,8,8,49,8,
-        257,49,49,13,32,52,52,13,52,18,256,18,18,8,52,18,256,32,50,19,258,50,50,13,19,50,258,19,19,8,32,8,8,8,8,8,8,49,8,257,8,51,255,32,8,54,257,8,8,8,8,
-        8,8,54,21,256,32,50,19,258,52,18,256,18,18,8,19,19,8,32,8,8,8,8,53,255,20,53,258,8,8,8,32,50,19,258,56,56,13,56,56,13,19,51,255,32,55,55,13,52,18,
-        256,49,18,257,55,55,13,32,8,49,257,8,51,255,51,51,13,49,49,13,32,52,52,13,50,50,13,19,50,258,52,18,256,32,50,19,258,52,18,256,49,18,257,19,51,255,
-        32,8,54,257,8,53,255,20,53,258,54,21,256,24,4,4,2,4,51,255,51,51,14,4,51,255,24,4,49,257,4,4,2,49,4,257,49,49,14,24,52,52,14,52,4,256,4,4,2,52,4,
-        256,24,50,4,258,50,50,14,4,50,258,4,4,2,24,4,4,2,4,4,2,49,4,257,4,51,255,24,4,54,257,4,4,2,4,4,2,54,4,256,24,50,4,258,52,4,256,4,4,2,4,4,2,24,4,4,
-        2,4,53,255,4,53,258,4,4,2,24,50,4,258,56,56,14,56,56,14,4,51,255,24,55,55,14,52,4,256,49,4,257,55,55,14,24,4,49,257,4,51,255,51,51,14,49,49,14,24,
-        52,52,14,50,50,14,4,50,258,52,4,256,24,50,4,258,52,4,256,49,4,257,4,51,255,24,4,54,257,4,53,255,4,53,258,54,4,256,26,9,9,14,9,51,255,51,51,15,9,51,
-        255,26,9,49,257,9,9,14,49,9,257,49,49,15,26,52,52,15,52,9,256,9,9,14,52,9,256,26,50,9,258,50,50,15,9,50,258,9,9,14,26,9,9,14,9,9,14,49,9,257,9,51,
-        255,26,9,54,257,9,9,14,9,9,14,54,9,256,26,50,9,258,52,9,256,9,9,14,9,9,14,26,9,9,14,9,53,255,9,53,258,9,9,14,26,50,9,258,7,7,15,7,7,15,9,51,255,26,
-        7,7,15,52,9,256,49,9,257,7,7,15,26,9,49,257,9,51,255,51,51,15,49,49,15,26,52,52,15,50,50,15,9,50,258,52,9,256,26,50,9,258,52,9,256,49,9,257,9,51,
-        255,26,9,54,257,9,53,255,9,53,258,54,9,256,30,9,9,14,9,51,255,51,51,16,9,51,255,30,9,49,257,9,9,14,49,9,257,49,49,16,30,52,52,16,52,9,256,9,9,14,
-        52,9,256,30,50,9,258,50,50,16,9,50,258,9,9,14,30,9,9,14,9,9,14,49,9,257,9,51,255,30,9,54,257,9,9,14,9,9,14,54,9,256,30,50,9,258,52,9,256,9,9,14,9,
-        9,14,30,9,9,14,9,53,255,9,53,258,9,9,14,30,50,9,258,13,13,16,13,13,16,9,51,255,30,13,13,16,52,9,256,49,9,257,13,13,16,30,9,49,257,9,51,255,51,51,
-        16,49,49,16,30,52,52,16,50,50,16,9,50,258,52,9,256,30,50,9,258,52,9,256,49,9,257,9,51,255,30,9,54,257,9,53,255,9,53,258,54,9,256,33,9,9,14,9,51,
-        255,51,51,17,9,51,255,33,9,49,257,9,9,14,49,9,257,49,49,17,33,52,52,17,52,22,256,22,22,14,52,22,256,33,50,23,258,50,50,17,23,50,258,23,23,14,33,9,
-        9,14,9,9,14,49,9,257,9,51,255,33,9,54,257,9,9,14,9,9,14,54,25,256,33,50,23,258,52,22,256,22,22,14,23,23,14,33,9,9,14,9,53,255,24,53,258,9,9,14,33,
-        50,23,258,56,56,17,56,56,17,23,51,255,33,55,55,17,52,22,256,49,22,257,55,55,17,33,9,49,257,9,51,255,51,51,17,49,49,17,33,52,52,17,50,50,17,23,50,
-        258,52,22,256,33,50,23,258,52,22,256,49,22,257,23,51,255,33,9,54,257,9,53,255,24,53,258,54,25,256,22,1,1,1,1,51,255,51,51,4,1,51,255,22,1,49,257,1,
-        1,1,49,1,257,49,49,4,22,52,52,4,52,1,256,1,1,1,52,1,256,22,50,1,258,50,50,4,1,50,258,1,1,1,22,1,1,1,1,1,1,49,1,257,1,51,255,22,1,54,257,1,1,1,1,1,
-        1,54,1,256,22,50,1,258,52,1,256,1,1,1,1,1,1,22,1,1,1,1,53,255,1,53,258,1,1,1,22,50,1,258,56,56,4,56,56,4,1,51,255,22,55,55,4,52,1,256,49,1,257,55,
-        55,4,22,1,49,257,1,51,255,51,51,4,49,49,4,22,52,52,4,50,50,4,1,50,258,52,1,256,22,50,1,258,52,1,256,49,1,257,1,51,255,22,1,54,257,1,53,255,1,53,
-        258,54,1,256
+        size_t isomWidth = scMap.getIsomWidth();
+        std::vector<Chk::IsomRect> sourceRects = scMap.isomRects;
+        bool mismatchRejected = !scMap.convertTileset(terrainTypeMapping, sourceCache, undersizedCache) &&
+            !scMap.convertTileset(terrainTypeMapping, undersizedCache, destCache) && scMap.tileset == Sc::Terrain::Tileset(sourceIndex) &&
+            std::equal(sourceRects.begin(), sourceRects.end(), scMap.isomRects.begin(), scMap.isomRects.end(),
+                [](const Chk::IsomRect & lhs, const Chk::IsomRect & rhs) { return lhs.left == rhs.left && lhs.right == rhs.right; });
+
+        bool converted = scMap.convertTileset(terrainTypeMapping, sourceCache, destCache) && scMap.tileset == Sc::Terrain::Tileset(destIndex);
+        size_t lostTerrainTypes = 0;
+        for ( size_t i=0; i<patchTerrainTypes.size(); ++i )
+        {
+            uint16_t isomValue = scMap.isomRects[patches[i].y*isomWidth + patches[i].x].left >> 4;
+            if ( isomValue >= destCache.isomLinks.size() || destCache.isomLinks[isomValue].terrainType != terrainTypeMapping[patchTerrainTypes[i]] )
+                ++lostTerrainTypes;
+        }
+
+        Chk::IsomValidationReport report = scMap.validateIsom(destCache);
+        if ( patchTerrainTypes.empty() || !mismatchRejected || !converted || lostTerrainTypes > 0 || !report.isConsistent() )
+        {
+            std::cout << "FAIL - Convert tileset test - " << TestData::fixtureTilesetNames[sourceIndex] << " to " << TestData::fixtureTilesetNames[destIndex]
+                << (patchTerrainTypes.empty() ? " no brushes share a name" : "") << (mismatchRejected ? "" : " mismatched cache wasn't rejected")
+                << (converted ? "" : " conversion failed") << " - " << lostTerrainTypes << " / " << patchTerrainTypes.size() << " mapped terrain types lost, "
+                << report.inconsistentDiamonds.size() << " inconsistent diamonds" << std::endl;
+            return false;
+        }
+        return true;
+    });
+}
+
+// Captures a stamp from an edited fixture map & places it elsewhere in the map's interior & flush against its bottom-right corner, the rects & tiles of the stamp's
+// interior must match the stamp and the seams must hold only valid isomValues with matching quadrants; link mismatches the radial update leaves on the seam
+// (as it does elsewhere, see IsomBenchmark --stress) are reported but don't fail the test; stamps that would hang off the map must be rejected
+void isomStampTest()
+{
+    constexpr size_t stampSize = 16;
+    constexpr size_t seamMargin = 1; // Rects this close to the edge of a placed stamp share sides with the seam
+    forEachFixtureTileset("Isom stamp tests", "stamps placed", [&](size_t tilesetIndex) {
+        Sc::Terrain_::Tiles tiles = TestData::makeFixtureTiles(tilesetIndex);
+        ScMap scMap = editFixtureMap(tilesetIndex, tiles, 0x3000 + uint32_t(tilesetIndex));
+        Chk::IsomCache cache(Sc::Terrain::Tileset(tilesetIndex), scMap.tileWidth, scMap.tileHeight, tiles);
+        const Chk::IsomDiamond placements[] {
+            {30, 64}, // Interior
+            {size_t(scMap.tileWidth)/2 - stampSize, size_t(scMap.tileHeight) - stampSize} // Bottom-right corner, the seam is clipped by the map edges
+        };
+
+        std::optional<Chk::IsomStamp> stamp = scMap.captureIsomStamp({20, 20}, stampSize, stampSize);
+        bool overhangRejected = stamp && !scMap.placeIsomStamp(*stamp, {placements[1].x+2, placements[1].y}, cache) &&
+            !scMap.placeIsomStamp(*stamp, {placements[1].x, placements[1].y+2}, cache);
+
+        size_t placedStamps = 0;
+        size_t rectMismatches = 0;
+        size_t tileMismatches = 0;
+        for ( size_t i=0; stamp && i<std::size(placements); ++i )
+        {
+            if ( !scMap.placeIsomStamp(*stamp, placements[i], cache) )
+                continue;
+
+            ++placedStamps;
+            scMap.updateTilesFromIsom(cache);
+            for ( size_t y=seamMargin; y<stampSize-seamMargin; ++y )
+            {
+                for ( size_t x=seamMargin; x<stampSize-seamMargin; ++x )
+                {
+                    const Chk::IsomRect & stampRect = stamp->isomRects[y*stampSize + x];
+                    const Chk::IsomRect & placedRect = scMap.isomRects[(placements[i].y+y)*scMap.getIsomWidth() + placements[i].x+x];
+                    if ( (stampRect.left >> 4) != (placedRect.left >> 4) || (stampRect.top >> 4) != (placedRect.top >> 4) ||
+                        (stampRect.right >> 4) != (placedRect.right >> 4) || (stampRect.bottom >> 4) != (placedRect.bottom >> 4) )
+                    {
+                        ++rectMismatches;
+                    }
+
+                    size_t tileIndex = (placements[i].y+y)*scMap.tileWidth + 2*(placements[i].x+x);
+                    if ( scMap.editorTiles[tileIndex] != stamp->tiles[2*(y*stampSize + x)] || scMap.editorTiles[tileIndex+1] != stamp->tiles[2*(y*stampSize + x)+1] )
+                        ++tileMismatches;
+                }
+            }
+        }
+
+        Chk::IsomValidationReport report = scMap.validateIsom(cache);
+        if ( !stamp || !overhangRejected || placedStamps != std::size(placements) || rectMismatches > 0 || tileMismatches > 0 ||
+            report.quadrantMismatches > 0 || report.invalidValues > 0 )
+        {
+            std::cout << "FAIL - Isom stamp test - " << TestData::fixtureTilesetNames[tilesetIndex] << (stamp ? "" : " stamp wasn't captured")
+                << (overhangRejected ? "" : " overhanging stamp wasn't rejected") << " - " << placedStamps << " / " << std::size(placements) << " stamps placed, "
+                << rectMismatches << " rect & " << tileMismatches << " tile mismatches, " << report.quadrantMismatches << " quadrant mismatches, "
+                << report.invalidValues << " invalid values" << std::endl;
+            return false;
+        }
+        if ( report.linkMismatches > 0 )
+            std::cout << "KNOWN - Isom stamp test - " << TestData::fixtureTilesetNames[tilesetIndex] << " - " << report.linkMismatches << " link mismatches left by radial updates" << std::endl;
+        return true;
+    });
+}
+
+// Reads serialized maps with only Scenario::terrainSections parsed (copying or viewing the rest), the terrain must match the original & writing the map back
+// must reproduce it byte for byte
+void sectionMaskTest()
+{
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<Sc::Terrain::NumTilesets; ++tilesetIndex )
+    {
+        Scenario scenario(Sc::Terrain::Tileset(tilesetIndex), 96, 64);
+        for ( size_t i=0; i<scenario.tiles.size(); ++i )
+            scenario.tiles[i] = scenario.editorTiles[i] = uint16_t(i*17 % 0x4000);
+
+        std::vector<u8> chk {};
+        std::vector<u8> rewritten {};
+        std::vector<u8> viewedRewritten {};
+        Scenario terrainOnly {};
+        Scenario viewed {};
+        bool roundTripped = scenario.write(chk) && terrainOnly.read(chk.data(), chk.size(), &Scenario::terrainSections) && terrainOnly.write(rewritten) &&
+            viewed.read(chk.data(), chk.size(), &Scenario::terrainSections, true) && viewed.write(viewedRewritten);
+        bool terrainMatches = terrainOnly.getTileset() == scenario.getTileset() && terrainOnly.getTileWidth() == scenario.getTileWidth() &&
+            terrainOnly.getTileHeight() == scenario.getTileHeight() && terrainOnly.tiles == scenario.tiles && terrainOnly.editorTiles == scenario.editorTiles &&
+            terrainOnly.isomRects.size() == scenario.isomRects.size() &&
+            std::memcmp(terrainOnly.isomRects.data(), scenario.isomRects.data(), scenario.isomRects.size()*sizeof(Chk::IsomRect)) == 0;
+
+        if ( !roundTripped || !terrainMatches || rewritten != chk || viewedRewritten != chk )
+        {
+            ++failCount;
+            std::cout << "FAIL - Section mask test - tileset " << tilesetIndex << (roundTripped ? "" : " failed to read or write")
+                << (terrainMatches ? "" : " terrain differs from the original") << (rewritten == chk ? "" : " rewritten map differs")
+                << (viewedRewritten == chk ? "" : " map rewritten from views differs") << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Section mask tests - " << (Sc::Terrain::NumTilesets - failCount) << " / "
+        << Sc::Terrain::NumTilesets << " maps round tripped with only terrain sections parsed" << std::endl;
+}
+
+// Reads whole serialized maps by default & with reuseCleanSections, then changes an isomRect directly without marking ISOM dirty; the default read must
+// re-serialize the change while the reusing read must write ISOM from the bytes it was read from, reproducing the map byte for byte; after a tile edit
+// through setTile & markDirty({ISOM}) the reusing read's write must carry both edits
+void dirtySectionTest()
+{
+    const Chk::TempIsomRect directEdit {1, 2, 3, 4};
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<Sc::Terrain::NumTilesets; ++tilesetIndex )
+    {
+        Scenario scenario(Sc::Terrain::Tileset(tilesetIndex), 64, 64);
+        std::vector<u8> chk {};
+        std::vector<u8> unchanged {};
+        std::vector<u8> reserialized {};
+        std::vector<u8> cached {};
+        std::vector<u8> edited {};
+        Scenario loaded {};
+        Scenario reusing {};
+        Scenario reloaded {};
+        Scenario reloadedEdits {};
+        bool roundTripped = scenario.write(chk) && loaded.read(chk.data(), chk.size()) && reusing.read(chk.data(), chk.size(), nullptr, false, true) &&
+            reusing.write(unchanged);
+        if ( roundTripped )
+        {
+            loaded.isomRects[0] = directEdit;
+            reusing.isomRects[0] = directEdit;
+            roundTripped = loaded.write(reserialized) && reloaded.read(reserialized.data(), reserialized.size()) && reusing.write(cached);
+        }
+        bool directEditSaved = roundTripped && !reloaded.isomRects.empty() && std::memcmp(&reloaded.isomRects[0], &directEdit, sizeof(directEdit)) == 0;
+        if ( roundTripped )
+        {
+            reusing.setTile(1, 1, u16(0x123));
+            reusing.markDirty({Chk::SectionName::ISOM});
+            roundTripped = reusing.write(edited) && reloadedEdits.read(edited.data(), edited.size());
+        }
+        bool editsSaved = roundTripped && reloadedEdits.getTile(1, 1, Chk::StrScope::Game) == 0x123 && reloadedEdits.getTile(1, 1, Chk::StrScope::Editor) == 0x123 &&
+            !reloadedEdits.isomRects.empty() && std::memcmp(&reloadedEdits.isomRects[0], &directEdit, sizeof(directEdit)) == 0;
+
+        if ( !roundTripped || unchanged != chk || !directEditSaved || cached != chk || !editsSaved )
+        {
+            ++failCount;
+            std::cout << "FAIL - Dirty section test - tileset " << tilesetIndex << (roundTripped ? "" : " failed to read or write")
+                << (unchanged == chk ? "" : " unchanged map differs") << (directEditSaved ? "" : " direct edit wasn't re-serialized")
+                << (cached == chk ? "" : " clean section wasn't written from its bytes") << (editsSaved ? "" : " edits were not saved") << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Dirty section tests - " << (Sc::Terrain::NumTilesets - failCount) << " / "
+        << Sc::Terrain::NumTilesets << " maps saved unchanged, re-serialized & from clean section bytes" << std::endl;
+}
+
+void sectionDirectoryTest()
+{
+    auto appendSection = [](std::vector<u8> & chk, u32 name, s32 sizeInBytes, const std::vector<u8> & data = {}) {
+        Chk::SectionHeader header { Chk::SectionName(name), sizeInBytes };
+        const u8* headerBytes = reinterpret_cast<const u8*>(&header);
+        chk.insert(chk.end(), headerBytes, headerBytes + sizeof(header));
+        chk.insert(chk.end(), data.begin(), data.end());
     };
+    const u32 extra = 0x41525458; // "XTRA"
+    const u32 hidden = 0x4E444948; // "HIDN"
+
+    Scenario scenario(Sc::Terrain::Tileset::Jungle, 96, 64);
+    std::vector<u8> chk {};
+    bool written = scenario.write(chk);
+    auto directory = Scenario::scanSections(chk.data(), chk.size());
+    const auto* dim = directory.find(Chk::SectionName::DIM);
+    Chk::DIM dimensions {};
+    if ( dim != nullptr && dim->size == sizeof(dimensions) )
+        std::memcpy(&dimensions, &chk[dim->offset], sizeof(dimensions));
+
+    bool scanned = written && directory.error.empty() && !directory.jumpCompressed && directory.tailLength == 0 &&
+        directory.find(Chk::SectionName::VER) != nullptr && dimensions.tileWidth == 96 && dimensions.tileHeight == 64;
+
+    // XTRA's data is a HIDN header, the jump after it lands on that header & HIDN's data is the jump section itself
+    std::vector<u8> jumped = chk;
+    std::vector<u8> hiddenHeader {};
+    appendSection(hiddenHeader, hidden, 8);
+    appendSection(jumped, extra, 8, hiddenHeader);
+    appendSection(jumped, 0, -16);
+    auto jumpedDirectory = Scenario::scanSections(jumped.data(), jumped.size());
+    const auto* hiddenSection = jumpedDirectory.find(Chk::SectionName(hidden));
+    Scenario jumpedScenario {};
+    bool jumpsResolved = jumpedDirectory.error.empty() && jumpedDirectory.jumpCompressed && jumpedDirectory.find(Chk::SectionName(extra)) != nullptr &&
+        hiddenSection != nullptr && hiddenSection->offset == jumped.size() - 8 && hiddenSection->size == 8 &&
+        jumpedScenario.read(jumped.data(), jumped.size()) && jumpedScenario.getTileset() == Sc::Terrain::Tileset::Jungle;
+
+    std::vector<u8> looped = chk;
+    appendSection(looped, 0, -8); // Jumps back to its own header
+    looped.insert(looped.end(), {1, 2, 3});
+    Scenario loopedScenario {};
+    bool loopRejected = !Scenario::scanSections(looped.data(), looped.size()).error.empty() && !loopedScenario.read(looped.data(), looped.size());
+
+    std::vector<u8> tailed = chk;
+    tailed.insert(tailed.end(), {1, 2, 3});
+    bool tailFound = Scenario::scanSections(tailed.data(), tailed.size()).tailLength == 3;
+
+    bool passed = scanned && jumpsResolved && loopRejected && tailFound;
+    std::cout << (passed ? "PASS - " : "FAIL - ") << "Section directory test" << (scanned ? "" : " sections not found") << (jumpsResolved ? "" : " jumps not resolved")
+        << (loopRejected ? "" : " jump loop not rejected") << (tailFound ? "" : " tail not found") << std::endl;
+}
+
+// Writes a chk back after a default read, which re-serializes every section (strings sharing the initial NUL each get their own), so this is what
+// fully parsed loads of chk must write
+std::vector<u8> reserializedChk(const std::vector<u8> & chk)
+{
+    std::vector<u8> reserialized {};
+    Scenario scenario {};
+    if ( !scenario.read(chk.data(), chk.size()) || !scenario.write(reserialized) )
+        reserialized.clear();
+
+    return reserialized;
+}
+
+void snapshotTest()
+{
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<Sc::Terrain::NumTilesets; ++tilesetIndex )
+    {
+        Scenario scenario(Sc::Terrain::Tileset(tilesetIndex), 64, 64);
+        scenario.setTile(2, 3, u16(0x456));
+        scenario.addString<RawString>("Snapshot test");
+        std::vector<u8> chk {};
+        std::vector<u8> snapshot {};
+        std::vector<u8> reloadedChk {};
+        Scenario reloaded {};
+        Scenario terrainOnly {};
+        bool roundTripped = scenario.write(chk) && scenario.writeSnapshot(snapshot) && reloaded.readSnapshot(snapshot.data(), snapshot.size()) &&
+            reloaded.write(reloadedChk) && terrainOnly.readSnapshot(snapshot.data(), snapshot.size(), &Scenario::terrainSections, true);
+
+        bool aligned = roundTripped;
+        Chk::SnapshotHeader header {};
+        if ( snapshot.size() >= sizeof(header) )
+            std::memcpy(&header, &snapshot[0], sizeof(header));
+        for ( size_t i=0; aligned && i<header.sectionCount; ++i )
+        {
+            Chk::SnapshotSection section {};
+            std::memcpy(&section, &snapshot[sizeof(header) + i*sizeof(section)], sizeof(section));
+            aligned = section.offset % Chk::SnapshotAlignment == 0;
+        }
+        std::vector<u8> truncated(snapshot.begin(), snapshot.end() - std::min(snapshot.size(), size_t(8)));
+        Scenario truncatedScenario {};
+        bool truncationRejected = !truncatedScenario.readSnapshot(truncated.data(), truncated.size()) && !Scenario::isSnapshot(chk.data(), chk.size());
+        bool terrainRead = roundTripped && terrainOnly.getTile(2, 3, Chk::StrScope::Game) == 0x456 && terrainOnly.getTileset() == Sc::Terrain::Tileset(tilesetIndex);
+        bool reloadedMatches = roundTripped && reloadedChk == reserializedChk(chk);
+
+        if ( !roundTripped || !reloadedMatches || !aligned || !truncationRejected || !terrainRead )
+        {
+            ++failCount;
+            std::cout << "FAIL - Snapshot test - tileset " << tilesetIndex << (roundTripped ? "" : " failed to read or write")
+                << (reloadedMatches ? "" : " chk differs") << (aligned ? "" : " sections unaligned") << (truncationRejected ? "" : " bad snapshot read")
+                << (terrainRead ? "" : " terrain not read") << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Snapshot tests - " << (Sc::Terrain::NumTilesets - failCount) << " / "
+        << Sc::Terrain::NumTilesets << " snapshots reloaded to identical chks" << std::endl;
+}
+
+// Maps a file, an empty file & a missing file, then moves a mapping & checks the moved-from mapping is closed while the contents stay mapped
+void mappedFileTest()
+{
+    std::filesystem::path filePath = std::filesystem::temp_directory_path() / "isom-mapped-file-test.bin";
+    std::filesystem::path emptyFilePath = std::filesystem::temp_directory_path() / "isom-mapped-file-test-empty.bin";
+    std::vector<u8> contents(10000);
+    for ( size_t i=0; i<contents.size(); ++i )
+        contents[i] = u8(i*31 % 251);
+
+    MappedFile mappedFile {};
+    MappedFile emptyFile {};
+    MappedFile missingFile {};
+    bool written = bufferToFile(filePath.string(), contents) && bufferToFile(emptyFilePath.string(), {});
+    bool mapped = written && mappedFile.open(filePath.string()) && mappedFile.isOpen() && mappedFile.size() == contents.size() &&
+        std::memcmp(mappedFile.data(), contents.data(), contents.size()) == 0;
+    bool emptyMapped = written && emptyFile.open(emptyFilePath.string()) && emptyFile.isOpen() && emptyFile.size() == 0;
+    bool missingRejected = !missingFile.open((std::filesystem::temp_directory_path() / "isom-mapped-file-test-missing.bin").string()) && !missingFile.isOpen();
+
+    MappedFile movedFile(std::move(mappedFile));
+    bool moved = mapped && !mappedFile.isOpen() && mappedFile.data() == nullptr && movedFile.isOpen() && movedFile.size() == contents.size() &&
+        std::memcmp(movedFile.data(), contents.data(), contents.size()) == 0;
+    movedFile.close();
+    bool closed = !movedFile.isOpen() && movedFile.data() == nullptr && movedFile.size() == 0;
+    emptyFile.close();
+    std::filesystem::remove(filePath);
+    std::filesystem::remove(emptyFilePath);
+
+    bool passed = mapped && emptyMapped && missingRejected && moved && closed;
+    std::cout << (passed ? "PASS - " : "FAIL - ") << "Mapped file test" << (mapped ? "" : " file not mapped") << (emptyMapped ? "" : " empty file not mapped")
+        << (missingRejected ? "" : " missing file mapped") << (moved ? "" : " move failed") << (closed ? "" : " close failed") << std::endl;
+}
+
+// Loads .chk files through MapFile's memory mapped path, fully parsed maps must release the mapping & write the chk re-serialized while maps with
+// only terrain parsed keep the mapping for the sections they view & write back the chk they were loaded from
+void mappedLoadTest()
+{
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<Sc::Terrain::NumTilesets; ++tilesetIndex )
+    {
+        Scenario scenario(Sc::Terrain::Tileset(tilesetIndex), 64, 64);
+        scenario.setTile(2, 3, u16(0x456));
+        scenario.addString<RawString>("Mapped load test");
+        std::filesystem::path chkPath = std::filesystem::temp_directory_path() / ("isom-mapped-load-test-" + std::to_string(tilesetIndex) + ".chk");
+        std::vector<u8> chk {};
+        bool written = scenario.write(chk) && bufferToFile(chkPath.string(), chk);
+
+        std::vector<u8> fullChk {};
+        std::vector<u8> terrainOnlyChk {};
+        MapFile full(chkPath.string());
+        MapFile terrainOnly(chkPath.string(), &Scenario::terrainSections);
+        bool loaded = written && full.getFilePath() == chkPath.string() && terrainOnly.getFilePath() == chkPath.string() &&
+            full.write(fullChk) && terrainOnly.write(terrainOnlyChk);
+        bool mappingKept = !full.isFileMapped() && terrainOnly.isFileMapped();
+        bool terrainRead = loaded && full.getTile(2, 3, Chk::StrScope::Game) == 0x456 && terrainOnly.getTile(2, 3, Chk::StrScope::Game) == 0x456;
+        bool fullMatches = loaded && fullChk == reserializedChk(chk);
+        std::filesystem::remove(chkPath);
+
+        if ( !loaded || !mappingKept || !terrainRead || !fullMatches || terrainOnlyChk != chk )
+        {
+            ++failCount;
+            std::cout << "FAIL - Mapped load test - tileset " << tilesetIndex << (loaded ? "" : " failed to load or write")
+                << (mappingKept ? "" : " mapping kept or released wrongly") << (terrainRead ? "" : " terrain not read")
+                << (fullMatches ? "" : " fully parsed chk differs") << (terrainOnlyChk == chk ? "" : " terrain only chk differs") << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Mapped load tests - " << (Sc::Terrain::NumTilesets - failCount) << " / "
+        << Sc::Terrain::NumTilesets << " chks loaded through a mapping & written back" << std::endl;
+}
+
+// Saves maps in the background while the live map keeps being edited, the written chk must match a copy of the scenario taken when the save started
+// & the map's path must only change once the save succeeds
+void saveAsyncTest()
+{
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<Sc::Terrain::NumTilesets; ++tilesetIndex )
+    {
+        std::filesystem::path chkPath = std::filesystem::temp_directory_path() / ("isom-save-async-test-" + std::to_string(tilesetIndex) + ".chk");
+        std::filesystem::path badPath = std::filesystem::temp_directory_path() / "isom-save-async-test-missing" / "map.chk";
+        MapFile map(Sc::Terrain::Tileset(tilesetIndex), 64, 64);
+        map.setSaveType(SaveType::ExpansionChk);
+        map.setTile(2, 3, u16(0x456));
+        map.addString<RawString>("Save async test");
+
+        Scenario snapshot(static_cast<const Scenario &>(map));
+        auto pendingSave = map.saveAsync(chkPath.string());
+        for ( size_t i=0; i<2000; ++i ) // Edits made after saveAsync returns mustn't reach the file
+        {
+            map.setTile(i%64, (i/64)%64, u16(0x789 + i));
+            if ( i%100 == 0 )
+                map.addString<RawString>("Edit " + std::to_string(i));
+        }
+        bool saved = pendingSave.get();
+        bool pathUpdated = map.getFilePath() == chkPath.string();
+
+        std::vector<u8> expectedChk {};
+        snapshot.changeVersionTo(Chk::Version::StarCraft_BroodWar);
+        snapshot.updateSaveSections();
+        auto writtenChk = fileToBuffer(chkPath.string());
+        bool matchesSnapshot = snapshot.write(expectedChk) && writtenChk && *writtenChk == expectedChk;
+
+        bool badSaveFailed = !map.saveAsync(badPath.string()).get() && map.getFilePath() == chkPath.string();
+        map.waitForPendingSave();
+        bool pathKept = map.getFilePath() == chkPath.string();
+        std::filesystem::remove(chkPath);
+
+        if ( !saved || !pathUpdated || !matchesSnapshot || !badSaveFailed || !pathKept )
+        {
+            ++failCount;
+            std::cout << "FAIL - Save async test - tileset " << tilesetIndex << (saved ? "" : " save failed") << (pathUpdated ? "" : " path not updated")
+                << (matchesSnapshot ? "" : " chk differs from the snapshot") << (badSaveFailed && pathKept ? "" : " failed save changed the path") << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Save async tests - " << (Sc::Terrain::NumTilesets - failCount) << " / "
+        << Sc::Terrain::NumTilesets << " maps saved while being edited" << std::endl;
+}
+
+// Loads maps (whole & terrain only) into an arena, copies them to the default resource, then releases & scribbles over the arena; the copies must own
+// everything they use so reading a string, editing & writing them still reproduces the original maps
+void arenaCopyTest()
+{
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<Sc::Terrain::NumTilesets; ++tilesetIndex )
+    {
+        Scenario scenario(Sc::Terrain::Tileset(tilesetIndex), 64, 64);
+        scenario.setTile(2, 3, u16(0x456));
+        size_t stringId = scenario.addString<RawString>("Arena copy test");
+        std::vector<u8> chk {};
+        bool written = scenario.write(chk);
+
+        std::optional<Scenario> copy {};
+        std::optional<Scenario> terrainOnlyCopy {};
+        std::vector<std::byte> arenaBuffer(size_t(1) << 20);
+        {
+            std::pmr::monotonic_buffer_resource arena(arenaBuffer.data(), arenaBuffer.size());
+            {
+                Scenario loaded(&arena);
+                Scenario terrainOnly(&arena);
+                if ( written && loaded.read(chk.data(), chk.size()) && terrainOnly.read(chk.data(), chk.size(), &Scenario::terrainSections) )
+                {
+                    copy.emplace(static_cast<const Scenario &>(loaded), std::pmr::get_default_resource());
+                    terrainOnlyCopy.emplace(static_cast<const Scenario &>(terrainOnly), std::pmr::get_default_resource());
+                }
+            }
+            arena.release();
+        }
+        std::fill(arenaBuffer.begin(), arenaBuffer.end(), std::byte(0xCD)); // Anything still pointing into the arena now reads garbage
+
+        std::vector<u8> copyChk {};
+        std::vector<u8> terrainOnlyChk {};
+        std::vector<u8> editedChk {};
+        Scenario reloaded {};
+        bool copied = copy && terrainOnlyCopy && copy->write(copyChk) && terrainOnlyCopy->write(terrainOnlyChk);
+        auto copiedString = copied ? copy->getString<RawString>(stringId) : std::nullopt;
+        bool stringKept = copiedString && *copiedString == "Arena copy test";
+        if ( copied )
+        {
+            copy->setTile(4, 5, u16(0x789));
+            copy->addString<RawString>("Added after the arena was released");
+        }
+        bool edited = copied && copy->write(editedChk) && reloaded.read(editedChk.data(), editedChk.size()) &&
+            reloaded.getTile(2, 3, Chk::StrScope::Game) == 0x456 && reloaded.getTile(4, 5, Chk::StrScope::Game) == 0x789;
+
+        bool copyMatches = copied && copyChk == reserializedChk(chk);
+
+        if ( !copied || !copyMatches || terrainOnlyChk != chk || !stringKept || !edited )
+        {
+            ++failCount;
+            std::cout << "FAIL - Arena copy test - tileset " << tilesetIndex << (copied ? "" : " failed to load, copy or write")
+                << (copyMatches ? "" : " copy's chk differs") << (terrainOnlyChk == chk ? "" : " terrain only copy's chk differs")
+                << (stringKept ? "" : " string lost") << (edited ? "" : " edits not written") << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Arena copy tests - " << (Sc::Terrain::NumTilesets - failCount) << " / "
+        << Sc::Terrain::NumTilesets << " scenarios copied out of a released arena" << std::endl;
+}
+
+// Counts the allocations made through it before passing them on to upstream
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream) : upstream(upstream) {}
+    size_t allocations = 0;
+
+private:
+    std::pmr::memory_resource* upstream;
+
+    void* do_allocate(size_t bytes, size_t alignment) override { ++allocations; return upstream->allocate(bytes, alignment); }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override { upstream->deallocate(p, bytes, alignment); }
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override { return this == &other; }
+};
+
+// Loads maps with many strings through MapFile into a counting arena while the default resource counts too, every loaded string must lie in the arena
+// & none may be allocated from the default resource; copies & moves of a loaded string must stay in the arena
+void arenaStringTest()
+{
+    constexpr size_t totalStrings = 500;
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<Sc::Terrain::NumTilesets; ++tilesetIndex )
+    {
+        MapFile map(Sc::Terrain::Tileset(tilesetIndex), 64, 64);
+        map.setSaveType(SaveType::ExpansionChk);
+        for ( size_t i=0; i<totalStrings; ++i )
+            map.addString<RawString>("Arena string " + std::to_string(i), i%2 == 0 ? Chk::StrScope::Game : Chk::StrScope::Editor);
+
+        std::filesystem::path chkPath = std::filesystem::temp_directory_path() / ("isom-arena-string-test-" + std::to_string(tilesetIndex) + ".chk");
+        bool saved = map.save(chkPath.string());
+
+        std::vector<std::byte> arenaBuffer(size_t(1) << 20);
+        std::pmr::monotonic_buffer_resource arena(arenaBuffer.data(), arenaBuffer.size(), std::pmr::null_memory_resource());
+        CountingResource countingArena(&arena);
+        CountingResource countingDefault(std::pmr::get_default_resource());
+        size_t loadedStrings = 0;
+        size_t stringsOutsideArena = 0;
+        size_t defaultAllocations = 0;
+        bool copiesInArena = false;
+        auto isInArena = [&](const char* str) { return (const std::byte*)str >= arenaBuffer.data() && (const std::byte*)str < arenaBuffer.data() + arenaBuffer.size(); };
+        if ( saved )
+        {
+            std::pmr::memory_resource* defaultResource = std::pmr::set_default_resource(&countingDefault);
+            MapFile loaded(chkPath.string(), nullptr, &countingArena);
+            std::pmr::set_default_resource(defaultResource);
+            defaultAllocations = countingDefault.allocations;
+            for ( auto* stringList : {&loaded.strings, &loaded.editorStrings} )
+            {
+                for ( const auto & str : *stringList )
+                {
+                    if ( str )
+                    {
+                        ++loadedStrings;
+                        if ( !isInArena(str->str) )
+                            ++stringsOutsideArena;
+                    }
+                }
+            }
+            if ( loaded.strings.size() > 1 && loaded.strings[1] )
+            {
+                ScStr copy(*loaded.strings[1]);
+                ScStr moved(std::move(copy));
+                copiesInArena = isInArena(moved.str) && std::strcmp(moved.str, loaded.strings[1]->str) == 0;
+            }
+        }
+        std::filesystem::remove(chkPath);
+
+        if ( !saved || loadedStrings < totalStrings || stringsOutsideArena > 0 || countingArena.allocations < loadedStrings || defaultAllocations > 0 || !copiesInArena )
+        {
+            ++failCount;
+            std::cout << "FAIL - Arena string test - tileset " << tilesetIndex << (saved ? "" : " failed to save") << (copiesInArena ? "" : " copy left the arena")
+                << " - " << loadedStrings << " / " << totalStrings << " strings loaded, " << stringsOutsideArena << " outside the arena, "
+                << countingArena.allocations << " arena & " << defaultAllocations << " default resource allocations" << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Arena string tests - " << (Sc::Terrain::NumTilesets - failCount) << " / "
+        << Sc::Terrain::NumTilesets << " maps loaded with every string in the arena" << std::endl;
+}
+
+// Saves maps as .chksnap files & opens them through MapFile whole & terrain only (parsed in place from the mapping), then saves the terrain only map
+// over the snapshot it's viewing, terrain only loads must write back the chk of the map that was saved & whole loads that chk re-serialized
+void snapshotFileTest()
+{
+    size_t failCount = 0;
+    for ( size_t tilesetIndex=0; tilesetIndex<Sc::Terrain::NumTilesets; ++tilesetIndex )
+    {
+        std::filesystem::path snapshotPath = std::filesystem::temp_directory_path() / ("isom-snapshot-file-test-" + std::to_string(tilesetIndex) + MapFile::SnapshotExtension);
+        MapFile map(Sc::Terrain::Tileset(tilesetIndex), 64, 64);
+        map.setTile(2, 3, u16(0x456));
+        map.addString<RawString>("Snapshot file test");
+        std::vector<u8> chk {};
+        bool saved = map.save(snapshotPath.string()) && map.getFilePath() == snapshotPath.string() && map.write(chk);
+
+        std::vector<u8> fullChk {};
+        std::vector<u8> terrainOnlyChk {};
+        MapFile full(snapshotPath.string());
+        MapFile terrainOnly(snapshotPath.string(), &Scenario::terrainSections);
+        bool loaded = saved && full.getFilePath() == snapshotPath.string() && terrainOnly.getFilePath() == snapshotPath.string() &&
+            full.write(fullChk) && terrainOnly.write(terrainOnlyChk);
+        bool mappingKept = !full.isFileMapped() && terrainOnly.isFileMapped();
+        bool terrainRead = loaded && full.getTile(2, 3, Chk::StrScope::Game) == 0x456 && terrainOnly.getTile(2, 3, Chk::StrScope::Game) == 0x456;
+
+        std::vector<u8> resavedChk {};
+        bool resaved = loaded && terrainOnly.saveSnapshot(snapshotPath.string()) && !terrainOnly.isFileMapped();
+        MapFile reloaded(snapshotPath.string(), &Scenario::terrainSections);
+        resaved = resaved && reloaded.write(resavedChk) && resavedChk == chk;
+        bool fullMatches = loaded && fullChk == reserializedChk(chk);
+        std::filesystem::remove(snapshotPath);
+
+        if ( !loaded || !mappingKept || !terrainRead || !fullMatches || terrainOnlyChk != chk || !resaved )
+        {
+            ++failCount;
+            std::cout << "FAIL - Snapshot file test - tileset " << tilesetIndex << (loaded ? "" : " failed to save, load or write")
+                << (mappingKept ? "" : " mapping kept or released wrongly") << (terrainRead ? "" : " terrain not read")
+                << (fullMatches ? "" : " fully parsed chk differs") << (terrainOnlyChk == chk ? "" : " terrain only chk differs")
+                << (resaved ? "" : " saving over the mapped snapshot failed") << std::endl;
+        }
+    }
+    std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << "Snapshot file tests - " << (Sc::Terrain::NumTilesets - failCount) << " / "
+        << Sc::Terrain::NumTilesets << " maps round tripped through .chksnap files" << std::endl;
+}
+
+void runTests()
+{
+    auto mapDir = getTestMapDirectory();
+    std::vector<RegressionTest> tests {};
+    addNewMapTests(mapDir, tests);
+    addResizeMapTests(mapDir, tests);
+    addEditMapTests(mapDir, tests);
+
+    // Idle workers pull the next queued test so long resize/edit tests don't hold up the rest, results stay in test order
+    std::vector<TestResult> results(tests.size());
+    auto start = std::chrono::steady_clock::now();
+    threadPool.parallelFor(tests.size(), [&](size_t i) {
+        auto testStart = std::chrono::steady_clock::now();
+        try {
+            tests[i].run(results[i]);
+        } catch ( std::exception & e ) {
+            results[i].fail() << tests[i].group << " test error - " << tests[i].name << " - " << e.what() << std::endl;
+        }
+        results[i].wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - testStart).count();
+    });
+    auto finish = std::chrono::steady_clock::now();
+
+    std::vector<std::string> groups {};
+    std::unordered_map<std::string, std::pair<size_t, size_t>> groupPassFailCounts {};
+    for ( size_t i=0; i<tests.size(); ++i )
+    {
+        if ( groups.empty() || groups.back() != tests[i].group )
+        {
+            if ( !groups.empty() )
+                std::cout << "-----------------------------------------------------------------------" << std::endl;
+
+            groups.push_back(tests[i].group);
+        }
+        std::cout << results[i].output.str()
+            << "TIME - " << tests[i].group << " - " << tests[i].name << " - " << std::fixed << std::setprecision(1) << results[i].wallMs << "ms" << std::endl;
+
+        auto & passFailCount = groupPassFailCounts[tests[i].group];
+        passFailCount.first += results[i].passCount;
+        passFailCount.second += results[i].failCount;
+    }
+    std::cout << "-----------------------------------------------------------------------" << std::endl;
+
+    for ( const auto & group : groups )
+    {
+        auto [passCount, failCount] = groupPassFailCounts[group];
+        std::cout << (failCount == 0 ? "PASS - " : "FAIL - ") << group << " tests - " << passCount << " / " << (passCount + failCount) << std::endl;
+    }
+    std::cout << "Ran " << tests.size() << " tests on " << threadPool.size() << " threads in "
+        << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::milli>(finish - start).count() << "ms" << std::endl;
 }
 
 void linkTableGenTest()
@@ -1185,11 +1884,28 @@ void linkTableGenTest()
         std::cout << "All looks perfect" << std::endl;
 }
 
-void testMain()
+void testMain(const std::string & starCraftDirectory)
 {
-    std::string starcraftPath = "C:\\Program Files (x86)\\StarCraft";
-
-    terrainDat.load(starcraftPath);
+    concurrentEditTest();
+    concurrentLogTest();
+    journalReplayTest();
+    reconstructIsomTest();
+    validateRepairTest();
+    floodFillTest();
+    convertTilesetTest();
+    isomStampTest();
+    sectionMaskTest();
+    dirtySectionTest();
+    sectionDirectoryTest();
+    snapshotTest();
+    mappedFileTest();
+    mappedLoadTest();
+    saveAsyncTest();
+    arenaCopyTest();
+    arenaStringTest();
+    snapshotFileTest();
+
+    terrainDat.load(starCraftDirectory);
 
     runTests();
     
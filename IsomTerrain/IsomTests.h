@@ -1,6 +1,7 @@
 #ifndef ISOMTESTS_H
 #define ISOMTESTS_H
+#include <string>
 
-void testMain();
+void testMain(const std::string & starCraftDirectory);
 
 #endif
\ No newline at end of file
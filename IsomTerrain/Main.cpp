@@ -1,7 +1,8 @@
 #include "IsomTests.h"
 
-int main()
+// Usage: IsomTerrain [starCraftDirectory]
+int main(int argc, char* argv[])
 {
-    testMain();
+    testMain(argc > 1 ? argv[1] : "C:\\Program Files (x86)\\StarCraft");
     return 0;
 }
@@ -1055,14 +1055,6 @@ const Chk::Trigger::Owned & Chk::Trigger::owned(size_t ownerIndex) const
         throw std::out_of_range("ownerIndex " + std::to_string(ownerIndex) + " exceeds max " + std::to_string(MaxOwners-1));
 }
 
-Chk::Trigger & Chk::Trigger::operator=(const Trigger & trigger)
-{
-    if ( this != &trigger )
-        memcpy(this, &trigger, sizeof(Trigger));
-
-    return *this;
-}
-
 void Chk::Trigger::deleteAction(size_t actionIndex, bool alignTop)
 {
     if ( actionIndex < MaxActions )
@@ -1688,52 +1680,96 @@ StrProp::StrProp(u8 red, u8 green, u8 blue, u32 size, bool isUsed, bool hasPrior
 
 }
 
-ScStr::ScStr() : strProp()
+ScStr::ScStr() : ScStr("", 0, std::pmr::get_default_resource())
 {
-    allocation.push_back('\0');
-    this->str = &allocation[0];
+
 }
 
-ScStr::ScStr(const std::string & str) : strProp()
+ScStr::ScStr(const std::string & str) : ScStr(str.c_str(), str.size(), std::pmr::get_default_resource())
 {
-    for ( const char & c : str )
-        allocation.push_back(c);
 
-    if ( allocation.size() == 0 || allocation.back() != '\0' )
-        allocation.push_back('\0');
+}
 
-    this->str = &allocation[0];
+ScStr::ScStr(const std::string & str, const StrProp & strProp) : ScStr(str.c_str(), str.size(), std::pmr::get_default_resource())
+{
+    this->strProp = strProp;
 }
 
-ScStr::ScStr(const std::string & str, const StrProp & strProp) : strProp(strProp)
+ScStr::ScStr(const char* str) : ScStr(str, strlen(str), std::pmr::get_default_resource())
 {
-    for ( const char & c : str )
-        allocation.push_back(c);
 
-    if ( allocation.size() == 0 || allocation.back() != '\0' )
-        allocation.push_back('\0');
+}
+
+ScStr::ScStr(const u8* str) : ScStr((const char*)str, strlen((const char*)str), std::pmr::get_default_resource())
+{
+
+}
+
+ScStr::ScStr(const u8* str, size_t length) : ScStr((const char*)str, length, std::pmr::get_default_resource())
+{
 
-    this->str = &allocation[0];
 }
 
-ScStr::ScStr(const char* str) : ScStr(std::string(str))
+ScStr::ScStr(const std::vector<u8> & strBytes) : ScStr((const char*)strBytes.data(), strBytes.size(), std::pmr::get_default_resource())
 {
 
 }
 
-ScStr::ScStr(const u8* str) : ScStr(std::string((const char*)str))
+ScStr::ScStr(const char* str, size_t length, std::pmr::memory_resource* memoryResource) : allocation(memoryResource), strProp()
 {
+    bool terminated = length > 0 && str[length-1] == '\0';
+    allocation.reserve(terminated ? length : length+1);
+    allocation.assign(str, str+length);
+    if ( !terminated )
+        allocation.push_back('\0');
 
+    this->str = &allocation[0];
 }
 
-ScStr::ScStr(const u8* str, size_t length) : ScStr(std::string((const char*)str, length))
+ScStr::ScStr(const ScStr & other) : allocation(other.str, other.str+other.length()+1, other.allocation.get_allocator()), strProp(other.strProp)
 {
+    this->str = &allocation[0];
+}
+
+ScStr::ScStr(ScStr && other) noexcept :
+    str(other.str), parentStr(other.parentStr), childStr(other.childStr), allocation(std::move(other.allocation)), strProp(other.strProp)
+{
+    if ( parentStr != nullptr ) // Characters viewed in parentStr stay where they are, this replaces other as parentStr's child
+        parentStr->childStr = this;
+    if ( childStr != nullptr )
+        childStr->parentStr = this;
 
+    other.str = "";
+    other.parentStr = nullptr;
+    other.childStr = nullptr;
 }
 
-ScStr::ScStr(const std::vector<u8> & strBytes) : ScStr(std::string((const char*)&strBytes[0], strBytes.size()))
+ScStr & ScStr::operator=(const ScStr & other)
 {
+    if ( this != &other )
+    {
+        std::pmr::vector<char> copy(other.str, other.str+other.length()+1, allocation.get_allocator()); // other may point into this allocation
+        disown();
+        allocation.swap(copy);
+        strProp = other.strProp;
+        this->str = &allocation[0];
+    }
+    return *this;
+}
 
+ScStr & ScStr::operator=(ScStr && other)
+{
+    if ( this != &other )
+    {
+        if ( other.allocation.empty() ) // other's characters are in its parent string
+            return *this = static_cast<const ScStr &>(other);
+
+        disown();
+        allocation = std::move(other.allocation); // Characters are copied rather than moved if the two use different memory resources
+        strProp = other.strProp;
+        this->str = &allocation[0];
+    }
+    return *this;
 }
 
 bool ScStr::empty() const
@@ -6,6 +6,7 @@
 #include "Sc.h"
 #include <bitset>
 #include <map>
+#include <memory_resource>
 
 #undef PlaySound
 
@@ -898,7 +899,6 @@ namespace Chk {
         const Action & action(size_t actionIndex) const;
         Owned & owned(size_t ownerIndex);
         const Owned & owned(size_t ownerIndex) const;
-        Trigger & operator= (const Trigger & trigger);
         void deleteAction(size_t actionIndex, bool alignTop = true);
         void deleteCondition(size_t conditionIndex, bool alignTop = true);
         
@@ -1638,6 +1638,32 @@ namespace Chk {
         ChkHeader header;
         u8 data[1]; // u8 data[sizeInBytes]
     };
+
+    constexpr u32 CHKS = 1397442627; // "CHKS" = 43|48|4B|53
+    constexpr u16 SnapshotVersion = 1;
+    constexpr size_t SnapshotAlignment = 16; // Section data in a snapshot starts at multiples of this
+
+    __declspec(align(1)) struct SnapshotHeader { // Not used by a Scenario.chk file, begins a snapshot written by Scenario::writeSnapshot
+        enum_t(Flags, u16, {
+            JumpCompress = BIT_0,
+            Protected = BIT_1
+        });
+
+        u32 name; // Set to CHKS
+        u16 version; // Set to SnapshotVersion
+        Flags flags;
+        u32 sectionCount; // The number of SnapshotSections following the header
+        u32 unused;
+        Size sizeInBytes; // Size of the whole snapshot
+        u8 tailLength;
+        u8 tailData[7]; // The bytes after the last section of the chk
+    }; // 32 (0x20) bytes
+
+    __declspec(align(1)) struct SnapshotSection {
+        SectionName name;
+        SectionSize sizeInBytes;
+        Size offset; // Offset of the section's data from the start of the snapshot
+    }; // 16 (0x10) bytes
     
     std::ostream & operator<< (std::ostream & out, const Unit & unit);
     std::ostream & operator<< (std::ostream & out, const IsomRect & isomRect);
@@ -1804,8 +1830,15 @@ namespace Chk {
             ScStr(const u8* str);
             ScStr(const u8* str, size_t length);
             ScStr(const std::vector<u8> & strBytes);
+            ScStr(const char* str, size_t length, std::pmr::memory_resource* memoryResource); // Characters are copied into a single allocation from memoryResource
             template <size_t N> ScStr(const char (&str)[N]) : ScStr(std::string(str)) {}
 
+            // Copies & assigned strings hold their own characters (from the source's memory resource) rather than pointing into the source or its parent
+            ScStr(const ScStr & other);
+            ScStr(ScStr && other) noexcept; // Takes over the source's characters & its place among parent & child strings
+            ScStr & operator=(const ScStr & other);
+            ScStr & operator=(ScStr && other);
+
             bool empty() const;
             size_t length() const;
         
@@ -1826,7 +1859,7 @@ namespace Chk {
         private:
             ScStr* parentStr = nullptr; // The larger string inside which this string fits, if null then this is a root string
             ScStr* childStr = nullptr; // The next largest string that fits inside this string
-            std::vector<char> allocation; // If parentStr is null, then this is the actual string data and str points to the first character
+            std::pmr::vector<char> allocation; // If parentStr is null, then this is the actual string data and str points to the first character
                                           // else str points to first character of this string within the allocation of the highest-order parent
             StrProp strProp; // Additional color and font details, if this string is extended and gets stored
 
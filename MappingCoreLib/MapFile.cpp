@@ -1,4 +1,6 @@
 #include "../CrossCutLib/Logger.h"
+#include "../CrossCutLib/ThreadPool.h"
+#include "../CrossCutLib/Tracer.h"
 #include <SimpleIcu.h>
 #include "MapFile.h"
 #include "SystemIO.h"
@@ -6,6 +8,8 @@
 #include <cstdio>
 #include <cstdarg>
 #include <fstream>
+#include <iterator>
+#include <mutex>
 #include <sstream>
 #include <chrono>
 
@@ -27,10 +31,16 @@ FileBrowserPtr<SaveType> MapFile::getDefaultSaveMapBrowser()
     return FileBrowserPtr<SaveType>(new FileBrowser<SaveType>(getSaveMapFilters(), "Save Map", false, true));
 }
 
-MapFile::MapFile(const std::string & filePath) :
-    saveType(SaveType::Unknown), mapFilePath(""), temporaryMpqPath(""), temporaryMpq(true, true)
+MapFile::MapFile(const std::string & filePath, const SectionMask* sectionsToParse) :
+    MapFile(filePath, sectionsToParse, std::pmr::get_default_resource())
+{
+
+}
+
+MapFile::MapFile(const std::string & filePath, const SectionMask* sectionsToParse, std::pmr::memory_resource* memoryResource, bool reuseCleanSections) :
+    Scenario(memoryResource), saveType(SaveType::Unknown), mapFilePath(""), temporaryMpqPath(""), temporaryMpq(true, true)
 {
-    load(filePath);
+    load(filePath, sectionsToParse, reuseCleanSections);
 }
 
 MapFile::MapFile(FileBrowserPtr<SaveType> fileBrowser) :
@@ -42,8 +52,8 @@ MapFile::MapFile(FileBrowserPtr<SaveType> fileBrowser) :
 MapFile::MapFile(Sc::Terrain::Tileset tileset, u16 width, u16 height)
     : Scenario(tileset, width, height), saveType(SaveType::HybridScm), mapFilePath(""), temporaryMpqPath(""), temporaryMpq(true, true)
 {
-    if ( MapFile::virtualSoundTable.size() == 0 )
-    {
+    static std::once_flag virtualSoundTableFilled {}; // Maps may be created on several threads at once
+    std::call_once(virtualSoundTableFilled, []() {
         size_t numVirtualSounds = Sc::Sound::virtualSoundPaths.size();
         for ( size_t i=0; i<numVirtualSounds; i++ )
         {
@@ -51,28 +61,71 @@ MapFile::MapFile(Sc::Terrain::Tileset tileset, u16 width, u16 height)
             size_t hash = strHash(soundPath);
             virtualSoundTable.insert(std::pair<size_t, std::string>(hash, soundPath));
         }
-    }
+    });
 }
 
 MapFile::~MapFile()
 {
+    waitForPendingSave();
+}
+
+void MapFile::waitForPendingSave()
+{
+    if ( pendingSave.valid() )
+    {
+        if ( pendingSave.get() ) // As with save the map's path only changes once the save succeeds
+            mapFilePath = pendingSaveFilePath;
+
+        pendingSave = {};
+    }
+}
+
+// Saves run one at a time in the order they were started on a single background thread
+static ThreadPool & getSaveThread()
+{
+    static ThreadPool saveThread(1);
+    return saveThread;
+}
+
+static bool isMpqSaveType(SaveType saveType)
+{
+    return saveType == SaveType::StarCraftScm || saveType == SaveType::HybridScm ||
+        saveType == SaveType::ExpansionScx || saveType == SaveType::RemasteredScx || saveType == SaveType::AllMaps;
+}
 
+static bool changeVersionToSaveType(Scenario & scenario, SaveType saveType, bool lockAnywhere, bool autoDefragmentLocations)
+{
+    if ( saveType == SaveType::StarCraftScm || saveType == SaveType::StarCraftChk ) // StarCraft Map, edit to match
+        return scenario.changeVersionTo(Chk::Version::StarCraft_Original, lockAnywhere, autoDefragmentLocations);
+    else if ( saveType == SaveType::HybridScm || saveType == SaveType::HybridChk ) // Hybrid Map, edit to match
+        return scenario.changeVersionTo(Chk::Version::StarCraft_Hybrid, lockAnywhere, autoDefragmentLocations);
+    else if ( saveType == SaveType::ExpansionScx || saveType == SaveType::ExpansionChk || saveType == SaveType::AllMaps ) // BroodWar Map, edit to match
+        return scenario.changeVersionTo(Chk::Version::StarCraft_BroodWar, lockAnywhere, autoDefragmentLocations);
+    else if ( saveType == SaveType::RemasteredScx || saveType == SaveType::RemasteredChk ) // Remastered Map, edit to match
+        return scenario.changeVersionTo(Chk::Version::StarCraft_Remastered, lockAnywhere, autoDefragmentLocations);
+    else
+        return true;
 }
 
-bool MapFile::load(const std::string & filePath)
+bool MapFile::load(const std::string & filePath, const SectionMask* sectionsToParse, bool reuseCleanSections)
 {
-    return !filePath.empty() && openMapFile(filePath);
+    return !filePath.empty() && openMapFile(filePath, sectionsToParse, reuseCleanSections);
 }
 
 bool MapFile::load(FileBrowserPtr<SaveType> fileBrowser)
 {
     std::string browseFilePath = "";
     SaveType saveType;
-    return fileBrowser != nullptr && fileBrowser->browseForOpenPath(browseFilePath, saveType) && openMapFile(browseFilePath);
+    return fileBrowser != nullptr && fileBrowser->browseForOpenPath(browseFilePath, saveType) && openMapFile(browseFilePath, nullptr);
 }
 
 bool MapFile::save(const std::string & saveFilePath, bool overwriting, bool updateListFile, bool lockAnywhere, bool autoDefragmentLocations)
 {
+    TraceSpan traceSpan("MapFile::save");
+    waitForPendingSave(); // A background save may still be writing this or the previous path
+    if ( getSystemFileExtension(saveFilePath) == SnapshotExtension )
+        return saveSnapshot(saveFilePath);
+
     bool savePathChanged = saveFilePath.compare(mapFilePath) != 0;
     bool saveAs = !mapFilePath.empty() && savePathChanged;
 
@@ -80,19 +133,15 @@ bool MapFile::save(const std::string & saveFilePath, bool overwriting, bool upda
         CHKD_ERR("Cannot save protected maps!");
     else if ( !saveFilePath.empty() )
     {
+        if ( mappedChk.isOpen() ) // Sections still viewed in the mapped .chk are copied out as the save may replace that file
+        {
+            Scenario::copyViewedSections();
+            mappedChk.close();
+        }
+
         logger.info() << "Saving to: " << saveFilePath << " with saveType: \"" << saveTypeToStr(saveType) << "\"" << std::endl;
         auto start = std::chrono::high_resolution_clock::now();
-        bool versionCorrect = true;
-        if ( saveType == SaveType::StarCraftScm || saveType == SaveType::StarCraftChk ) // StarCraft Map, edit to match
-            versionCorrect = Scenario::changeVersionTo(Chk::Version::StarCraft_Original);
-        else if ( saveType == SaveType::HybridScm || saveType == SaveType::HybridChk ) // Hybrid Map, edit to match
-            versionCorrect = Scenario::changeVersionTo(Chk::Version::StarCraft_Hybrid);
-        else if ( saveType == SaveType::ExpansionScx || saveType == SaveType::ExpansionChk || saveType == SaveType::AllMaps ) // BroodWar Map, edit to match
-            versionCorrect = Scenario::changeVersionTo(Chk::Version::StarCraft_BroodWar);
-        else if ( saveType == SaveType::RemasteredScx || saveType == SaveType::RemasteredChk || saveType == SaveType::AllMaps ) // Remastered Map, edit to match
-            versionCorrect = Scenario::changeVersionTo(Chk::Version::StarCraft_Remastered);
-
-        if ( !versionCorrect )
+        if ( !changeVersionToSaveType(*this, saveType, lockAnywhere, autoDefragmentLocations) )
         {
             logger.error("Failed to update version, save failed!");
             return false;
@@ -100,8 +149,7 @@ bool MapFile::save(const std::string & saveFilePath, bool overwriting, bool upda
 
         updateSaveSections();
 
-        if ( (saveType == SaveType::StarCraftScm || saveType == SaveType::HybridScm ||
-              saveType == SaveType::ExpansionScx || saveType == SaveType::RemasteredScx) || saveType == SaveType::AllMaps ) // Must be packed into an MPQ
+        if ( isMpqSaveType(saveType) ) // Must be packed into an MPQ
         {
             if ( savePathChanged && overwriting && !::removeFile(saveFilePath) )
             {
@@ -111,9 +159,8 @@ bool MapFile::save(const std::string & saveFilePath, bool overwriting, bool upda
 
             if ( !saveAs || (saveAs && (!MpqFile::isValid(mapFilePath) || makeFileCopy(mapFilePath, saveFilePath))) ) // If using save-as and existing is mpq, copy mpq to the new location
             {
-                std::stringstream chk(std::ios_base::in|std::ios_base::out|std::ios_base::binary);
-                Scenario::write(chk);
-                if ( chk.good() )
+                std::vector<u8> chk {};
+                if ( Scenario::write(chk) )
                 {
                     if ( MpqFile::open(saveFilePath, false, true) )
                     {
@@ -172,6 +219,99 @@ bool MapFile::save(const std::string & saveFilePath, bool overwriting, bool upda
     return false;
 }
 
+std::shared_future<bool> MapFile::saveAsync(const std::string & saveFilePath, bool overwriting, bool updateListFile, bool lockAnywhere, bool autoDefragmentLocations)
+{
+    auto finished = [](bool result) {
+        std::promise<bool> promise {};
+        promise.set_value(result);
+        return promise.get_future().share();
+    };
+
+    if ( isProtected() )
+    {
+        CHKD_ERR("Cannot save protected maps!");
+        return finished(false);
+    }
+    else if ( saveFilePath.empty() )
+        return finished(false);
+    else if ( getSystemFileExtension(saveFilePath) == SnapshotExtension ) // Snapshots aren't compressed or converted, leaving little to move off this thread
+        return finished(saveSnapshot(saveFilePath));
+    else if ( !modifiedAssets.empty() ) // Asset changes are staged in the temporary MPQ owned by this map, they're written by a regular save
+        return finished(save(saveFilePath, overwriting, updateListFile, lockAnywhere, autoDefragmentLocations));
+
+    waitForPendingSave(); // The previous save decides which path this save is relative to
+    if ( mappedChk.isOpen() ) // The snapshot must not view the mapped .chk as the save may replace that file
+    {
+        Scenario::copyViewedSections();
+        mappedChk.close();
+    }
+
+    // The snapshot is a copy of the scenario's fields made on this thread, version conversion & serialization happen on the save thread
+    // It allocates from the default resource as the save thread frees it, the resource this map was read into needn't be thread safe
+    auto snapshot = std::make_shared<Scenario>(static_cast<const Scenario &>(*this), std::pmr::get_default_resource());
+    std::string previousFilePath = mapFilePath;
+    bool savePathChanged = saveFilePath.compare(mapFilePath) != 0;
+    bool saveAs = !mapFilePath.empty() && savePathChanged;
+    SaveType saveType = this->saveType;
+    pendingSaveFilePath = saveFilePath;
+
+    logger.info() << "Saving in the background to: " << saveFilePath << " with saveType: \"" << saveTypeToStr(saveType) << "\"" << std::endl;
+    pendingSave = getSaveThread().submit([=]() {
+        TraceSpan traceSpan("MapFile::saveAsync");
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<u8> chk {};
+        if ( !changeVersionToSaveType(*snapshot, saveType, lockAnywhere, autoDefragmentLocations) )
+        {
+            logger.error("Failed to update version, save failed!");
+            return false;
+        }
+        snapshot->updateSaveSections();
+        if ( !snapshot->write(chk) )
+        {
+            logger.error("Failed to compile the scenario file!");
+            return false;
+        }
+
+        bool success = false;
+        if ( isMpqSaveType(saveType) )
+        {
+            MpqFile mpq(false, updateListFile);
+            if ( savePathChanged && overwriting && !::removeFile(saveFilePath) )
+                logger.error() << "Failed to delete old file being overwritten: \"" << saveFilePath << "\"" << std::endl;
+            else if ( saveAs && mpq.isValid(previousFilePath) && !makeFileCopy(previousFilePath, saveFilePath) ) // Keep the existing mpq's assets
+                logger.error() << "Failed to copy \"" << previousFilePath << "\" to \"" << saveFilePath << "\"" << std::endl;
+            else if ( !mpq.open(saveFilePath, false, true) )
+                logger.error("Failed to create the new MPQ file!");
+            else
+            {
+                success = mpq.addFile("staredit\\scenario.chk", chk);
+                if ( !success )
+                    logger.error("Failed to add scenario file!");
+
+                mpq.close();
+            }
+        }
+        else if ( ::removeFile(saveFilePath) ) // Is a chk file or unrecognized format, write out chk file
+        {
+            std::ofstream outFile(icux::toFilestring(saveFilePath).c_str(), std::ios_base::out|std::ios_base::binary);
+            outFile.write(reinterpret_cast<const char*>(chk.data()), std::streamsize(chk.size()));
+            success = outFile.good();
+            if ( !success )
+                logger.error("Failed to write scenario file!");
+        }
+        else
+            logger.error("Failed to create the new map file!");
+
+        if ( success )
+        {
+            auto finish = std::chrono::high_resolution_clock::now();
+            logger.info() << "Successfully saved to: " << saveFilePath << " with saveType: \"" << saveTypeToStr(saveType) << "\" in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
+        }
+        return success;
+    }).share();
+    return pendingSave;
+}
+
 bool isChkSaveType(SaveType saveType)
 {
     return saveType == SaveType::AllChk || saveType == SaveType::RemasteredChk ||
@@ -270,8 +410,10 @@ bool MapFile::openTemporaryMpq()
     return false;
 }
 
-bool MapFile::openMapFile(const std::string & filePath)
+bool MapFile::openMapFile(const std::string & filePath, const SectionMask* sectionsToParse, bool reuseCleanSections)
 {
+    TraceSpan traceSpan("MapFile::openMapFile");
+    waitForPendingSave();
     logger.info() << "Opening map file: " << filePath << std::endl;
     auto start = std::chrono::high_resolution_clock::now();
     std::string extension = getSystemFileExtension(filePath);
@@ -286,10 +428,9 @@ bool MapFile::openMapFile(const std::string & filePath)
                 {
                     MpqFile::close();
 
-                    std::stringstream chk(std::ios_base::in|std::ios_base::out|std::ios_base::binary);
-                    std::copy(chkData->begin(), chkData->end(), std::ostream_iterator<u8>(chk));
-                    if ( Scenario::read(chk) )
+                    if ( Scenario::read(chkData->data(), chkData->size(), sectionsToParse, false, reuseCleanSections) )
                     {
+                        mappedChk.close(); // Nothing views a previously opened .chk anymore
                         if ( Scenario::isOriginal() )
                             saveType = SaveType::StarCraftScm; // Vanilla
                         else if ( Scenario::isHybrid() )
@@ -317,9 +458,23 @@ bool MapFile::openMapFile(const std::string & filePath)
         else if ( extension == ".chk" )
         {
             this->mapFilePath = filePath;
-            std::ifstream chk(filePath, std::ios_base::binary|std::ios_base::in);
-            if ( Scenario::read(chk) )
+            MappedFile mappedFile {};
+            bool parsed = false;
+            if ( mappedFile.open(filePath) ) // Parse straight from the mapping, sections outside of sectionsToParse are left in it rather than copied
+                parsed = Scenario::read(mappedFile.data(), mappedFile.size(), sectionsToParse, true, reuseCleanSections);
+            else
             {
+                std::ifstream chk(filePath, std::ios_base::binary|std::ios_base::in);
+                parsed = Scenario::read(chk, sectionsToParse, reuseCleanSections);
+            }
+
+            if ( parsed )
+            {
+                if ( Scenario::hasViewedSections() ) // Keep the mapping only while unparsed sections view it, everything else was copied out
+                    mappedChk = std::move(mappedFile);
+                else
+                    mappedChk.close();
+
                 if ( Scenario::isOriginal() )
                     saveType = SaveType::StarCraftChk; // Vanilla chk
                 else if ( Scenario::isHybrid() )
@@ -336,12 +491,88 @@ bool MapFile::openMapFile(const std::string & filePath)
             else
                 CHKD_ERR("Parsing Failed!");
         }
+        else if ( extension == SnapshotExtension )
+        {
+            this->mapFilePath = filePath;
+            MappedFile mappedFile {};
+            bool parsed = false;
+            if ( mappedFile.open(filePath) ) // Parse straight from the mapping, sections outside of sectionsToParse are left in it rather than copied
+                parsed = Scenario::readSnapshot(mappedFile.data(), mappedFile.size(), sectionsToParse, true, reuseCleanSections);
+            else
+            {
+                std::ifstream snapshotFile(filePath, std::ios_base::binary|std::ios_base::in);
+                std::vector<u8> snapshot(std::istreambuf_iterator<char>(snapshotFile), std::istreambuf_iterator<char>{});
+                parsed = Scenario::readSnapshot(snapshot.data(), snapshot.size(), sectionsToParse, false, reuseCleanSections);
+            }
+
+            if ( parsed )
+            {
+                if ( Scenario::hasViewedSections() ) // Keep the mapping only while unparsed sections view it, everything else was copied out
+                    mappedChk = std::move(mappedFile);
+                else
+                    mappedChk.close();
+
+                if ( Scenario::isOriginal() ) // Snapshots are intermediate files, maps made from them are saved as MPQs by default
+                    saveType = SaveType::StarCraftScm;
+                else if ( Scenario::isHybrid() )
+                    saveType = SaveType::HybridScm;
+                else if ( Scenario::isExpansion() )
+                    saveType = SaveType::ExpansionScx;
+                else
+                    saveType = SaveType::RemasteredScx;
+
+                auto finish = std::chrono::high_resolution_clock::now();
+                logger.info() << "Map " << mapFilePath << " opened in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
+                return true;
+            }
+            else
+                CHKD_ERR("Parsing Failed!");
+        }
         else
             CHKD_ERR("Unrecognized Extension!");
     }
     return false;
 }
 
+bool MapFile::saveSnapshot(const std::string & snapshotFilePath)
+{
+    TraceSpan traceSpan("MapFile::saveSnapshot");
+    waitForPendingSave();
+    if ( isProtected() )
+    {
+        CHKD_ERR("Cannot save protected maps!");
+        return false;
+    }
+
+    if ( mappedChk.isOpen() ) // Sections still viewed in the mapped file are copied out as the save may replace that file
+    {
+        Scenario::copyViewedSections();
+        mappedChk.close();
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    updateSaveSections();
+    std::vector<u8> snapshot {};
+    if ( !Scenario::writeSnapshot(snapshot) )
+    {
+        CHKD_ERR("Failed to compile the scenario file!");
+        return false;
+    }
+
+    std::ofstream outFile(icux::toFilestring(snapshotFilePath).c_str(), std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+    outFile.write(reinterpret_cast<const char*>(snapshot.data()), std::streamsize(snapshot.size()));
+    if ( !outFile.good() )
+    {
+        CHKD_ERR("Failed to write snapshot file!");
+        return false;
+    }
+
+    mapFilePath = snapshotFilePath;
+    auto finish = std::chrono::high_resolution_clock::now();
+    logger.info() << "Successfully saved snapshot to: " << snapshotFilePath << " in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
+    return true;
+}
+
 bool MapFile::processModifiedAssets(bool updateListFile)
 {
     std::vector<std::vector<ModifiedAsset>::iterator> processedAssets;
@@ -756,14 +987,22 @@ bool MapFile::isInVirtualSoundList(const std::string & soundMpqPath) const
 
 std::string MapFile::getFileName() const
 {
-    return getSystemFileName(mapFilePath);
+    return getSystemFileName(getFilePath());
 }
 
 const std::string & MapFile::getFilePath() const
 {
+    if ( pendingSave.valid() && pendingSave.wait_for(std::chrono::seconds(0)) == std::future_status::ready && pendingSave.get() )
+        return pendingSaveFilePath; // A finished saveAsync that hasn't been waited on yet
+
     return mapFilePath;
 }
 
+bool MapFile::isFileMapped() const
+{
+    return mappedChk.isOpen();
+}
+
 bool MapFile::getSaveDetails(SaveType & saveType, std::string & saveFilePath, bool & overwriting, FileBrowserPtr<SaveType> fileBrowser) const
 {
     if ( fileBrowser != nullptr )
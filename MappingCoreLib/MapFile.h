@@ -3,6 +3,8 @@
 #include "Scenario.h"
 #include "FileBrowser.h"
 #include "MpqFile.h"
+#include "SystemIO.h"
+#include <future>
 #include <utility>
 #include <map>
 
@@ -24,7 +26,9 @@ enum class SoundStatus;
 class MapFile : public Scenario, public MpqFile // MapFile is a scenario file and usually an MpqFile
 {
     public:
-        MapFile(const std::string & filePath); // Load map at filePath
+        MapFile(const std::string & filePath, const SectionMask* sectionsToParse = nullptr); // Load map at filePath, see Scenario::read for sectionsToParse
+        MapFile(const std::string & filePath, const SectionMask* sectionsToParse, std::pmr::memory_resource* memoryResource, // As above, allocating strings & sections from memoryResource
+            bool reuseCleanSections = false); // See Scenario::read for reuseCleanSections
         MapFile(FileBrowserPtr<SaveType> fileBrowser); // Load map selected from browser, can use getDefaultOpenMapBrowser()
         MapFile(Sc::Terrain::Tileset tileset = Sc::Terrain::Tileset::Badlands, u16 width = 64, u16 height = 64); // Create new map
 
@@ -34,7 +38,19 @@ class MapFile : public Scenario, public MpqFile // MapFile is a scenario file an
         virtual bool save(bool saveAs = false, bool updateListFile = true, FileBrowserPtr<SaveType> fileBrowser = getDefaultSaveMapBrowser(),
             bool lockAnywhere = true, bool autoDefragmentLocations = true);
 
-        bool load(const std::string & filePath);
+        // Copies the scenario on this thread then converts, serializes & writes the copy on a background thread so editing can continue
+        // Edits made after this returns aren't included, the future gives the save's result & the map's file path becomes saveFilePath once it succeeds
+        // Pending MPQ asset changes can't be moved off this map so when there are any the save runs synchronously & the future is already set
+        std::shared_future<bool> saveAsync(const std::string & saveFilePath, bool overwriting = false, bool updateListFile = true,
+            bool lockAnywhere = true, bool autoDefragmentLocations = true);
+        void waitForPendingSave(); // Blocks until the last saveAsync has finished writing, called before anything else saves or loads this map
+
+        // Writes the scenario as a snapshot (see Scenario::writeSnapshot) in its current version, MPQ assets aren't included
+        // save & saveAsync write snapshots for paths ending in SnapshotExtension & load opens them, so pipeline stages skip MPQ packing & unpacking
+        bool saveSnapshot(const std::string & snapshotFilePath);
+        static constexpr char SnapshotExtension[] = ".chksnap";
+
+        bool load(const std::string & filePath, const SectionMask* sectionsToParse = nullptr, bool reuseCleanSections = false);
         bool load(FileBrowserPtr<SaveType> fileBrowser = getDefaultOpenMapBrowser());
 
         SaveType getSaveType();
@@ -61,6 +77,7 @@ class MapFile : public Scenario, public MpqFile // MapFile is a scenario file an
 
         std::string getFileName() const;
         virtual const std::string & getFilePath() const;
+        bool isFileMapped() const; // True while sections left unparsed by load are viewed in the memory mapped file the map was opened from
 
         static FileBrowserPtr<SaveType> getDefaultOpenMapBrowser();
         static FileBrowserPtr<SaveType> getDefaultSaveMapBrowser();
@@ -73,13 +90,16 @@ class MapFile : public Scenario, public MpqFile // MapFile is a scenario file an
         std::string temporaryMpqPath;
         MpqFile temporaryMpq;
         SaveType saveType;
+        MappedFile mappedChk; // The .chk or snapshot this map was opened from, mapped while sections left unparsed are viewed in it
         std::vector<ModifiedAsset> modifiedAssets; // A record of all MPQ assets changes since the last save
+        std::shared_future<bool> pendingSave {}; // The last saveAsync, if it may not have finished
+        std::string pendingSaveFilePath {}; // The path of the last saveAsync, becomes mapFilePath if that save succeeds
 
         static std::hash<std::string> strHash; // A hasher to help generate tables
         static std::map<size_t, std::string> virtualSoundTable;
         static u64 nextAssetFileId; // Changes are needed if this is accessed in a multi-threaded environment
 
-        bool openMapFile(const std::string & filePath);
+        bool openMapFile(const std::string & filePath, const SectionMask* sectionsToParse, bool reuseCleanSections = false);
         bool openTemporaryMpq();
         bool processModifiedAssets(bool updateListfile);
         
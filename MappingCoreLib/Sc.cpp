@@ -1,5 +1,6 @@
 #include "Sc.h"
 #include "../CrossCutLib/Logger.h"
+#include "../CrossCutLib/Tracer.h"
 #include "MpqFile.h"
 #include "CascArchive.h"
 #include <algorithm>
@@ -1727,6 +1728,7 @@ const Sc::Terrain::Tiles & Sc::Terrain::get(const Tileset & tileset) const
 
 bool Sc::Terrain::load(const std::vector<ArchiveFilePtr> & orderedSourceFiles)
 {
+    TraceSpan traceSpan("Sc::Terrain::load");
     auto start = std::chrono::high_resolution_clock::now();
     bool success = true;
     for ( size_t i=0; i<NumTilesets; i++ )
@@ -2,10 +2,14 @@
 #include "sha256.h"
 #include "Math.h"
 #include "../CrossCutLib/Logger.h"
+#include "../CrossCutLib/Tracer.h"
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <cstdio>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -19,6 +23,10 @@ extern Logger logger;
 using Chk::StrCompressFlag;
 using Member = RareTs::IndexOf<Scenario>;
 
+const Scenario::SectionMask Scenario::terrainSections {
+    SectionName::VER, SectionName::DIM, SectionName::ERA, SectionName::ISOM, SectionName::TILE, SectionName::MTXM
+};
+
 std::unordered_map<Chk::SectionName, size_t> sectionMemberIndex {
     {SectionName::TYPE, Member::type}, {SectionName::VER, Member::version}, {SectionName::IVER, Member::iVersion}, {SectionName::IVE2, Member::i2Version},
     {SectionName::VCOD, Member::validation}, {SectionName::IOWN, Member::iownSlotTypes}, {SectionName::OWNR, Member::slotTypes}, {SectionName::ERA, Member::tileset},
@@ -34,7 +42,12 @@ std::unordered_map<Chk::SectionName, size_t> sectionMemberIndex {
     {SectionName::KTGP, Member::triggerGroupings}
 };
 
-Scenario::Scenario() :
+Scenario::Scenario() : Scenario(std::pmr::get_default_resource())
+{
+
+}
+
+Scenario::Scenario(std::pmr::memory_resource* memoryResource) :
     playerRaces{
         Chk::Race::Terran  , Chk::Race::Zerg    , Chk::Race::Protoss , Chk::Race::Terran,
         Chk::Race::Zerg    , Chk::Race::Protoss , Chk::Race::Terran  , Chk::Race::Zerg,
@@ -54,9 +67,34 @@ Scenario::Scenario() :
         Sc::Player::SlotType::GameOpen, Sc::Player::SlotType::GameOpen, Sc::Player::SlotType::GameOpen, Sc::Player::SlotType::GameOpen,
         Sc::Player::SlotType::Inactive, Sc::Player::SlotType::Inactive, Sc::Player::SlotType::Inactive, Sc::Player::SlotType::Inactive
     },
-    dimensions({0, 0})
+    dimensions({0, 0}), saveSections(memoryResource), saveSectionIndex(memoryResource), cleanSectionBytes(memoryResource)
 {}
 
+Scenario::Scenario(const Scenario & other, std::pmr::memory_resource* memoryResource) : Scenario(memoryResource)
+{
+    *this = other; // Containers keep memoryResource, strings & unparsed section data copied from other's resources are re-allocated below
+    for ( auto* stringList : {&strings, &editorStrings} )
+    {
+        for ( auto & str : *stringList )
+        {
+            if ( str )
+            {
+                ScStr copy(str->str, str->length(), memoryResource);
+                copy.properties() = str->properties();
+                str.emplace(std::move(copy));
+            }
+        }
+    }
+    for ( auto & section : saveSections )
+    {
+        if ( section.sectionData )
+        {
+            std::pmr::vector<u8> sectionData(section.sectionData->begin(), section.sectionData->end(), memoryResource);
+            section.sectionData.emplace(std::move(sectionData));
+        }
+    }
+}
+
 Scenario::Scenario(Sc::Terrain::Tileset tileset, u16 width, u16 height) :
     playerRaces{
         Chk::Race::Terran  , Chk::Race::Zerg    , Chk::Race::Protoss , Chk::Race::Terran,
@@ -129,6 +167,7 @@ Scenario::Scenario(Sc::Terrain::Tileset tileset, u16 width, u16 height) :
         {Chk::SectionName::TECS}, {Chk::SectionName::SWNM}, {Chk::SectionName::COLR}, {Chk::SectionName::PUPx},
         {Chk::SectionName::PTEx}, {Chk::SectionName::UNIx}, {Chk::SectionName::UPGx}, {Chk::SectionName::TECx}
     });
+    indexSaveSections();
 }}
 
 void Scenario::clear()
@@ -204,6 +243,8 @@ void Scenario::clear()
     triggerGroupings.clear();
 
     saveSections.clear();
+    saveSectionIndex.clear();
+    cleanSectionBytes.clear();
 
     for ( size_t i=0; i<tailData.size(); i++ )
         tailData[i] = u8(0);
@@ -319,6 +360,27 @@ constexpr size_t size()
         return sizeof(T);
 }
 
+// True if T's in-memory layout is exactly its serialized layout: trivially copyable with every byte belonging to a reflected member, the
+// members in declaration order without padding (i.e. packed), such types are read & written with a single copy rather than member by member
+template <typename T>
+constexpr bool isBulkCopyable()
+{
+    if constexpr ( std::is_array_v<T> )
+        return isBulkCopyable<RareTs::element_type_t<T>>();
+    else if constexpr ( RareTs::has_begin_end_v<T> || !std::is_trivially_copyable_v<T> )
+        return false;
+    else if constexpr ( RareTs::is_reflected_v<T> )
+    {
+        return RareTs::Members<T>::pack([](auto ... member) {
+            size_t offset = 0;
+            bool contiguous = ((member.getOffset() == offset && (offset += ::size<typename decltype(member)::type>(), true)) && ...);
+            return contiguous && (isBulkCopyable<typename decltype(member)::type>() && ...) && offset == sizeof(T);
+        });
+    }
+    else
+        return true;
+}
+
 template <typename T, typename Value>
 constexpr s32 size(const Value & value)
 {
@@ -334,19 +396,29 @@ void read(std::istream & is, Value & value, std::streamsize sectionSize)
     if constexpr ( std::is_array_v<T> )
     {
         using Element = RareTs::element_type_t<T>;
-        for ( size_t i=0; i<std::extent_v<T>; i++ )
-            ::read<Element>(is, value[i], sectionSize);
-        //is.read(reinterpret_cast<char*>(&value[0]), std::streamsize(std::extent_v<T>*sizeof(Element))); // Performs better, TODO: static check for safety then use
+        if constexpr ( isBulkCopyable<Element>() )
+            is.read(reinterpret_cast<char*>(&value[0]), std::streamsize(std::extent_v<T>*sizeof(Element)));
+        else
+        {
+            for ( size_t i=0; i<std::extent_v<T>; i++ )
+                ::read<Element>(is, value[i], sectionSize);
+        }
     }
     else if constexpr ( RareTs::has_begin_end_v<T> ) // e.g. vector
     {
         using Element = RareTs::element_type_t<T>;
         size_t wholeElements = size_t(sectionSize)/sizeof(Element) + (size_t(sectionSize)%sizeof(Element) > 0 ? 1 : 0);
         value = std::vector<Element>(wholeElements);
-        for ( size_t i=0; i<wholeElements; ++i )
-            ::read<Element>(is, value[i], sectionSize);
-        //is.read(reinterpret_cast<char*>(&value[0]), std::streamsize(wholeElements*sizeof(Element))); // Performs better, TODO: static check for safety then use
+        if constexpr ( isBulkCopyable<Element>() )
+            is.read(reinterpret_cast<char*>(value.data()), std::streamsize(wholeElements*sizeof(Element)));
+        else
+        {
+            for ( size_t i=0; i<wholeElements; ++i )
+                ::read<Element>(is, value[i], sectionSize);
+        }
     }
+    else if constexpr ( isBulkCopyable<T>() )
+        is.read(reinterpret_cast<char*>(&value), std::streamsize(sizeof(T)));
     else if constexpr ( RareTs::is_reflected_v<T> )
     {
         return RareTs::Members<T>::pack([&](auto ... member) {
@@ -414,7 +486,7 @@ void Scenario::read(std::istream & is, Chk::SectionName sectionName, Chk::Sectio
             else
             {
                 logger.info() << "Encountered unknown section: " << Chk::getNameString(sectionName) << std::endl;
-                section.sectionData = std::make_optional<std::vector<u8>>(size_t(sectionSize));
+                section.sectionData.emplace(size_t(sectionSize), u8(0), getMemoryResource());
                 if ( sectionSize > 0 )
                     is.read((char*)&section.sectionData.value()[0], std::streamsize(sectionSize));
             }
@@ -423,67 +495,101 @@ void Scenario::read(std::istream & is, Chk::SectionName sectionName, Chk::Sectio
     }
 }
 
-bool Scenario::read(std::istream & is)
+// Presents a range of an existing buffer as an input stream without copying it, used to run the stream-based section parsers over in-memory chks
+class ByteViewBuf : public std::streambuf
 {
-    clear();
-    bool hasLegacyKstr = false;
+public:
+    void view(const u8* begin, const u8* end)
+    {
+        char* first = const_cast<char*>(reinterpret_cast<const char*>(begin)); // Never written through, input areas only
+        setg(first, first, first + (end - begin));
+    }
+
+    size_t consumed() const { return size_t(gptr() - eback()); }
+};
 
-    // First read contents of "is" to "chk", this will allow jumping backwards when reading chks with jump sections
-    std::stringstream chk(std::ios_base::binary|std::ios_base::in|std::ios_base::out);
-    chk << is.rdbuf();
-    if ( !is.good() && !is.eof() )
+bool Scenario::read(std::istream & is, const SectionMask* sectionsToParse, bool reuseCleanSections)
+{
+    if ( !is.good() )
     {
         logger.error("Unexpected failure reading scenario contents!");
         return false; // Read error on "is"
     }
 
-    chk.seekg(std::ios_base::beg); // Move to start of chk
-    do
+    // Buffer the contents of "is", this will allow jumping backwards when reading chks with jump sections
+    std::vector<u8> chk(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>{});
+    return read(chk.data(), chk.size(), sectionsToParse, false, reuseCleanSections);
+}
+
+bool Scenario::read(const u8* chk, size_t chkSize, const SectionMask* sectionsToParse, bool viewUnparsedSections, bool reuseCleanSections)
+{
+    TraceSpan traceSpan("Scenario::read");
+    clear();
+    SectionDirectory directory = scanSections(chk, chkSize);
+    if ( !directory.error.empty() )
+        return parsingFailed(directory.error);
+
+    return readSections(chk, directory, sectionsToParse, viewUnparsedSections, reuseCleanSections);
+}
+
+bool Scenario::readSections(const u8* chk, const SectionDirectory & directory, const SectionMask* sectionsToParse, bool viewUnparsedSections,
+    bool reuseCleanSections)
+{
+    auto parses = [&](SectionName sectionName) {
+        return sectionsToParse == nullptr || sectionName == SectionName::VER || sectionsToParse->count(sectionName) > 0;
+    };
+
+    jumpCompress = directory.jumpCompressed;
+    ByteViewBuf sectionBuf {};
+    std::istream sectionStream(&sectionBuf);
+    for ( const auto & entry : directory.sections )
     {
-        Chk::SectionHeader sectionHeader = {};
-        chk.read((char*)&sectionHeader, sizeof(Chk::SectionHeader));
-        std::streamsize headerBytesRead = chk.good() ? sizeof(Chk::SectionHeader) : chk.eof() ? chk.gcount() : 0;
-        if ( headerBytesRead == 0 && chk.eof() )
-            break;
-        else if ( headerBytesRead == 0 )
-            return parsingFailed("Unexpected failure reading chk section header!");
+        if ( entry.size != size_t(entry.sizeInBytes) ) // Undersized section, the chk ended early
+            mapIsProtected = true;
 
-        if ( headerBytesRead == sizeof(Chk::SectionHeader) ) // Valid section header
+        if ( !parses(entry.sectionName) ) // Regular section kept as-is
         {
-            if ( sectionHeader.sizeInBytes >= 0 ) // Regular section
+            auto & section = addSection(Section{entry.sectionName});
+            if ( viewUnparsedSections )
             {
-                auto begin = chk.tellg();
-                read(chk, sectionHeader.name, sectionHeader.sizeInBytes);
-
-                if ( chk.good() || chk.eof() )
-                {
-                    if ( Chk::SectionSize(chk.tellg() - begin) != sectionHeader.sizeInBytes ) // Undersized section
-                        mapIsProtected = true;
-                }
-                else
-                    return parsingFailed("Unexpected error reading chk section contents!");
-            }
-            else // if ( sectionHeader.sizeInBytes < 0 ) // Jump section
-            {
-                chk.seekg(sectionHeader.sizeInBytes, std::ios_base::cur);
-                if ( !chk.good() )
-                    return parsingFailed("Unexpected error processing chk jump section!");
-
-                jumpCompress = true;
+                section.sectionData = std::nullopt;
+                section.viewedData = &chk[0] + entry.offset;
+                section.viewedSize = entry.size;
             }
+            else
+                section.sectionData.emplace(&chk[0] + entry.offset, &chk[0] + entry.offset + entry.size, getMemoryResource());
         }
-        else // if ( bytesRead < sizeof(Chk::SectionHeader) ) // Partial section header
+        else // Regular section
         {
-            for ( std::streamsize i=0; i<headerBytesRead; i++ )
-                tailData[size_t(i)] = ((u8*)&sectionHeader)[size_t(i)];
-            for ( size_t i=size_t(headerBytesRead); i<tailData.size(); i++ )
-                tailData[i] = u8(0);
+            sectionBuf.view(&chk[0] + entry.offset, &chk[0] + entry.offset + entry.size);
+            sectionStream.clear();
+            read(sectionStream, entry.sectionName, entry.sizeInBytes);
 
-            tailLength = (u8)headerBytesRead;
-            mapIsProtected = true;
+            if ( !sectionStream.good() && !sectionStream.eof() )
+                return parsingFailed("Unexpected error reading chk section contents!");
+            else if ( Chk::SectionSize(sectionBuf.consumed()) != entry.sizeInBytes ) // Section didn't match the size of the fields it's parsed into
+            {
+                mapIsProtected = true;
+                cleanSectionBytes.erase(entry.sectionName);
+            }
+            else if ( reuseCleanSections && sectionMemberIndex.find(entry.sectionName) != sectionMemberIndex.end() ) // Known section parsed whole, kept until marked dirty
+                cleanSectionBytes[entry.sectionName].assign(&chk[0] + entry.offset, &chk[0] + entry.offset + entry.size);
         }
     }
-    while ( chk.good() );
+
+    if ( directory.tailLength > 0 ) // Partial section header
+    {
+        for ( size_t i=0; i<directory.tailLength; i++ )
+            tailData[i] = chk[directory.tailOffset + i];
+        for ( size_t i=directory.tailLength; i<tailData.size(); i++ )
+            tailData[i] = u8(0);
+
+        tailLength = (u8)directory.tailLength;
+        mapIsProtected = true;
+    }
+
+    if ( hasSection(SectionName::STRx) ) // STR is rebuilt from the strings read from STRx
+        cleanSectionBytes.erase(SectionName::STR);
 
     if ( !hasSection(SectionName::VER) )
         return parsingFailed("Map was missing the VER section!");
@@ -493,47 +599,149 @@ bool Scenario::read(std::istream & is)
         mapIsProtected = true;
     }
 
-    this->fixTerrainToDimensions();
-    this->fixTriggerExtensions();
-    upgradeKstrToCurrent();
+    // Fixes only run where every section they touch was parsed, otherwise they'd work from defaults & drift from the sections kept as-is
+    if ( parses(SectionName::DIM) && parses(SectionName::MTXM) )
+        this->fixTerrainToDimensions();
+    if ( parses(SectionName::TRIG) && parses(SectionName::KTRG) )
+        this->fixTriggerExtensions();
+    if ( parses(SectionName::TRIG) && parses(SectionName::MBRF) && parses(SectionName::KTRG) &&
+        parses(SectionName::STR) && parses(SectionName::STRx) && parses(SectionName::OSTR) && parses(SectionName::KSTR) )
+    {
+        upgradeKstrToCurrent();
+    }
 
     return true;
 }
 
-Scenario::Section & Scenario::addSection(Section section)
+const Scenario::SectionEntry* Scenario::SectionDirectory::find(Chk::SectionName sectionName) const
+{
+    auto found = lastIndex.find(sectionName);
+    return found != lastIndex.end() ? &sections[found->second] : nullptr;
+}
+
+Scenario::SectionDirectory Scenario::scanSections(const u8* chk, size_t chkSize)
 {
-    if ( hasSection(section.sectionName) )
+    SectionDirectory directory {};
+    std::unordered_set<size_t> jumpTargets {};
+    size_t offset = 0;
+    while ( offset < chkSize )
     {
-        for ( auto & existing : saveSections )
+        if ( chkSize - offset < sizeof(Chk::SectionHeader) ) // Partial section header
         {
-            if ( section.sectionName == existing.sectionName )
-                return existing;
+            directory.tailOffset = offset;
+            directory.tailLength = chkSize - offset;
+            break;
+        }
+
+        Chk::SectionHeader sectionHeader = {};
+        std::memcpy(&sectionHeader, &chk[offset], sizeof(Chk::SectionHeader));
+        offset += sizeof(Chk::SectionHeader);
+
+        if ( sectionHeader.sizeInBytes >= 0 ) // Regular section
+        {
+            size_t sectionBytes = std::min(chkSize - offset, size_t(sectionHeader.sizeInBytes));
+            directory.lastIndex[sectionHeader.name] = directory.sections.size();
+            directory.sections.push_back(SectionEntry{sectionHeader.name, sectionHeader.sizeInBytes, offset, sectionBytes});
+            offset += sectionBytes;
+        }
+        else // if ( sectionHeader.sizeInBytes < 0 ) // Jump section
+        {
+            size_t jumpDistance = size_t(-s64(sectionHeader.sizeInBytes));
+            if ( jumpDistance > offset )
+            {
+                directory.error = "Unexpected error processing chk jump section!";
+                break;
+            }
+
+            offset -= jumpDistance;
+            directory.jumpCompressed = true;
+            if ( !jumpTargets.insert(offset).second ) // The walk from here was already taken and would repeat forever
+            {
+                directory.error = "Chk jump sections form a loop!";
+                break;
+            }
         }
-        throw std::logic_error("An internal error occured");
     }
-    else
+    return directory;
+}
+
+Scenario::Section & Scenario::addSection(Section section)
+{
+    auto existing = saveSectionIndex.find(section.sectionName);
+    if ( existing != saveSectionIndex.end() )
+        return saveSections[existing->second];
+
+    saveSectionIndex.emplace(section.sectionName, saveSections.size());
+    saveSections.push_back(std::move(section));
+    return saveSections.back();
+}
+
+std::pmr::memory_resource* Scenario::getMemoryResource() const
+{
+    return saveSections.get_allocator().resource();
+}
+
+bool Scenario::hasSection(SectionName sectionName) const
+{
+    return saveSectionIndex.find(sectionName) != saveSectionIndex.end();
+}
+
+bool Scenario::hasUnparsedSections() const
+{
+    for ( auto & section : saveSections )
     {
-        saveSections.push_back(section);
-        return saveSections.back();
+        if ( section.isRaw() && sectionMemberIndex.find(section.sectionName) != sectionMemberIndex.end() )
+            return true;
     }
+    return false;
 }
 
-bool Scenario::hasSection(SectionName sectionName) const
+bool Scenario::hasViewedSections() const
 {
     for ( auto & section : saveSections )
     {
-        if ( section.sectionName == sectionName )
+        if ( section.viewedData != nullptr )
             return true;
     }
     return false;
 }
 
+void Scenario::copyViewedSections()
+{
+    for ( auto & section : saveSections )
+    {
+        if ( section.viewedData != nullptr )
+        {
+            section.sectionData.emplace(section.viewedData, section.viewedData + section.viewedSize, getMemoryResource());
+            section.viewedData = nullptr;
+            section.viewedSize = 0;
+        }
+    }
+}
+
 void Scenario::removeSection(const SectionName & sectionName)
 {
+    cleanSectionBytes.erase(sectionName);
     if ( hasSection(sectionName) )
     {
-        auto toRemove = std::remove_if(saveSections.begin(), saveSections.end(), [&](auto & section){ return section.sectionName == sectionName; });
-        saveSections.erase(toRemove);
+        saveSections.erase(std::remove_if(saveSections.begin(), saveSections.end(), [&](auto & section){ return section.sectionName == sectionName; }), saveSections.end());
+        indexSaveSections();
+    }
+}
+
+void Scenario::indexSaveSections()
+{
+    saveSectionIndex.clear();
+    for ( size_t i=0; i<saveSections.size(); ++i )
+        saveSectionIndex.emplace(saveSections[i].sectionName, i);
+}
+
+void Scenario::markDirty(std::initializer_list<SectionName> sectionNames)
+{
+    if ( !cleanSectionBytes.empty() )
+    {
+        for ( auto sectionName : sectionNames )
+            cleanSectionBytes.erase(sectionName);
     }
 }
 
@@ -550,15 +758,27 @@ void write(std::ostream & os, const Value & value)
     if constexpr ( std::is_array_v<T> )
     {
         using Element = RareTs::element_type_t<T>;
-        for ( size_t i=0; i<std::extent_v<T>; i++ )
-            write<Element>(os, value[i]);
+        if constexpr ( isBulkCopyable<Element>() )
+            os.write(reinterpret_cast<const char*>(&value[0]), std::streamsize(std::extent_v<T>*sizeof(Element)));
+        else
+        {
+            for ( size_t i=0; i<std::extent_v<T>; i++ )
+                write<Element>(os, value[i]);
+        }
     }
     else if constexpr ( RareTs::has_begin_end_v<T> )
     {
         using Element = RareTs::element_type_t<T>;
-        for ( const auto & element : value )
-            write<Element>(os, element);
+        if constexpr ( isBulkCopyable<Element>() )
+            os.write(reinterpret_cast<const char*>(value.data()), std::streamsize(value.size()*sizeof(Element)));
+        else
+        {
+            for ( const auto & element : value )
+                write<Element>(os, element);
+        }
     }
+    else if constexpr ( isBulkCopyable<T>() )
+        os.write(reinterpret_cast<const char*>(&value), std::streamsize(sizeof(T)));
     else if constexpr ( RareTs::is_reflected_v<T> )
     {
         return RareTs::Members<T>::pack([&](auto ... member) {
@@ -579,82 +799,142 @@ void writeSection(std::ostream & os, const Value & value)
     write<typename Member::type>(os, value);
 }
 
-void Scenario::write(std::ostream & os)
+// Presents a pre-sized buffer as an output stream so sections are written straight into it
+class ByteWriteBuf : public std::streambuf
 {
-    try
+public:
+    ByteWriteBuf(u8* begin, u8* end)
     {
-        for ( auto & section : saveSections )
+        setp(reinterpret_cast<char*>(begin), reinterpret_cast<char*>(end)); // Writing past end fails the stream rather than growing the buffer
+    }
+
+    size_t written() const { return size_t(pptr() - pbase()); }
+};
+
+Scenario::SyncedStringSections Scenario::syncStringSections()
+{
+    SyncedStringSections strings {};
+    for ( auto & section : saveSections )
+    {
+        if ( cleanSectionBytes.count(section.sectionName) > 0 ) // Written as read, skip rebuilding it
+            continue;
+
+        switch ( section.sectionName )
+        {
+            case SectionName::STR: syncStringsToBytes(strings.str); break;
+            case SectionName::STRx: syncRemasteredStringsToBytes(strings.strx); break;
+            case SectionName::KSTR: syncKstringsToBytes(strings.kstr); break;
+            default: break;
+        }
+    }
+    return strings;
+}
+
+s32 Scenario::getSectionSize(const Section & section, const SyncedStringSections & strings)
+{
+    if ( section.isRaw() ) // Unknown or unparsed section
+        return s32(section.rawSize());
+
+    auto clean = cleanSectionBytes.find(section.sectionName);
+    if ( clean != cleanSectionBytes.end() )
+        return s32(clean->second.size());
+
+    switch ( section.sectionName )
+    {
+        case SectionName::MRGN: return s32((locations.size()-1) * ::size<Chk::Location>());
+        case SectionName::STR: return s32(strings.str.size());
+        case SectionName::STRx: return s32(strings.strx.size());
+        case SectionName::KSTR: return s32(strings.kstr.size());
+        default:
         {
-            SectionName sectionName = section.sectionName;
-            os.write(reinterpret_cast<const char*>(&sectionName), sizeof(std::underlying_type_t<SectionName>));
-            switch ( sectionName )
+            auto memberIndex = sectionMemberIndex.find(section.sectionName);
+            if ( memberIndex != sectionMemberIndex.end() )
             {
-                case SectionName::MRGN: // Manual serialization to account for zeroth location being unused
-                {
-                    s32 size = s32((locations.size()-1) * ::size<Chk::Location>());
-                    os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
-                    for ( size_t i=1; i<locations.size(); ++i )
-                        ::write<Chk::Location>(os, locations[i]);
-                }
-                break;
-                case SectionName::STR:
-                {
-                    std::vector<u8> bytes;
-                    syncStringsToBytes(bytes);
-                    s32 size = s32(bytes.size());
-                    os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
-                    os.write(reinterpret_cast<const char*>(&bytes[0]), std::streamsize(size));
-                }
-                break;
-                case SectionName::STRx:
+                s32 size = 0;
+                RareTs::Members<Scenario>::at(memberIndex->second, *this, [&](auto member, auto & value) {
+                    size = ::size<typename decltype(member)::type>(value);
+                });
+                return size;
+            }
+            else
+                return 0;
+        }
+    }
+}
+
+void Scenario::writeSections(std::ostream & os, const SyncedStringSections & strings)
+{
+    for ( auto & section : saveSections )
+    {
+        SectionName sectionName = section.sectionName;
+        os.write(reinterpret_cast<const char*>(&sectionName), sizeof(std::underlying_type_t<SectionName>));
+        if ( section.isRaw() ) // Unknown or unparsed section, written back unchanged
+        {
+            s32 size = s32(section.rawSize());
+            os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
+            if ( size > 0 )
+                os.write(reinterpret_cast<const char*>(section.rawData()), std::streamsize(size));
+
+            continue;
+        }
+
+        auto clean = cleanSectionBytes.find(sectionName);
+        if ( clean != cleanSectionBytes.end() ) // Unchanged since it was read, copied rather than serialized
+        {
+            s32 size = s32(clean->second.size());
+            os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
+            os.write(reinterpret_cast<const char*>(clean->second.data()), std::streamsize(size));
+            continue;
+        }
+
+        switch ( sectionName )
+        {
+            case SectionName::MRGN: // Manual serialization to account for zeroth location being unused
+            {
+                s32 size = s32((locations.size()-1) * ::size<Chk::Location>());
+                os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
+                for ( size_t i=1; i<locations.size(); ++i )
+                    ::write<Chk::Location>(os, locations[i]);
+            }
+            break;
+            case SectionName::STR:
+            case SectionName::STRx:
+            case SectionName::KSTR:
+            {
+                const std::vector<u8> & bytes = sectionName == SectionName::STR ? strings.str : (sectionName == SectionName::STRx ? strings.strx : strings.kstr);
+                s32 size = s32(bytes.size());
+                os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
+                os.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(size));
+            }
+            break;
+            default:
+            {
+                auto memberIndex = sectionMemberIndex.find(sectionName);
+                if ( memberIndex != sectionMemberIndex.end() ) // This is a section that can be auto-serialized using reflection
                 {
-                    std::vector<u8> bytes;
-                    syncRemasteredStringsToBytes(bytes);
-                    s32 size = s32(bytes.size());
-                    os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
-                    os.write(reinterpret_cast<const char*>(&bytes[0]), std::streamsize(size));
+                    RareTs::Members<Scenario>::at(memberIndex->second, *this, [&](auto member, auto & value) {
+                        ::writeSection<decltype(member)>(os, value);
+                    });
                 }
-                break;
-                case SectionName::KSTR:
+                else // This is an unknown/custom section without data
                 {
-                    std::vector<u8> bytes;
-                    syncKstringsToBytes(bytes);
-                    s32 size = s32(bytes.size());
+                    logger.info() << "[" << Chk::getNameString(sectionName) << "] unknown/custom" << std::endl;
+                    s32 size = 0;
                     os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
-                    os.write(reinterpret_cast<const char*>(&bytes[0]), std::streamsize(bytes.size()));
                 }
-                break;
-                default:
-                {
-                    auto memberIndex = sectionMemberIndex.find(sectionName);
-                    if ( memberIndex != sectionMemberIndex.end() ) // This is a section that can be auto-serialized using reflection
-                    {
-                        RareTs::Members<Scenario>::at(memberIndex->second, *this, [&](auto member, auto & value) {
-                            ::writeSection<decltype(member)>(os, value);
-                        });
-                    }
-                    else // This is an unknown/custom section
-                    {
-                        logger.info() << "[" << Chk::getNameString(sectionName) << "] unknown/custom" << std::endl;
-                        if ( section.sectionData )
-                        {
-                            s32 size = s32(section.sectionData->size());
-                            os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
-                            if ( size > 0 )
-                                os.write(reinterpret_cast<const char*>(&section.sectionData.value()[0]), std::streamsize(size));
-                        }
-                        else
-                        {
-                            s32 size = 0;
-                            os.write(reinterpret_cast<const char*>(&size), std::streamsize(sizeof(size)));
-                        }
-                    }
-                }
-                break;
             }
+            break;
         }
-        if ( tailLength > 0 )
-            os.write(reinterpret_cast<const char*>(&tailData[0]), std::streamsize(tailLength));
+    }
+    if ( tailLength > 0 )
+        os.write(reinterpret_cast<const char*>(&tailData[0]), std::streamsize(tailLength));
+}
+
+void Scenario::write(std::ostream & os)
+{
+    try
+    {
+        writeSections(os, syncStringSections());
     }
     catch ( std::exception & e )
     {
@@ -663,20 +943,41 @@ void Scenario::write(std::ostream & os)
     }
 }
 
-std::vector<u8> Scenario::serialize()
+bool Scenario::write(std::vector<u8> & chk, size_t leadingBytes)
 {
-    Chk::Size size = 0;
-    std::stringstream chk(std::ios_base::in|std::ios_base::out|std::ios_base::binary);
-    chk.write((const char*)&Chk::CHK, sizeof(Chk::CHK)); // Header
-    chk.write((const char*)&size, sizeof(size)); // Size
+    try
+    {
+        auto strings = syncStringSections();
+        size_t chkSize = tailLength;
+        for ( auto & section : saveSections )
+            chkSize += sizeof(Chk::SectionHeader) + size_t(getSectionSize(section, strings));
 
-    write(chk);
-    chk.unsetf(std::ios_base::skipws);
-    auto start = std::istream_iterator<u8>(chk);
-    std::vector<u8> chkBytes(start, std::istream_iterator<u8>());
+        chk.assign(leadingBytes + chkSize, u8(0)); // The only allocation, sections are then written in a single pass
+        ByteWriteBuf chkBuf(chk.data() + leadingBytes, chk.data() + chk.size());
+        std::ostream os(&chkBuf);
+        writeSections(os, strings);
+        if ( !os.good() || chkBuf.written() != chkSize )
+            throw std::logic_error("Scenario sections did not match their computed sizes");
 
-    (Chk::Size &)chkBytes[sizeof(Chk::CHK)] = Chk::Size(chkBytes.size() - sizeof(Chk::CHK) - sizeof(size));
+        return true;
+    }
+    catch ( std::exception & e )
+    {
+        chk.clear();
+        logger.error("Error writing scenario file ", e);
+        return false;
+    }
+}
 
+std::vector<u8> Scenario::serialize()
+{
+    std::vector<u8> chkBytes {};
+    if ( write(chkBytes, sizeof(Chk::CHK) + sizeof(Chk::Size)) )
+    {
+        Chk::Size size = Chk::Size(chkBytes.size() - sizeof(Chk::CHK) - sizeof(Chk::Size));
+        std::memcpy(&chkBytes[0], &Chk::CHK, sizeof(Chk::CHK)); // Header
+        std::memcpy(&chkBytes[sizeof(Chk::CHK)], &size, sizeof(size)); // Size
+    }
     return chkBytes;
 }
 
@@ -691,6 +992,96 @@ bool Scenario::deserialize(Chk::SerializedChk* data)
     return false;
 }
 
+bool Scenario::writeSnapshot(std::vector<u8> & snapshot)
+{
+    TraceSpan traceSpan("Scenario::writeSnapshot");
+    std::vector<u8> chk {};
+    if ( !write(chk) )
+    {
+        snapshot.clear();
+        return false;
+    }
+
+    auto alignUp = [](size_t offset) { return (offset + Chk::SnapshotAlignment - 1) / Chk::SnapshotAlignment * Chk::SnapshotAlignment; };
+    SectionDirectory directory = scanSections(chk.data(), chk.size()); // write doesn't add jump sections so these are saveSections in order
+    std::vector<Chk::SnapshotSection> sections(directory.sections.size());
+    size_t snapshotSize = alignUp(sizeof(Chk::SnapshotHeader) + sections.size()*sizeof(Chk::SnapshotSection));
+    for ( size_t i=0; i<sections.size(); ++i )
+    {
+        sections[i] = Chk::SnapshotSection{directory.sections[i].sectionName, directory.sections[i].sizeInBytes, Chk::Size(snapshotSize)};
+        snapshotSize = alignUp(snapshotSize + directory.sections[i].size);
+    }
+
+    Chk::SnapshotHeader header {};
+    header.name = Chk::CHKS;
+    header.version = Chk::SnapshotVersion;
+    header.flags = Chk::SnapshotHeader::Flags((jumpCompress ? Chk::SnapshotHeader::Flags::JumpCompress : 0) |
+        (mapIsProtected ? Chk::SnapshotHeader::Flags::Protected : 0));
+    header.sectionCount = u32(sections.size());
+    header.sizeInBytes = Chk::Size(snapshotSize);
+    header.tailLength = u8(directory.tailLength);
+    for ( size_t i=0; i<directory.tailLength; i++ )
+        header.tailData[i] = chk[directory.tailOffset + i];
+
+    snapshot.assign(snapshotSize, u8(0));
+    std::memcpy(&snapshot[0], &header, sizeof(header));
+    if ( !sections.empty() )
+        std::memcpy(&snapshot[sizeof(header)], &sections[0], sections.size()*sizeof(Chk::SnapshotSection));
+
+    for ( size_t i=0; i<sections.size(); ++i )
+    {
+        if ( directory.sections[i].size > 0 )
+            std::memcpy(&snapshot[size_t(sections[i].offset)], &chk[directory.sections[i].offset], directory.sections[i].size);
+    }
+    return true;
+}
+
+bool Scenario::readSnapshot(const u8* snapshot, size_t snapshotSize, const SectionMask* sectionsToParse, bool viewUnparsedSections, bool reuseCleanSections)
+{
+    TraceSpan traceSpan("Scenario::readSnapshot");
+    clear();
+    if ( !isSnapshot(snapshot, snapshotSize) )
+        return parsingFailed("Snapshot header is missing or from an unsupported version!");
+
+    Chk::SnapshotHeader header {};
+    std::memcpy(&header, snapshot, sizeof(header));
+    size_t sectionsEnd = sizeof(header) + size_t(header.sectionCount)*sizeof(Chk::SnapshotSection);
+    if ( header.sizeInBytes != Chk::Size(snapshotSize) || sectionsEnd > snapshotSize || header.tailLength > sizeof(header.tailData) )
+        return parsingFailed("Snapshot is truncated or corrupt!");
+
+    SectionDirectory directory {};
+    directory.sections.reserve(header.sectionCount);
+    for ( size_t i=0; i<header.sectionCount; ++i )
+    {
+        Chk::SnapshotSection section {};
+        std::memcpy(&section, &snapshot[sizeof(header) + i*sizeof(Chk::SnapshotSection)], sizeof(section));
+        if ( section.sizeInBytes < 0 || section.offset > snapshotSize || snapshotSize - size_t(section.offset) < size_t(section.sizeInBytes) )
+            return parsingFailed("Snapshot section is out of bounds!");
+
+        directory.lastIndex[section.name] = directory.sections.size();
+        directory.sections.push_back(SectionEntry{section.name, section.sizeInBytes, size_t(section.offset), size_t(section.sizeInBytes)});
+    }
+    directory.tailOffset = offsetof(Chk::SnapshotHeader, tailData);
+    directory.tailLength = header.tailLength;
+    directory.jumpCompressed = (header.flags & Chk::SnapshotHeader::Flags::JumpCompress) != 0;
+
+    if ( !readSections(snapshot, directory, sectionsToParse, viewUnparsedSections, reuseCleanSections) )
+        return false;
+
+    mapIsProtected = mapIsProtected || (header.flags & Chk::SnapshotHeader::Flags::Protected) != 0;
+    return true;
+}
+
+bool Scenario::isSnapshot(const u8* data, size_t size)
+{
+    Chk::SnapshotHeader header {};
+    if ( data == nullptr || size < sizeof(header) )
+        return false;
+
+    std::memcpy(&header, data, sizeof(header));
+    return header.name == Chk::CHKS && header.version == Chk::SnapshotVersion;
+}
+
 void Scenario::updateSaveSections()
 {
     if ( this->hasExtendedStrings() )
@@ -709,6 +1100,9 @@ void Scenario::updateSaveSections()
 bool Scenario::changeVersionTo(Chk::Version version, bool lockAnywhere, bool autoDefragmentLocations)
 {
     auto oldVersion = this->version;
+    auto oldType = this->type;
+    auto oldIVersion = this->iVersion;
+    auto oldI2Version = this->i2Version;
 
     if ( version < Chk::Version::StarCraft_BroodWar ) // Original or Hybrid: include all original properties
     {
@@ -776,7 +1170,18 @@ bool Scenario::changeVersionTo(Chk::Version version, bool lockAnywhere, bool aut
     }
     
     this->version = version;
-    this->deleteUnusedStrings(Chk::StrScope::Both);
+    if ( this->version != oldVersion )
+        markDirty({SectionName::VER});
+    if ( this->type != oldType )
+        markDirty({SectionName::TYPE});
+    if ( this->iVersion != oldIVersion )
+        markDirty({SectionName::IVER});
+    if ( this->i2Version != oldI2Version )
+        markDirty({SectionName::IVE2});
+
+    if ( !hasUnparsedSections() ) // Strings may be used by sections that weren't parsed
+        this->deleteUnusedStrings(Chk::StrScope::Both);
+
     return true;
 }
 
@@ -833,6 +1238,7 @@ bool Scenario::hasDefaultValidation() const
 
 void Scenario::setToDefaultValidation()
 {
+    markDirty({SectionName::VCOD});
     Chk::VCOD vcod = Chk::VCOD {};
     for ( size_t i=0; i<Chk::TotalValidationSeeds; ++i )
         this->validation.seedValues[i] = vcod.seedValues[i];
@@ -1223,6 +1629,7 @@ StrProp Scenario::getProperties(size_t editorStringId) const
 
 void Scenario::setProperties(size_t editorStringId, const StrProp & strProp)
 {
+    markDirty({SectionName::KSTR});
     if ( hasSection(Chk::SectionName::KSTR) )
     {
         if ( editorStringId < editorStrings.size() && editorStrings[editorStringId] )
@@ -1308,6 +1715,7 @@ template size_t Scenario::findString<SingleLineChkdString>(const SingleLineChkdS
 
 bool Scenario::setCapacity(size_t stringCapacity, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::STR, SectionName::STRx, SectionName::KSTR});
     if ( storageScope == Chk::StrScope::Game )
     {
         if ( stringCapacity > Chk::MaxStrings )
@@ -1386,6 +1794,7 @@ bool Scenario::setCapacity(size_t stringCapacity, Chk::StrScope storageScope, bo
 template <typename StringType>
 size_t Scenario::addString(const StringType & str, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::STR, SectionName::STRx, SectionName::KSTR});
     if ( storageScope == Chk::StrScope::Game )
     {
         RawString rawString;
@@ -1413,7 +1822,7 @@ size_t Scenario::addString(const StringType & str, Chk::StrScope storageScope, b
         else if ( nextUnusedStringId >= strings.size() )
             setCapacity(nextUnusedStringId+1, Chk::StrScope::Game, autoDefragment);
 
-        strings[nextUnusedStringId] = rawString;
+        strings[nextUnusedStringId] = ScStr(rawString.c_str(), rawString.size(), getMemoryResource());
         return nextUnusedStringId;
     }
     else if ( storageScope == Chk::StrScope::Editor )
@@ -1443,7 +1852,7 @@ size_t Scenario::addString(const StringType & str, Chk::StrScope storageScope, b
         else if ( nextUnusedStringId >= editorStrings.size() )
             setCapacity(nextUnusedStringId+1, Chk::StrScope::Editor, autoDefragment);
 
-        editorStrings[nextUnusedStringId] = rawString;
+        editorStrings[nextUnusedStringId] = ScStr(rawString.c_str(), rawString.size(), getMemoryResource());
         return nextUnusedStringId;
     }
     return (size_t)Chk::StringId::NoString;
@@ -1456,13 +1865,14 @@ template size_t Scenario::addString<SingleLineChkdString>(const SingleLineChkdSt
 template <typename StringType>
 void Scenario::replaceString(size_t stringId, const StringType & str, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::STR, SectionName::STRx, SectionName::KSTR});
     if ( storageScope == Chk::StrScope::Game )
     {
         RawString rawString;
         convertStr<StringType, RawString>(str, rawString);
 
         if ( stringId < strings.size() )
-            strings[stringId] = rawString;
+            strings[stringId] = ScStr(rawString.c_str(), rawString.size(), getMemoryResource());
     }
     else if ( storageScope == Chk::StrScope::Editor )
     {
@@ -1470,7 +1880,7 @@ void Scenario::replaceString(size_t stringId, const StringType & str, Chk::StrSc
         convertStr<StringType, RawString>(str, rawString);
 
         if ( stringId < editorStrings.size() )
-            editorStrings[stringId] = rawString;
+            editorStrings[stringId] = ScStr(rawString.c_str(), rawString.size(), getMemoryResource());
     }
 }
 template void Scenario::replaceString<RawString>(size_t stringId, const RawString & str, Chk::StrScope storageScope);
@@ -1486,7 +1896,10 @@ void Scenario::deleteUnusedStrings(Chk::StrScope storageScope)
         for ( size_t i=0; i<strings.size(); i++ )
         {
             if ( !stringIdUsed[i] && strings[i] )
+            {
                 strings[i] = std::nullopt;
+                markDirty({SectionName::STR, SectionName::STRx});
+            }
         }
     };
     auto deleteUnusedEditorStrings = [&]() {
@@ -1495,7 +1908,10 @@ void Scenario::deleteUnusedStrings(Chk::StrScope storageScope)
         for ( size_t i=0; i<editorStrings.size(); i++ )
         {
             if ( !stringIdUsed[i] && editorStrings[i] )
+            {
                 editorStrings[i] = std::nullopt;
+                markDirty({SectionName::KSTR});
+            }
         }
     };
     switch ( storageScope )
@@ -1508,6 +1924,7 @@ void Scenario::deleteUnusedStrings(Chk::StrScope storageScope)
 
 void Scenario::deleteString(size_t stringId, Chk::StrScope storageScope, bool deleteOnlyIfUnused)
 {
+    markDirty({SectionName::STR, SectionName::SPRP, SectionName::STRx, SectionName::OSTR, SectionName::KSTR});
     auto deleteGameString = [&](){
         return false;
     };
@@ -1586,6 +2003,7 @@ void Scenario::deleteString(size_t stringId, Chk::StrScope storageScope, bool de
 
 void Scenario::moveString(size_t stringIdFrom, size_t stringIdTo, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::STR, SectionName::STRx, SectionName::KSTR});
     if ( storageScope == Chk::StrScope::Game )
     {
         size_t stringIdMin = std::min(stringIdFrom, stringIdTo);
@@ -1700,6 +2118,7 @@ void Scenario::moveString(size_t stringIdFrom, size_t stringIdTo, Chk::StrScope
 
 size_t Scenario::rescopeString(size_t stringId, Chk::StrScope changeStorageScopeTo, bool autoDefragment)
 {
+    markDirty({SectionName::MRGN, SectionName::SPRP, SectionName::FORC, SectionName::WAV, SectionName::UNIS, SectionName::SWNM, SectionName::UNIx, SectionName::OSTR});
     if ( changeStorageScopeTo == Chk::StrScope::Editor && stringUsed(stringId, Chk::StrScope::Either, Chk::StrScope::Game, Chk::StringUserFlag::All, true) )
     {
         RawString toRescope = getString<RawString>(stringId, Chk::StrScope::Game).value();
@@ -1850,6 +2269,7 @@ size_t Scenario::rescopeString(size_t stringId, Chk::StrScope changeStorageScope
 
 std::vector<u8> & Scenario::getStrTailData()
 {
+    markDirty({SectionName::STR});
     return strTailData;
 }
 
@@ -1876,6 +2296,7 @@ size_t Scenario::getStrBytePaddedTo() const
 
 void Scenario::setStrBytePaddedTo(size_t bytePaddedTo)
 {
+    markDirty({SectionName::STR});
     this->strBytePaddedTo = bytePaddedTo;
 }
 
@@ -1945,6 +2366,7 @@ size_t Scenario::getLocationNameStringId(size_t locationId, Chk::StrScope storag
 
 void Scenario::setScenarioNameStringId(size_t scenarioNameStringId, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::SPRP, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Editor )
         this->editorStringOverrides.scenarioName = u32(scenarioNameStringId);
     else
@@ -1953,6 +2375,7 @@ void Scenario::setScenarioNameStringId(size_t scenarioNameStringId, Chk::StrScop
 
 void Scenario::setScenarioDescriptionStringId(size_t scenarioDescriptionStringId, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::SPRP, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Editor )
         this->editorStringOverrides.scenarioDescription = u32(scenarioDescriptionStringId);
     else
@@ -1961,6 +2384,7 @@ void Scenario::setScenarioDescriptionStringId(size_t scenarioDescriptionStringId
 
 void Scenario::setForceNameStringId(Chk::Force force, size_t forceNameStringId, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::FORC, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Editor )
         this->editorStringOverrides.forceName[force] = u32(forceNameStringId);
     else
@@ -1969,6 +2393,7 @@ void Scenario::setForceNameStringId(Chk::Force force, size_t forceNameStringId,
 
 void Scenario::setUnitNameStringId(Sc::Unit::Type unitType, size_t unitNameStringId, Chk::UseExpSection useExp, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx, SectionName::OSTR});
     if ( unitType >= Sc::Unit::TotalTypes )
         throw std::out_of_range(std::string("UnitType: ") + std::to_string(unitType) + " is out of range for the UNIS/UNIx section!");
 
@@ -2010,6 +2435,7 @@ void Scenario::setUnitNameStringId(Sc::Unit::Type unitType, size_t unitNameStrin
 
 void Scenario::setSoundPathStringId(size_t soundIndex, size_t soundPathStringId, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::WAV, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Editor )
         this->editorStringOverrides.soundPath[soundIndex] = u32(soundPathStringId);
     else
@@ -2018,6 +2444,7 @@ void Scenario::setSoundPathStringId(size_t soundIndex, size_t soundPathStringId,
 
 void Scenario::setSwitchNameStringId(size_t switchIndex, size_t switchNameStringId, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::SWNM, SectionName::OSTR});
 	if ( switchIndex < Chk::TotalSwitches )
     {
         if ( storageScope == Chk::StrScope::Game )
@@ -2031,6 +2458,7 @@ void Scenario::setSwitchNameStringId(size_t switchIndex, size_t switchNameString
 
 void Scenario::setLocationNameStringId(size_t locationId, size_t locationNameStringId, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::MRGN, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Editor )
         this->editorStringOverrides.locationName[locationId] = u32(locationNameStringId);
     else if ( locationId < numLocations() )
@@ -2168,6 +2596,7 @@ template std::optional<SingleLineChkdString> Scenario::getExtendedNotes<SingleLi
 template <typename StringType>
 void Scenario::setScenarioName(const StringType & scenarioNameString, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::SPRP, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Game || storageScope == Chk::StrScope::Editor )
     {
         size_t newStringId = addString<StringType>(scenarioNameString, storageScope, autoDefragment);
@@ -2188,6 +2617,7 @@ template void Scenario::setScenarioName<SingleLineChkdString>(const SingleLineCh
 template <typename StringType>
 void Scenario::setScenarioDescription(const StringType & scenarioDescription, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::SPRP, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Game || storageScope == Chk::StrScope::Editor )
     {
         size_t newStringId = addString<StringType>(scenarioDescription, storageScope, autoDefragment);
@@ -2208,6 +2638,7 @@ template void Scenario::setScenarioDescription<SingleLineChkdString>(const Singl
 template <typename StringType>
 void Scenario::setForceName(Chk::Force force, const StringType & forceName, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::FORC, SectionName::OSTR});
     if ( (storageScope == Chk::StrScope::Game || storageScope == Chk::StrScope::Editor) && (u32)force < Chk::TotalForces )
     {
         size_t newStringId = addString<StringType>(forceName, storageScope, autoDefragment);
@@ -2228,6 +2659,7 @@ template void Scenario::setForceName<SingleLineChkdString>(Chk::Force force, con
 template <typename StringType>
 void Scenario::setUnitName(Sc::Unit::Type unitType, const StringType & unitName, Chk::UseExpSection useExp, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx, SectionName::OSTR});
     if ( (storageScope == Chk::StrScope::Game || storageScope == Chk::StrScope::Editor) && unitType < Sc::Unit::TotalTypes )
     {
         size_t newStringId = addString<StringType>(unitName, storageScope, autoDefragment);
@@ -2269,6 +2701,7 @@ template void Scenario::setUnitName<SingleLineChkdString>(Sc::Unit::Type unitTyp
 template <typename StringType>
 void Scenario::setSoundPath(size_t soundIndex, const StringType & soundPath, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Game || storageScope == Chk::StrScope::Editor && soundIndex < Chk::TotalSounds )
     {
         size_t newStringId = addString<StringType>(soundPath, storageScope, autoDefragment);
@@ -2289,6 +2722,7 @@ template void Scenario::setSoundPath<SingleLineChkdString>(size_t soundIndex, co
 template <typename StringType>
 void Scenario::setSwitchName(size_t switchIndex, const StringType & switchName, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::SWNM, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Game || storageScope == Chk::StrScope::Editor && switchIndex < Chk::TotalSwitches )
     {
         size_t newStringId = addString<StringType>(switchName, storageScope, autoDefragment);
@@ -2309,6 +2743,7 @@ template void Scenario::setSwitchName<SingleLineChkdString>(size_t switchIndex,
 template <typename StringType>
 void Scenario::setLocationName(size_t locationId, const StringType & locationName, Chk::StrScope storageScope, bool autoDefragment)
 {
+    markDirty({SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Game || storageScope == Chk::StrScope::Editor && locationId > 0 && locationId <= numLocations() )
     {
         size_t newStringId = addString<StringType>(locationName, storageScope, autoDefragment);
@@ -2490,6 +2925,7 @@ void Scenario::syncBytesToStrings(const std::vector<u8> & stringBytes)
     u16 rawNumStrings = numBytes >= 2 ? (u16 &)stringBytes[0] : numBytes == 1 ? (u16)stringBytes[0] : 0;
     size_t highestStringWithValidOffset = std::min(size_t(rawNumStrings), numBytes < 4 ? 0 : numBytes/2-1);
     strings.clear();
+    strings.reserve(highestStringWithValidOffset+2); // The 0th string, strings with in-bounds offsets & one partial offset
     strings.push_back(std::nullopt); // Fill the non-existant 0th stringId
 
     size_t stringId = 1;
@@ -2541,6 +2977,7 @@ void Scenario::syncRemasteredBytesToStrings(const std::vector<u8> & stringBytes)
     u32 rawNumStrings = numBytes >= 4 ? (u32 &)stringBytes[0] : numBytes == 1 ? u32((u8 &)stringBytes[0]) : 0;
     size_t highestStringWithValidOffset = std::min(size_t(rawNumStrings), numBytes < 4 ? 0 : numBytes/4-1);
     strings.clear();
+    strings.reserve(highestStringWithValidOffset+2); // The 0th string, strings with in-bounds offsets & one partial offset
     strings.push_back(std::nullopt); // Fill the non-existant 0th stringId
     size_t stringId = 1;
     size_t sectionLastCharacter = 0;
@@ -2614,6 +3051,7 @@ void Scenario::syncBytesToKstrings(const std::vector<u8> & stringBytes)
     size_t highestStringWithValidProperties = std::min(size_t(rawNumStrings), numBytes < 12 ? 0 : (numBytes-8)/8);
     size_t propertiesStartMinusFour = sizeof(u32)+sizeof(u32)*rawNumStrings;
     editorStrings.clear();
+    editorStrings.reserve(highestStringWithValidOffset+2); // The 0th string, strings with in-bounds offsets & one partial offset
     editorStrings.push_back(std::nullopt); // Fill the non-existant 0th stringId
 
     size_t stringId = 1;
@@ -2665,18 +3103,18 @@ size_t Scenario::loadString(const std::vector<u8> & stringBytes, const size_t &
             auto nullIndex = std::distance(stringBytes.begin(), nextNull);
             if ( size_t(nullIndex) >= stringOffset ) // Regular string
             {
-                strings.push_back(&stringBytes[stringOffset]);
+                strings.emplace_back(std::in_place, (const char*)&stringBytes[stringOffset], size_t(nullIndex)-stringOffset, getMemoryResource());
                 return nullIndex;
             }
             else // String ends where section ends
             {
-                strings.push_back(std::string((const char*)&stringBytes[stringOffset], sectionSize-stringOffset));
+                strings.emplace_back(std::in_place, (const char*)&stringBytes[stringOffset], sectionSize-stringOffset, getMemoryResource());
                 return sectionSize-1;
             }
         }
         else if ( sectionSize > stringOffset ) // String ends where section ends
         {
-            strings.push_back(std::string((const char*)&stringBytes[stringOffset], sectionSize-stringOffset));
+            strings.emplace_back(std::in_place, (const char*)&stringBytes[stringOffset], sectionSize-stringOffset, getMemoryResource());
             return sectionSize-1;
         }
         else // Character data would be out of bounds
@@ -2697,12 +3135,12 @@ void Scenario::loadKstring(const std::vector<u8> & stringBytes, const size_t & s
         {
             auto nullIndex = std::distance(stringBytes.begin(), nextNull);
             if ( size_t(nullIndex) >= stringOffset ) // Regular string
-                editorStrings.push_back(std::string((const char*)&stringBytes[stringOffset]));
+                editorStrings.emplace_back(std::in_place, (const char*)&stringBytes[stringOffset], size_t(nullIndex)-stringOffset, getMemoryResource());
             else // String ends where section ends
-                editorStrings.push_back(std::string((const char*)&stringBytes[stringOffset], sectionSize-stringOffset));
+                editorStrings.emplace_back(std::in_place, (const char*)&stringBytes[stringOffset], sectionSize-stringOffset, getMemoryResource());
         }
         else if ( sectionSize > stringOffset ) // String ends where section ends
-            editorStrings.push_back(std::string((const char*)&stringBytes[stringOffset], sectionSize-stringOffset));
+            editorStrings.emplace_back(std::in_place, (const char*)&stringBytes[stringOffset], sectionSize-stringOffset, getMemoryResource());
         else // Character data would be out of bounds
             editorStrings.push_back(std::nullopt);
     }
@@ -2715,6 +3153,9 @@ void Scenario::upgradeKstrToCurrent()
     if ( this->editorStringsVersion >= Chk::KstrVersion::Current )
         return;
 
+    markDirty({SectionName::STR, SectionName::STRx, SectionName::KSTR, SectionName::OSTR, SectionName::SPRP, SectionName::FORC, SectionName::WAV,
+        SectionName::UNIS, SectionName::UNIx, SectionName::SWNM, SectionName::MRGN, SectionName::TRIG, SectionName::MBRF});
+
     auto ver = this->editorStringsVersion;
     if ( 0 == ver || 2 == ver )
     {
@@ -2963,11 +3404,13 @@ std::vector<std::optional<ScStr>> Scenario::copyStrings() const
 
 void Scenario::swapStrings(std::vector<std::optional<ScStr>> & strings)
 {
+    markDirty({SectionName::STR, SectionName::STRx});
     this->strings.swap(strings);
 }
 
 bool Scenario::defragment(Chk::StrScope storageScope, bool matchCapacityToUsage)
 {
+    markDirty({SectionName::STR, SectionName::STRx, SectionName::KSTR});
     if ( storageScope & Chk::StrScope::Game )
     {
         size_t nextCandidateStringId = 0;
@@ -3027,6 +3470,7 @@ bool Scenario::defragment(Chk::StrScope storageScope, bool matchCapacityToUsage)
 
 void Scenario::remapStringIds(const std::map<u32, u32> & stringIdRemappings, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::SPRP, SectionName::OSTR});
     if ( storageScope == Chk::StrScope::Game )
     {
         auto scenarioNameRemapping = stringIdRemappings.find(this->scenarioProperties.scenarioNameStringId);
@@ -3125,6 +3569,7 @@ Sc::Player::SlotType Scenario::getSlotType(size_t slotIndex, Chk::StrScope scope
 
 void Scenario::setSlotType(size_t slotIndex, Sc::Player::SlotType slotType, Chk::StrScope scope)
 {
+    markDirty({SectionName::IOWN, SectionName::OWNR});
     if ( slotIndex >= Sc::Player::Total )
         throw std::out_of_range(std::string("SlotIndex: ") + std::to_string(slotIndex) + " is out of range for the OWNR/IOWN sections!");
 
@@ -3146,6 +3591,7 @@ Chk::Race Scenario::getPlayerRace(size_t playerIndex) const
 
 void Scenario::setPlayerRace(size_t playerIndex, Chk::Race race)
 {
+    markDirty({SectionName::SIDE});
     if ( playerIndex < Sc::Player::Total )
         this->playerRaces[playerIndex] = race;
     else
@@ -3162,6 +3608,7 @@ Chk::PlayerColor Scenario::getPlayerColor(size_t slotIndex) const
 
 void Scenario::setPlayerColor(size_t slotIndex, Chk::PlayerColor color)
 {
+    markDirty({SectionName::COLR, SectionName::CRGB});
     if ( slotIndex < Sc::Player::TotalSlots )
     {
         if ( isUsingRemasteredColors() )
@@ -3203,6 +3650,7 @@ u8 Scenario::getForceFlags(Chk::Force force) const
 
 void Scenario::setPlayerForce(size_t slotIndex, Chk::Force force)
 {
+    markDirty({SectionName::FORC});
     if ( slotIndex < Sc::Player::TotalSlots )
         this->forces.playerForce[slotIndex] = force;
     else
@@ -3211,6 +3659,7 @@ void Scenario::setPlayerForce(size_t slotIndex, Chk::Force force)
 
 void Scenario::setForceStringId(Chk::Force force, u16 forceStringId)
 {
+    markDirty({SectionName::FORC});
     if ( force < Chk::TotalForces )
         this->forces.forceString[(size_t)force] = forceStringId;
     else
@@ -3219,6 +3668,7 @@ void Scenario::setForceStringId(Chk::Force force, u16 forceStringId)
 
 void Scenario::setForceFlags(Chk::Force force, u8 forceFlags)
 {
+    markDirty({SectionName::FORC});
     if ( force < Chk::TotalForces )
         this->forces.flags[force] = Chk::ForceFlags(forceFlags);
     else
@@ -3258,6 +3708,7 @@ void Scenario::markUsedForceStrings(std::bitset<Chk::MaxStrings> & stringIdUsed,
 
 void Scenario::remapForceStringIds(const std::map<u32, u32> & stringIdRemappings)
 {
+    markDirty({SectionName::FORC});
     auto forceOneRemapping = stringIdRemappings.find(this->forces.forceString[0]);
     auto forceTwoRemapping = stringIdRemappings.find(this->forces.forceString[1]);
     auto forceThreeRemapping = stringIdRemappings.find(this->forces.forceString[2]);
@@ -3278,6 +3729,7 @@ void Scenario::remapForceStringIds(const std::map<u32, u32> & stringIdRemappings
 
 void Scenario::deleteForceString(size_t stringId)
 {
+    markDirty({SectionName::FORC});
     for ( size_t i=0; i<Chk::TotalForces; i++ )
     {
         if ( this->forces.forceString[i] == stringId )
@@ -3294,6 +3746,7 @@ void Scenario::upgradeToRemasteredColors()
 {
     if ( !hasSection(SectionName::CRGB) )
     {
+        markDirty({SectionName::CRGB});
         addSection(Section{SectionName::CRGB});
         for ( size_t i=0; i<Sc::Player::TotalSlots; ++i )
         {
@@ -3315,6 +3768,7 @@ Chk::PlayerColorSetting Scenario::getPlayerColorSetting(size_t playerIndex)
 
 void Scenario::setPlayerColorSetting(size_t playerIndex, Chk::PlayerColorSetting setting)
 {
+    markDirty({SectionName::CRGB});
     if ( playerIndex < Sc::Player::TotalSlots )
     {
         upgradeToRemasteredColors();
@@ -3336,6 +3790,7 @@ Chk::Rgb Scenario::getPlayerCustomColor(size_t playerIndex)
 
 void Scenario::setPlayerCustomColor(size_t playerIndex, Chk::Rgb rgb)
 {
+    markDirty({SectionName::CRGB});
     if ( playerIndex < Sc::Player::TotalSlots )
     {
         upgradeToRemasteredColors();
@@ -3354,6 +3809,7 @@ Sc::Terrain::Tileset Scenario::getTileset() const
 
 void Scenario::setTileset(Sc::Terrain::Tileset tileset)
 {
+    markDirty({SectionName::ERA});
     this->tileset = tileset;
 }
 
@@ -3523,6 +3979,7 @@ void setMtxmOrTileDimensions(std::vector<u16> & tiles, u16 newTileWidth, u16 new
 
 void Scenario::setTileWidth(u16 newTileWidth, u16 sizeValidationFlags, s32 leftEdge)
 {
+    markDirty({SectionName::DIM, SectionName::MTXM, SectionName::ISOM, SectionName::TILE});
     u16 tileWidth = this->dimensions.tileWidth;
     u16 tileHeight = this->dimensions.tileHeight;
     ::setIsomDimensions(this->isomRects, newTileWidth, tileHeight, tileWidth, tileHeight, leftEdge, 0);
@@ -3534,6 +3991,7 @@ void Scenario::setTileWidth(u16 newTileWidth, u16 sizeValidationFlags, s32 leftE
 
 void Scenario::setTileHeight(u16 newTileHeight, u16 sizeValidationFlags, s32 topEdge)
 {
+    markDirty({SectionName::DIM, SectionName::MTXM, SectionName::ISOM, SectionName::TILE});
     u16 tileWidth = this->dimensions.tileWidth;
     u16 tileHeight = this->dimensions.tileHeight;
     ::setIsomDimensions(this->isomRects, tileWidth, newTileHeight, tileWidth, tileHeight, 0, topEdge);
@@ -3545,6 +4003,7 @@ void Scenario::setTileHeight(u16 newTileHeight, u16 sizeValidationFlags, s32 top
 
 void Scenario::setDimensions(u16 newTileWidth, u16 newTileHeight, u16 sizeValidationFlags, s32 leftEdge, s32 topEdge)
 {
+    markDirty({SectionName::DIM, SectionName::MTXM, SectionName::ISOM, SectionName::TILE});
     u16 tileWidth = this->dimensions.tileWidth;
     u16 tileHeight = this->dimensions.tileHeight;
     ::setIsomDimensions(this->isomRects, newTileWidth, newTileHeight, tileWidth, tileHeight, leftEdge, topEdge);
@@ -3590,6 +4049,7 @@ inline u16 Scenario::getTilePx(size_t pixelXc, size_t pixelYc, Chk::StrScope sco
 
 void Scenario::setTile(size_t tileXc, size_t tileYc, u16 tileValue, Chk::StrScope scope)
 {
+    markDirty({SectionName::MTXM, SectionName::TILE});
     size_t tileWidth = this->dimensions.tileWidth;
     size_t tileIndex = tileYc*tileWidth + tileXc;
     if ( scope & Chk::StrScope::Game )
@@ -3642,7 +4102,10 @@ void Scenario::fixTerrainToDimensions()
     auto tileWidth = this->dimensions.tileWidth;
     auto tileHeight = this->dimensions.tileHeight;
     if ( this->tiles.size() != size_t(tileWidth)*size_t(tileHeight) )
+    {
+        markDirty({SectionName::MTXM});
         setMtxmOrTileDimensions(this->tiles, tileWidth, tileHeight, tileWidth, tileHeight, 0, 0);
+    }
 }
 
 u8 Scenario::getFog(size_t tileXc, size_t tileYc) const
@@ -3662,6 +4125,7 @@ u8 Scenario::getFogPx(size_t pixelXc, size_t pixelYc) const
 
 void Scenario::setFog(size_t tileXc, size_t tileYc, u8 fogOfWarPlayers)
 {
+    markDirty({SectionName::MASK});
     size_t tileWidth = this->dimensions.tileWidth;
     size_t tileIndex = tileWidth*tileYc + tileXc;
     
@@ -3683,6 +4147,7 @@ size_t Scenario::numSprites() const
 
 Chk::Sprite & Scenario::getSprite(size_t spriteIndex)
 {
+    markDirty({SectionName::THG2});
     return this->sprites[spriteIndex];
 }
 
@@ -3693,12 +4158,14 @@ const Chk::Sprite & Scenario::getSprite(size_t spriteIndex) const
 
 size_t Scenario::addSprite(const Chk::Sprite & sprite)
 {
+    markDirty({SectionName::THG2});
     this->sprites.push_back(sprite);
     return sprites.size()-1;
 }
 
 void Scenario::insertSprite(size_t spriteIndex, const Chk::Sprite & sprite)
 {
+    markDirty({SectionName::THG2});
     if ( spriteIndex < sprites.size() )
     {
         auto position = std::next(sprites.begin(), spriteIndex);
@@ -3710,6 +4177,7 @@ void Scenario::insertSprite(size_t spriteIndex, const Chk::Sprite & sprite)
 
 void Scenario::deleteSprite(size_t spriteIndex)
 {
+    markDirty({SectionName::THG2});
     if ( spriteIndex < sprites.size() )
     {
         auto sprite = std::next(sprites.begin(), spriteIndex);
@@ -3719,6 +4187,7 @@ void Scenario::deleteSprite(size_t spriteIndex)
 
 void Scenario::moveSprite(size_t spriteIndexFrom, size_t spriteIndexTo)
 {
+    markDirty({SectionName::THG2});
     size_t spriteIndexMin = std::min(spriteIndexFrom, spriteIndexTo);
     size_t spriteIndexMax = std::max(spriteIndexFrom, spriteIndexTo);
     if ( spriteIndexMax < sprites.size() && spriteIndexFrom != spriteIndexTo )
@@ -3773,6 +4242,7 @@ size_t Scenario::numDoodads() const
 
 Chk::Doodad & Scenario::getDoodad(size_t doodadIndex)
 {
+    markDirty({SectionName::DD2});
     return doodads[doodadIndex];
 }
 
@@ -3783,12 +4253,14 @@ const Chk::Doodad & Scenario::getDoodad(size_t doodadIndex) const
 
 size_t Scenario::addDoodad(const Chk::Doodad & doodad)
 {
+    markDirty({SectionName::DD2});
     doodads.push_back(doodad);
     return doodads.size()-1;
 }
 
 void Scenario::insertDoodad(size_t doodadIndex, const Chk::Doodad & doodad)
 {
+    markDirty({SectionName::DD2});
     if ( doodadIndex < doodads.size() )
     {
         auto position = std::next(doodads.begin(), doodadIndex);
@@ -3800,6 +4272,7 @@ void Scenario::insertDoodad(size_t doodadIndex, const Chk::Doodad & doodad)
 
 void Scenario::deleteDoodad(size_t doodadIndex)
 {
+    markDirty({SectionName::DD2});
     if ( doodadIndex < doodads.size() )
     {
         auto doodad = std::next(doodads.begin(), doodadIndex);
@@ -3809,6 +4282,7 @@ void Scenario::deleteDoodad(size_t doodadIndex)
 
 void Scenario::moveDoodad(size_t doodadIndexFrom, size_t doodadIndexTo)
 {
+    markDirty({SectionName::DD2});
     size_t doodadIndexMin = std::min(doodadIndexFrom, doodadIndexTo);
     size_t doodadIndexMax = std::max(doodadIndexFrom, doodadIndexTo);
     if ( doodadIndexMax < doodads.size() && doodadIndexFrom != doodadIndexTo )
@@ -3846,6 +4320,7 @@ size_t Scenario::numUnits() const
 
 Chk::Unit & Scenario::getUnit(size_t unitIndex)
 {
+    markDirty({SectionName::UNIT});
     return this->units[unitIndex];
 }
 
@@ -3856,12 +4331,14 @@ const Chk::Unit & Scenario::getUnit(size_t unitIndex) const
 
 size_t Scenario::addUnit(const Chk::Unit & unit)
 {
+    markDirty({SectionName::UNIT});
     units.push_back(unit);
     return units.size()-1;
 }
 
 void Scenario::insertUnit(size_t unitIndex, const Chk::Unit & unit)
 {
+    markDirty({SectionName::UNIT});
     if ( unitIndex < units.size() )
     {
         auto position = std::next(units.begin(), unitIndex);
@@ -3873,6 +4350,7 @@ void Scenario::insertUnit(size_t unitIndex, const Chk::Unit & unit)
 
 void Scenario::deleteUnit(size_t unitIndex)
 {
+    markDirty({SectionName::UNIT});
     if ( unitIndex < units.size() )
     {
         auto unit = std::next(units.begin(), unitIndex);
@@ -3882,6 +4360,7 @@ void Scenario::deleteUnit(size_t unitIndex)
 
 void Scenario::moveUnit(size_t unitIndexFrom, size_t unitIndexTo)
 {
+    markDirty({SectionName::UNIT});
     size_t unitIndexMin = std::min(unitIndexFrom, unitIndexTo);
     size_t unitIndexMax = std::max(unitIndexFrom, unitIndexTo);
     if ( unitIndexMax < units.size() && unitIndexFrom != unitIndexTo )
@@ -3935,6 +4414,7 @@ size_t Scenario::numLocations() const
 
 Chk::Location & Scenario::getLocation(size_t locationId)
 {
+    markDirty({SectionName::MRGN});
     return locations[locationId];
 }
 
@@ -3945,6 +4425,7 @@ const Chk::Location & Scenario::getLocation(size_t locationId) const
 
 size_t Scenario::addLocation(const Chk::Location & location)
 {
+    markDirty({SectionName::MRGN});
     for ( size_t i=1; i<locations.size(); i++ )
     {
         if ( isBlank(i) )
@@ -3958,6 +4439,7 @@ size_t Scenario::addLocation(const Chk::Location & location)
 
 void Scenario::replaceLocation(size_t locationId, const Chk::Location & location)
 {
+    markDirty({SectionName::MRGN});
     if ( locationId > 0 && locationId < locations.size() )
     {
         if ( isBlank(locationId) )
@@ -3969,6 +4451,7 @@ void Scenario::replaceLocation(size_t locationId, const Chk::Location & location
 
 void Scenario::deleteLocation(size_t locationId, bool deleteOnlyIfUnused)
 {
+    markDirty({SectionName::MRGN});
     if ( !deleteOnlyIfUnused || !this->triggerLocationUsed(locationId) )
     {
         if ( locationId > 0 && locationId < locations.size() )
@@ -3986,6 +4469,7 @@ void Scenario::deleteLocation(size_t locationId, bool deleteOnlyIfUnused)
 
 bool Scenario::moveLocation(size_t locationIdFrom, size_t locationIdTo, bool lockAnywhere)
 {
+    markDirty({SectionName::MRGN});
     size_t locationIdMin = std::min(locationIdFrom, locationIdTo);
     size_t locationIdMax = std::max(locationIdFrom, locationIdTo);
     if ( locationIdFrom > 0 && locationIdTo > 0 && locationIdMax < locations.size() && locationIdFrom != locationIdTo &&
@@ -4086,6 +4570,7 @@ bool Scenario::trimLocationsToOriginal(bool lockAnywhere, bool autoDefragment)
 
         if ( countUsedOrCreated <= Chk::TotalOriginalLocations )
         {
+            markDirty({SectionName::MRGN});
             std::map<u32, u32> locationIdRemappings;
             for ( size_t firstUnused=1; firstUnused<=Chk::TotalLocations; firstUnused++ )
             {
@@ -4116,6 +4601,9 @@ bool Scenario::trimLocationsToOriginal(bool lockAnywhere, bool autoDefragment)
 void Scenario::expandToScHybridOrExpansion()
 {
     size_t numLocations = locations.size();
+    if ( numLocations <= Chk::TotalLocations )
+        markDirty({SectionName::MRGN});
+
     for ( size_t i=numLocations; i<=Chk::TotalLocations; i++ )
         locations.push_back(Chk::Location{});
 }
@@ -4198,6 +4686,7 @@ void Scenario::markUsedLocationStrings(std::bitset<Chk::MaxStrings> & stringIdUs
 
 void Scenario::remapLocationStringIds(const std::map<u32, u32> & stringIdRemappings)
 {
+    markDirty({SectionName::MRGN});
     for ( size_t i=1; i<locations.size(); i++ )
     {
         auto & location = locations[i];
@@ -4209,6 +4698,7 @@ void Scenario::remapLocationStringIds(const std::map<u32, u32> & stringIdRemappi
 
 void Scenario::deleteLocationString(size_t stringId)
 {
+    markDirty({SectionName::MRGN});
     for ( size_t i=1; i<locations.size(); i++ )
     {
         auto & location = locations[i];
@@ -4314,6 +4804,7 @@ u16 Scenario::getWeaponUpgradeDamage(Sc::Weapon::Type weaponType, Chk::UseExpSec
 
 void Scenario::setUnitUsesDefaultSettings(Sc::Unit::Type unitType, bool useDefault, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     if ( unitType >= Sc::Unit::TotalTypes )
         throw std::out_of_range(std::string("UnitType: ") + std::to_string(unitType) + " is out of range for the UNIS/UNIx section!");
 
@@ -4341,6 +4832,7 @@ void Scenario::setUnitUsesDefaultSettings(Sc::Unit::Type unitType, bool useDefau
 
 void Scenario::setUnitHitpoints(Sc::Unit::Type unitType, u32 hitpoints, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     if ( unitType >= Sc::Unit::TotalTypes )
         throw std::out_of_range(std::string("UnitType: ") + std::to_string(unitType) + " is out of range for the UNIS/UNIx section!");
 
@@ -4367,6 +4859,7 @@ void Scenario::setUnitHitpoints(Sc::Unit::Type unitType, u32 hitpoints, Chk::Use
 
 void Scenario::setUnitShieldPoints(Sc::Unit::Type unitType, u16 shieldPoints, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     if ( unitType >= Sc::Unit::TotalTypes )
         throw std::out_of_range(std::string("UnitType: ") + std::to_string(unitType) + " is out of range for the UNIS/UNIx section!");
 
@@ -4393,6 +4886,7 @@ void Scenario::setUnitShieldPoints(Sc::Unit::Type unitType, u16 shieldPoints, Ch
 
 void Scenario::setUnitArmorLevel(Sc::Unit::Type unitType, u8 armorLevel, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     if ( unitType >= Sc::Unit::TotalTypes )
         throw std::out_of_range(std::string("UnitType: ") + std::to_string(unitType) + " is out of range for the UNIS/UNIx section!");
 
@@ -4419,6 +4913,7 @@ void Scenario::setUnitArmorLevel(Sc::Unit::Type unitType, u8 armorLevel, Chk::Us
 
 void Scenario::setUnitBuildTime(Sc::Unit::Type unitType, u16 buildTime, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     if ( unitType >= Sc::Unit::TotalTypes )
         throw std::out_of_range(std::string("UnitType: ") + std::to_string(unitType) + " is out of range for the UNIS/UNIx section!");
 
@@ -4445,6 +4940,7 @@ void Scenario::setUnitBuildTime(Sc::Unit::Type unitType, u16 buildTime, Chk::Use
 
 void Scenario::setUnitMineralCost(Sc::Unit::Type unitType, u16 mineralCost, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     if ( unitType >= Sc::Unit::TotalTypes )
         throw std::out_of_range(std::string("UnitType: ") + std::to_string(unitType) + " is out of range for the UNIS/UNIx section!");
 
@@ -4471,6 +4967,7 @@ void Scenario::setUnitMineralCost(Sc::Unit::Type unitType, u16 mineralCost, Chk:
 
 void Scenario::setUnitGasCost(Sc::Unit::Type unitType, u16 gasCost, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     if ( unitType >= Sc::Unit::TotalTypes )
         throw std::out_of_range(std::string("UnitType: ") + std::to_string(unitType) + " is out of range for the UNIS/UNIx section!");
 
@@ -4497,6 +4994,7 @@ void Scenario::setUnitGasCost(Sc::Unit::Type unitType, u16 gasCost, Chk::UseExpS
 
 void Scenario::setWeaponBaseDamage(Sc::Weapon::Type weaponType, u16 baseDamage, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     auto checkLimit = [&weaponType](bool expansion){
         if ( (expansion && weaponType >= Sc::Weapon::Total) || (!expansion && weaponType >= Sc::Weapon::TotalOriginal) )
             throw std::out_of_range(std::string("WeaponType: ") + std::to_string((size_t)weaponType) +
@@ -4538,6 +5036,7 @@ void Scenario::setWeaponBaseDamage(Sc::Weapon::Type weaponType, u16 baseDamage,
 
 void Scenario::setWeaponUpgradeDamage(Sc::Weapon::Type weaponType, u16 upgradeDamage, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     auto checkLimit = [&weaponType](bool expansion){
         if ( (expansion && weaponType >= Sc::Weapon::Total) || (!expansion && weaponType >= Sc::Weapon::TotalOriginal) )
             throw std::out_of_range(std::string("WeaponType: ") + std::to_string((size_t)weaponType) +
@@ -4613,6 +5112,7 @@ bool Scenario::playerUsesDefaultUnitBuildability(Sc::Unit::Type unitType, size_t
 
 void Scenario::setUnitBuildable(Sc::Unit::Type unitType, size_t playerIndex, bool buildable)
 {
+    markDirty({SectionName::PUNI});
     Chk::Available unitBuildable = buildable ? Chk::Available::Yes : Chk::Available::No;
     if ( unitType < Sc::Unit::TotalTypes )
     {
@@ -4627,6 +5127,7 @@ void Scenario::setUnitBuildable(Sc::Unit::Type unitType, size_t playerIndex, boo
 
 void Scenario::setUnitDefaultBuildable(Sc::Unit::Type unitType, bool buildable)
 {
+    markDirty({SectionName::PUNI});
     Chk::Available unitDefaultBuildable = buildable ? Chk::Available::Yes : Chk::Available::No;
     if ( unitType < Sc::Unit::TotalTypes )
         this->unitAvailability.defaultUnitBuildable[unitType] = unitDefaultBuildable;
@@ -4636,6 +5137,7 @@ void Scenario::setUnitDefaultBuildable(Sc::Unit::Type unitType, bool buildable)
 
 void Scenario::setPlayerUsesDefaultUnitBuildability(Sc::Unit::Type unitType, size_t playerIndex, bool useDefault)
 {
+    markDirty({SectionName::PUNI});
     Chk::UseDefault playerUnitUsesDefault = useDefault ? Chk::UseDefault::Yes : Chk::UseDefault::No;
     if ( unitType < Sc::Unit::TotalTypes )
     {
@@ -4650,6 +5152,7 @@ void Scenario::setPlayerUsesDefaultUnitBuildability(Sc::Unit::Type unitType, siz
 
 void Scenario::setUnitsToDefault(Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::PUNI, SectionName::UNIS, SectionName::UNIx});
     switch ( useExp )
     {
         case Chk::UseExpSection::Auto:
@@ -4777,6 +5280,7 @@ u16 Scenario::getUpgradeResearchTimeFactor(Sc::Upgrade::Type upgradeType, Chk::U
 
 void Scenario::setUpgradeUsesDefaultCosts(Sc::Upgrade::Type upgradeType, bool useDefault, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGS, SectionName::UPGx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string((size_t)upgradeType) +
@@ -4819,6 +5323,7 @@ void Scenario::setUpgradeUsesDefaultCosts(Sc::Upgrade::Type upgradeType, bool us
 
 void Scenario::setUpgradeBaseMineralCost(Sc::Upgrade::Type upgradeType, u16 baseMineralCost, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGS, SectionName::UPGx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string((size_t)upgradeType) +
@@ -4860,6 +5365,7 @@ void Scenario::setUpgradeBaseMineralCost(Sc::Upgrade::Type upgradeType, u16 base
 
 void Scenario::setUpgradeMineralCostFactor(Sc::Upgrade::Type upgradeType, u16 mineralCostFactor, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGS, SectionName::UPGx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string((size_t)upgradeType) +
@@ -4901,6 +5407,7 @@ void Scenario::setUpgradeMineralCostFactor(Sc::Upgrade::Type upgradeType, u16 mi
 
 void Scenario::setUpgradeBaseGasCost(Sc::Upgrade::Type upgradeType, u16 baseGasCost, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGS, SectionName::UPGx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string((size_t)upgradeType) +
@@ -4942,6 +5449,7 @@ void Scenario::setUpgradeBaseGasCost(Sc::Upgrade::Type upgradeType, u16 baseGasC
 
 void Scenario::setUpgradeGasCostFactor(Sc::Upgrade::Type upgradeType, u16 gasCostFactor, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGS, SectionName::UPGx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string((size_t)upgradeType) +
@@ -4983,6 +5491,7 @@ void Scenario::setUpgradeGasCostFactor(Sc::Upgrade::Type upgradeType, u16 gasCos
 
 void Scenario::setUpgradeBaseResearchTime(Sc::Upgrade::Type upgradeType, u16 baseResearchTime, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGS, SectionName::UPGx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string((size_t)upgradeType) +
@@ -5024,6 +5533,7 @@ void Scenario::setUpgradeBaseResearchTime(Sc::Upgrade::Type upgradeType, u16 bas
 
 void Scenario::setUpgradeResearchTimeFactor(Sc::Upgrade::Type upgradeType, u16 researchTimeFactor, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGS, SectionName::UPGx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string((size_t)upgradeType) +
@@ -5131,6 +5641,7 @@ bool Scenario::playerUsesDefaultUpgradeLeveling(Sc::Upgrade::Type upgradeType, s
 
 void Scenario::setMaxUpgradeLevel(Sc::Upgrade::Type upgradeType, size_t playerIndex, size_t maxUpgradeLevel, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGR, SectionName::PUPx});
     auto checkLimit = [&upgradeType, &playerIndex](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string(upgradeType) + " is out of range for the " + (expansion ? "PUPx" : "UPGR") + " section!");
@@ -5173,6 +5684,7 @@ void Scenario::setMaxUpgradeLevel(Sc::Upgrade::Type upgradeType, size_t playerIn
 
 void Scenario::setStartUpgradeLevel(Sc::Upgrade::Type upgradeType, size_t playerIndex, size_t startUpgradeLevel, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGR, SectionName::PUPx});
     auto checkLimit = [&upgradeType, &playerIndex](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string(upgradeType) + " is out of range for the " + (expansion ? "PUPx" : "UPGR") + " section!");
@@ -5215,6 +5727,7 @@ void Scenario::setStartUpgradeLevel(Sc::Upgrade::Type upgradeType, size_t player
 
 void Scenario::setDefaultMaxUpgradeLevel(Sc::Upgrade::Type upgradeType, size_t maxUpgradeLevel, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGR, SectionName::PUPx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string(upgradeType) + " is out of range for the " + (expansion ? "PUPx" : "UPGR") + " section!");
@@ -5255,6 +5768,7 @@ void Scenario::setDefaultMaxUpgradeLevel(Sc::Upgrade::Type upgradeType, size_t m
 
 void Scenario::setDefaultStartUpgradeLevel(Sc::Upgrade::Type upgradeType, size_t startUpgradeLevel, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGR, SectionName::PUPx});
     auto checkLimit = [&upgradeType](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string(upgradeType) + " is out of range for the " + (expansion ? "PUPx" : "UPGR") + " section!");
@@ -5295,6 +5809,7 @@ void Scenario::setDefaultStartUpgradeLevel(Sc::Upgrade::Type upgradeType, size_t
 
 void Scenario::setPlayerUsesDefaultUpgradeLeveling(Sc::Upgrade::Type upgradeType, size_t playerIndex, bool useDefault, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGR, SectionName::PUPx});
     auto checkLimit = [&upgradeType, &playerIndex](bool expansion){
         if ( (expansion && upgradeType >= Sc::Upgrade::TotalTypes) || (!expansion && upgradeType >= Sc::Upgrade::TotalOriginalTypes) )
             throw std::out_of_range(std::string("UpgradeType: ") + std::to_string(upgradeType) + " is out of range for the " + (expansion ? "PUPx" : "UPGR") + " section!");
@@ -5338,6 +5853,7 @@ void Scenario::setPlayerUsesDefaultUpgradeLeveling(Sc::Upgrade::Type upgradeType
 
 void Scenario::setUpgradesToDefault(Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::UPGR, SectionName::UPGS, SectionName::PUPx, SectionName::UPGx});
     switch ( useExp )
     {
         case Chk::UseExpSection::Auto:
@@ -5450,6 +5966,7 @@ u16 Scenario::getTechEnergyCost(Sc::Tech::Type techType, Chk::UseExpSection useE
 
 void Scenario::setTechUsesDefaultSettings(Sc::Tech::Type techType, bool useDefault, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::TECS, SectionName::TECx});
     auto checkLimit = [&techType](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "TECx" : "TECS") + " section!");
@@ -5491,6 +6008,7 @@ void Scenario::setTechUsesDefaultSettings(Sc::Tech::Type techType, bool useDefau
 
 void Scenario::setTechMineralCost(Sc::Tech::Type techType, u16 mineralCost, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::TECS, SectionName::TECx});
     auto checkLimit = [&techType](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "TECx" : "TECS") + " section!");
@@ -5531,6 +6049,7 @@ void Scenario::setTechMineralCost(Sc::Tech::Type techType, u16 mineralCost, Chk:
 
 void Scenario::setTechGasCost(Sc::Tech::Type techType, u16 gasCost, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::TECS, SectionName::TECx});
     auto checkLimit = [&techType](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "TECx" : "TECS") + " section!");
@@ -5571,6 +6090,7 @@ void Scenario::setTechGasCost(Sc::Tech::Type techType, u16 gasCost, Chk::UseExpS
 
 void Scenario::setTechResearchTime(Sc::Tech::Type techType, u16 researchTime, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::TECS, SectionName::TECx});
     auto checkLimit = [&techType](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "TECx" : "TECS") + " section!");
@@ -5611,6 +6131,7 @@ void Scenario::setTechResearchTime(Sc::Tech::Type techType, u16 researchTime, Ch
 
 void Scenario::setTechEnergyCost(Sc::Tech::Type techType, u16 energyCost, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::TECS, SectionName::TECx});
     auto checkLimit = [&techType](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "TECx" : "TECS") + " section!");
@@ -5728,6 +6249,7 @@ bool Scenario::playerUsesDefaultTechSettings(Sc::Tech::Type techType, size_t pla
 
 void Scenario::setTechAvailable(Sc::Tech::Type techType, size_t playerIndex, bool available, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::PTEC, SectionName::PTEx});
     auto checkLimit = [&techType, &playerIndex](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "PTEx" : "PTEC") + " section!");
@@ -5771,6 +6293,7 @@ void Scenario::setTechAvailable(Sc::Tech::Type techType, size_t playerIndex, boo
 
 void Scenario::setTechResearched(Sc::Tech::Type techType, size_t playerIndex, bool researched, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::PTEC, SectionName::PTEx});
     auto checkLimit = [&techType, &playerIndex](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "PTEx" : "PTEC") + " section!");
@@ -5814,6 +6337,7 @@ void Scenario::setTechResearched(Sc::Tech::Type techType, size_t playerIndex, bo
 
 void Scenario::setDefaultTechAvailable(Sc::Tech::Type techType, bool available, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::PTEC, SectionName::PTEx});
     auto checkLimit = [&techType](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "PTEx" : "PTEC") + " section!");
@@ -5855,6 +6379,7 @@ void Scenario::setDefaultTechAvailable(Sc::Tech::Type techType, bool available,
 
 void Scenario::setDefaultTechResearched(Sc::Tech::Type techType, bool researched, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::PTEC, SectionName::PTEx});
     auto checkLimit = [&techType](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "PTEx" : "PTEC") + " section!");
@@ -5896,6 +6421,7 @@ void Scenario::setDefaultTechResearched(Sc::Tech::Type techType, bool researched
 
 void Scenario::setPlayerUsesDefaultTechSettings(Sc::Tech::Type techType, size_t playerIndex, bool useDefault, Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::PTEC, SectionName::PTEx});
     auto checkLimit = [&techType, &playerIndex](bool expansion){
         if ( (expansion && techType >= Sc::Tech::TotalTypes) || (!expansion && techType >= Sc::Tech::TotalOriginalTypes) )
             throw std::out_of_range(std::string("TechType: ") + std::to_string(techType) + " is out of range for the " + (expansion ? "PTEx" : "PTEC") + " section!");
@@ -5939,6 +6465,7 @@ void Scenario::setPlayerUsesDefaultTechSettings(Sc::Tech::Type techType, size_t
 
 void Scenario::setTechsToDefault(Chk::UseExpSection useExp)
 {
+    markDirty({SectionName::PTEC, SectionName::TECS, SectionName::PTEx, SectionName::TECx});
     switch ( useExp )
     {
         case Chk::UseExpSection::Auto:
@@ -6047,6 +6574,7 @@ void Scenario::markUsedUnitStrings(std::bitset<Chk::MaxStrings> & stringIdUsed,
 
 void Scenario::remapUnitStringIds(const std::map<u32, u32> & stringIdRemappings)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     for ( size_t i=0; i<Sc::Unit::TotalTypes; i++ )
     {
         auto found = stringIdRemappings.find(this->origUnitSettings.nameStringId[i]);
@@ -6063,6 +6591,7 @@ void Scenario::remapUnitStringIds(const std::map<u32, u32> & stringIdRemappings)
 
 void Scenario::deleteUnitString(size_t stringId)
 {
+    markDirty({SectionName::UNIS, SectionName::UNIx});
     for ( size_t i=0; i<Sc::Unit::TotalTypes; i++ )
     {
         if ( this->origUnitSettings.nameStringId[i] == stringId )
@@ -6085,12 +6614,14 @@ Chk::Cuwp Scenario::getCuwp(size_t cuwpIndex) const
 
 void Scenario::setCuwp(size_t cuwpIndex, const Chk::Cuwp & cuwp)
 {
+    markDirty({SectionName::UPRP});
     if ( cuwpIndex < Sc::Unit::MaxCuwps )
         this->createUnitProperties[cuwpIndex] = cuwp;
 }
 
 size_t Scenario::addCuwp(const Chk::Cuwp & cuwp, bool fixUsageBeforeAdding, size_t excludedTriggerIndex, size_t excludedTriggerActionIndex)
 {
+    markDirty({SectionName::UPRP, SectionName::UPUS});
     for ( size_t i = 0; i < Sc::Unit::MaxCuwps; i++ )
     {
         if ( memcmp(&cuwp, &this->createUnitProperties[i], sizeof(Chk::Cuwp)) == 0 )
@@ -6116,6 +6647,7 @@ size_t Scenario::addCuwp(const Chk::Cuwp & cuwp, bool fixUsageBeforeAdding, size
 
 void Scenario::fixCuwpUsage(size_t excludedTriggerIndex, size_t excludedTriggerActionIndex)
 {
+    markDirty({SectionName::UPUS, SectionName::TRIG});
     for ( size_t i=0; i<Sc::Unit::MaxCuwps; i++ )
         this->createUnitPropertiesUsed[i] = Chk::CuwpUsed::No;
 
@@ -6142,6 +6674,7 @@ bool Scenario::cuwpUsed(size_t cuwpIndex) const
 
 void Scenario::setCuwpUsed(size_t cuwpIndex, bool cuwpUsed)
 {
+    markDirty({SectionName::UPUS});
     if ( cuwpIndex < Sc::Unit::MaxCuwps )
         this->createUnitPropertiesUsed[cuwpIndex] = cuwpUsed ? Chk::CuwpUsed::Yes : Chk::CuwpUsed::No;
     else
@@ -6155,6 +6688,7 @@ size_t Scenario::numTriggers() const
 
 Chk::Trigger & Scenario::getTrigger(size_t triggerIndex)
 {
+    markDirty({SectionName::TRIG});
     if ( triggerIndex < this->triggers.size() )
         return this->triggers[triggerIndex];
     else
@@ -6171,12 +6705,14 @@ const Chk::Trigger & Scenario::getTrigger(size_t triggerIndex) const
 
 size_t Scenario::addTrigger(const Chk::Trigger & trigger)
 {
+    markDirty({SectionName::TRIG});
     this->triggers.push_back(trigger);
     return this->triggers.size()-1;
 }
 
 void Scenario::insertTrigger(size_t triggerIndex, const Chk::Trigger & trigger)
 {
+    markDirty({SectionName::TRIG});
     if ( triggerIndex < this->triggers.size() )
     {
         auto position = std::next(this->triggers.begin(), triggerIndex);
@@ -6190,6 +6726,7 @@ void Scenario::insertTrigger(size_t triggerIndex, const Chk::Trigger & trigger)
 
 void Scenario::deleteTrigger(size_t triggerIndex)
 {
+    markDirty({SectionName::TRIG});
     if ( triggerIndex < this->triggers.size() )
     {
         auto trigger = std::next(this->triggers.begin(), triggerIndex);
@@ -6201,6 +6738,7 @@ void Scenario::deleteTrigger(size_t triggerIndex)
 
 void Scenario::moveTrigger(size_t triggerIndexFrom, size_t triggerIndexTo)
 {
+    markDirty({SectionName::TRIG});
     size_t triggerIndexMin = std::min(triggerIndexFrom, triggerIndexTo);
     size_t triggerIndexMax = std::max(triggerIndexFrom, triggerIndexTo);
     if ( triggerIndexMax < this->triggers.size() && triggerIndexFrom != triggerIndexTo )
@@ -6221,6 +6759,7 @@ void Scenario::moveTrigger(size_t triggerIndexFrom, size_t triggerIndexTo)
 
 std::vector<Chk::Trigger> Scenario::replaceRange(size_t beginIndex, size_t endIndex, std::vector<Chk::Trigger> & triggers)
 {
+    markDirty({SectionName::TRIG});
     if ( beginIndex == 0 && endIndex == this->triggers.size() )
     {
         this->triggers.swap(triggers);
@@ -6251,6 +6790,7 @@ bool Scenario::hasTriggerExtension(size_t triggerIndex) const
 
 Chk::ExtendedTrigData & Scenario::getTriggerExtension(size_t triggerIndex, bool addIfNotFound)
 {
+    markDirty({SectionName::TRIG, SectionName::KTRG});
     if ( triggerIndex >= this->triggers.size() )
         throw std::out_of_range(std::string("TriggerIndex: ") + std::to_string(triggerIndex) + " is out of range for the TRIG section!");
 
@@ -6302,6 +6842,7 @@ const Chk::ExtendedTrigData & Scenario::getTriggerExtension(size_t triggerIndex)
 
 void Scenario::removeTriggersExtension(size_t triggerIndex)
 {
+    markDirty({SectionName::TRIG});
     if ( triggerIndex >= this->triggers.size() )
         throw std::out_of_range(std::string("TriggerIndex: ") + std::to_string(triggerIndex) + " is out of range for the TRIG section!");
 
@@ -6313,6 +6854,7 @@ void Scenario::removeTriggersExtension(size_t triggerIndex)
 
 void Scenario::deleteTriggerExtension(size_t triggerExtensionIndex)
 {
+    markDirty({SectionName::KTRG});
     if ( triggerExtensionIndex < this->triggerExtensions.size() && triggerExtensionIndex != Chk::ExtendedTrigDataIndex::None )
     {
         size_t i = this->triggerExtensions.size();
@@ -6339,14 +6881,24 @@ void Scenario::fixTriggerExtensions()
         if ( extendedDataIndex != Chk::ExtendedTrigDataIndex::None )
         {
             if ( extendedDataIndex >= this->triggerExtensions.size() )
+            {
+                markDirty({SectionName::TRIG});
                 trigger.clearExtendedDataIndex();
+            }
             else if ( usedExtendedTrigDataIndexes.find(extendedDataIndex) == usedExtendedTrigDataIndexes.end() ) // Valid extension
             {
-                this->triggerExtensions[extendedDataIndex].trigNum = (u32)i; // Ensure the trigNum is correct
+                if ( this->triggerExtensions[extendedDataIndex].trigNum != (u32)i )
+                {
+                    markDirty({SectionName::KTRG});
+                    this->triggerExtensions[extendedDataIndex].trigNum = (u32)i; // Ensure the trigNum is correct
+                }
                 usedExtendedTrigDataIndexes.insert(extendedDataIndex);
             }
             else // Same extension used by multiple triggers
+            {
+                markDirty({SectionName::TRIG});
                 trigger.clearExtendedDataIndex();
+            }
         }
     }
 
@@ -6361,6 +6913,7 @@ void Scenario::fixTriggerExtensions()
                 if ( extension.trigNum < this->triggers.size() && // this trigger exists without an extension
                     this->triggers[extension.trigNum].getExtendedDataIndex() == Chk::ExtendedTrigDataIndex::None )
                 {
+                    markDirty({SectionName::TRIG});
                     this->triggers[extension.trigNum].setExtendedDataIndex(i); // Link up extension to the trigger
                 }
                 else // Trigger does not exist
@@ -6425,6 +6978,7 @@ size_t Scenario::numBriefingTriggers() const
 
 Chk::Trigger & Scenario::getBriefingTrigger(size_t briefingTriggerIndex)
 {
+    markDirty({SectionName::MBRF});
     if ( briefingTriggerIndex < this->briefingTriggers.size() )
         return this->briefingTriggers[briefingTriggerIndex];
     else
@@ -6441,12 +6995,14 @@ const Chk::Trigger & Scenario::getBriefingTrigger(size_t briefingTriggerIndex) c
 
 size_t Scenario::addBriefingTrigger(const Chk::Trigger & briefingTrigger)
 {
+    markDirty({SectionName::MBRF});
     this->briefingTriggers.push_back(briefingTrigger);
     return this->briefingTriggers.size()-1;
 }
 
 void Scenario::insertBriefingTrigger(size_t briefingTriggerIndex, const Chk::Trigger & briefingTrigger)
 {
+    markDirty({SectionName::MBRF});
     
     if ( briefingTriggerIndex < this->briefingTriggers.size() )
     {
@@ -6459,6 +7015,7 @@ void Scenario::insertBriefingTrigger(size_t briefingTriggerIndex, const Chk::Tri
 
 void Scenario::deleteBriefingTrigger(size_t briefingTriggerIndex)
 {
+    markDirty({SectionName::MBRF});
     if ( briefingTriggerIndex < briefingTriggers.size() )
     {
         auto briefingTrigger = std::next(briefingTriggers.begin(), briefingTriggerIndex);
@@ -6468,6 +7025,7 @@ void Scenario::deleteBriefingTrigger(size_t briefingTriggerIndex)
 
 void Scenario::moveBriefingTrigger(size_t briefingTriggerIndexFrom, size_t briefingTriggerIndexTo)
 {
+    markDirty({SectionName::MBRF});
     size_t briefingTriggerIndexMin = std::min(briefingTriggerIndexFrom, briefingTriggerIndexTo);
     size_t briefingTriggerIndexMax = std::max(briefingTriggerIndexFrom, briefingTriggerIndexTo);
     if ( briefingTriggerIndexMax < briefingTriggers.size() && briefingTriggerIndexFrom != briefingTriggerIndexTo )
@@ -6487,6 +7045,7 @@ void Scenario::moveBriefingTrigger(size_t briefingTriggerIndexFrom, size_t brief
 
 size_t Scenario::addSound(size_t stringId)
 {
+    markDirty({SectionName::WAV});
     for ( size_t i=0; i<Chk::TotalSounds; i++ )
     {
         if ( this->soundPaths[i] == Chk::StringId::UnusedSound )
@@ -6519,6 +7078,7 @@ size_t Scenario::getSoundStringId(size_t soundIndex) const
 
 void Scenario::setSoundStringId(size_t soundIndex, size_t soundStringId)
 {
+    markDirty({SectionName::WAV});
     if ( soundIndex < Chk::TotalSounds )
         this->soundPaths[soundIndex] = (u32)soundStringId;
 }
@@ -6848,12 +7408,14 @@ void Scenario::markUsedTriggerEditorStrings(std::bitset<Chk::MaxStrings> & strin
 
 void Scenario::remapTriggerLocationIds(const std::map<u32, u32> & locationIdRemappings)
 {
+    markDirty({SectionName::TRIG});
     for ( auto & trigger : this->triggers )
         trigger.remapLocationIds(locationIdRemappings);
 }
 
 void Scenario::remapTriggerStringIds(const std::map<u32, u32> & stringIdRemappings, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::TRIG, SectionName::MBRF, SectionName::WAV, SectionName::SWNM, SectionName::KTRG});
     if ( storageScope == Chk::StrScope::Game )
     {
         for ( size_t i=0; i<Chk::TotalSounds; i++ )
@@ -6890,12 +7452,14 @@ void Scenario::remapTriggerStringIds(const std::map<u32, u32> & stringIdRemappin
 
 void Scenario::deleteTriggerLocation(size_t locationId)
 {
+    markDirty({SectionName::TRIG});
     for ( auto & trigger : this->triggers )
         trigger.deleteLocation(locationId);
 }
 
 void Scenario::deleteTriggerString(size_t stringId, Chk::StrScope storageScope)
 {
+    markDirty({SectionName::TRIG, SectionName::MBRF, SectionName::WAV, SectionName::SWNM, SectionName::KTRG});
     if ( storageScope == Chk::StrScope::Game )
     {
         for ( size_t i=0; i<Chk::TotalSounds; i++ )
@@ -7,7 +7,11 @@
 #include <string>
 #include <array>
 #include <map>
-#include <list>
+#include <vector>
+#include <initializer_list>
+#include <memory_resource>
+#include <unordered_map>
+#include <unordered_set>
 
 /*
     Versions [VER, TYPE, IVER, IVE2, VCOD] - versioning and validation
@@ -83,6 +87,10 @@ struct Scenario
         createUnitProperties, createUnitPropertiesUsed, triggers, briefingTriggers, switchNames, soundPaths, triggerExtensions, triggerGroupings)
     
     Scenario(); // Construct empty map
+    // Construct empty map whose strings & section storage are allocated from memoryResource, e.g. a std::pmr::monotonic_buffer_resource released between maps
+    // memoryResource must outlive the scenario, plain copies allocate section storage from the default resource but strings from the source's resource
+    explicit Scenario(std::pmr::memory_resource* memoryResource);
+    Scenario(const Scenario & other, std::pmr::memory_resource* memoryResource); // Copy other allocating all of its strings & section storage from memoryResource
     Scenario(Sc::Terrain::Tileset tileset, u16 width = 64, u16 height = 64); // Construct new map
 
     // Versioning API
@@ -499,9 +507,45 @@ struct Scenario
     bool login(const std::string & password) const; // Attempts to login to the map
         
     void read(std::istream & is, Chk::SectionName sectionName, Chk::SectionSize sectionSize); // Parse the given section
-    bool read(std::istream & is); // Parses supplied scenario file data
+    // Sections outside of sectionsToParse are kept as raw sectionData & written back unchanged, their fields keep defaults & edits to them aren't saved
+    using SectionMask = std::unordered_set<Chk::SectionName>; // VER is always parsed
+    static const SectionMask terrainSections; // VER, DIM, ERA, ISOM, TILE & MTXM
+
+    struct SectionEntry
+    {
+        Chk::SectionName sectionName {};
+        Chk::SectionSize sizeInBytes = 0; // The size given in the section header
+        size_t offset = 0; // Offset of the section's data (just past its header) within the chk
+        size_t size = 0; // Bytes of section data present, less than sizeInBytes if the chk ends early
+    };
+    struct SectionDirectory // The sections of a chk in the order they're read, found by walking section headers & jump sections without parsing any section
+    {
+        std::vector<SectionEntry> sections {}; // A section name may appear more than once, later occurrences override earlier ones
+        std::unordered_map<Chk::SectionName, size_t> lastIndex {}; // Index in sections of the last occurrence of each section name
+        size_t tailOffset = 0; // Offset of a partial section header at the end of the chk
+        size_t tailLength = 0; // Bytes of a partial section header at the end of the chk
+        bool jumpCompressed = false;
+        std::string error {}; // Not empty if the walk couldn't finish, sections holds those found before the error
+
+        const SectionEntry* find(Chk::SectionName sectionName) const; // The last occurrence of sectionName or nullptr
+    };
+    static SectionDirectory scanSections(const u8* chk, size_t chkSize); // Lets callers inspect a chk's sections (e.g. VER or DIM) without loading it
+
+    bool read(std::istream & is, const SectionMask* sectionsToParse = nullptr, bool reuseCleanSections = false); // Parses supplied scenario file data, nullptr parses every section
+    bool read(const u8* chk, size_t chkSize, const SectionMask* sectionsToParse = nullptr, // Parses scenario file data in place from a contiguous buffer, sections are walked by offset
+        bool viewUnparsedSections = false, // If true unparsed sections point into chk rather than being copied, chk must outlive them or copyViewedSections be called
+        bool reuseCleanSections = false); // If true parsed sections are written back from the bytes they were read from until marked dirty, see markDirty
     void write(std::ostream & os); // Writes all sections to the supplied stream
 
+    // Snapshots hold the sections write would produce uncompressed behind a table of section offsets (see Chk::SnapshotHeader), each section's data
+    // aligned to Chk::SnapshotAlignment so it's parsed in place & bulk copied from a memory mapping; the chk written after reading a snapshot
+    // matches the chk of the scenario that wrote it. Snapshots pass maps between tools or pipeline stages, they don't hold MPQ assets
+    bool writeSnapshot(std::vector<u8> & snapshot); // Writes the snapshot to snapshot, sized exactly
+    bool readSnapshot(const u8* snapshot, size_t snapshotSize, const SectionMask* sectionsToParse = nullptr, bool viewUnparsedSections = false, // As read
+        bool reuseCleanSections = false);
+    static bool isSnapshot(const u8* data, size_t size); // Checks for a snapshot header of the current SnapshotVersion
+    bool write(std::vector<u8> & chk, size_t leadingBytes = 0); // Writes all sections to chk after leadingBytes zeroes, chk is sized exactly & allocated once
+
     std::vector<u8> serialize(); /** Writes all sections to a buffer in memory as it would to a .chk file
                                         includes a 4 byte "CHK " tag followed by a 4-byte size, followed by data */
     bool deserialize(Chk::SerializedChk* data); // "Opens" a serialized Scenario.chk file, data must be 8+ bytes
@@ -509,21 +553,50 @@ struct Scenario
     void updateSaveSections();
     bool changeVersionTo(Chk::Version version, bool lockAnywhere = true, bool autoDefragmentLocations = true);
 
+    // Scenarios read with reuseCleanSections write sections back from the bytes they were read from until marked dirty, Scenario's methods mark the
+    // sections they change; callers opting in (e.g. batch tools) must mark the sections of any fields they change directly before the next write
+    void markDirty(std::initializer_list<Chk::SectionName> sectionNames);
+
     struct Section {
         Chk::SectionName sectionName;
-        std::optional<std::vector<u8>> sectionData {}; // If not present, section data is found in the fields of Scenario
+        std::optional<std::pmr::vector<u8>> sectionData {}; // If not present, section data is found in the fields of Scenario
+        const u8* viewedData = nullptr; // Unparsed section data left in the buffer it was read from (e.g. a memory mapped file) instead of sectionData
+        size_t viewedSize = 0;
+
+        bool isRaw() const { return sectionData || viewedData != nullptr; }
+        const u8* rawData() const { return sectionData ? sectionData->data() : viewedData; }
+        size_t rawSize() const { return sectionData ? sectionData->size() : viewedSize; }
     };
 
 protected:
+    std::pmr::memory_resource* getMemoryResource() const; // The resource strings & section storage are allocated from
     bool hasSection(SectionName sectionName) const;
-    Section & addSection(Section section);
+    bool hasUnparsedSections() const; // True if a known section was kept as raw sectionData by a read with sectionsToParse
+    bool hasViewedSections() const; // True if a section still views the buffer it was read from, see viewUnparsedSections
+    void copyViewedSections(); // Copies sections viewed by a read with viewUnparsedSections to sectionData so the buffer they were read from can be released
+    Section & addSection(Section section); // References are invalidated by the next addSection or removeSection
     void removeSection(const SectionName & sectionName);
+    void indexSaveSections(); // Rebuilds saveSectionIndex after saveSections is changed other than through addSection
 
+    bool readSections(const u8* data, const SectionDirectory & directory, const SectionMask* sectionsToParse, bool viewUnparsedSections, // Parses a cleared scenario
+        bool reuseCleanSections);
     bool parsingFailed(const std::string & error);
     void clear();
 
+    struct SyncedStringSections // String sections are built once per write so their sizes are known before any section is written
+    {
+        std::vector<u8> str {};
+        std::vector<u8> strx {};
+        std::vector<u8> kstr {};
+    };
+    SyncedStringSections syncStringSections();
+    s32 getSectionSize(const Section & section, const SyncedStringSections & strings); // The sizeInBytes writeSections gives the section
+    void writeSections(std::ostream & os, const SyncedStringSections & strings);
+
 private:
-    std::list<Section> saveSections {}; // Maintains the order of sections in the map and stores data for any sections that are not parsed
+    std::pmr::vector<Section> saveSections {}; // Maintains the order of sections in the map and stores data for any sections that are not parsed
+    std::pmr::unordered_map<SectionName, size_t> saveSectionIndex {}; // Index of each section in saveSections
+    std::pmr::unordered_map<SectionName, std::pmr::vector<u8>> cleanSectionBytes {}; // The bytes of parsed sections unchanged since they were read
     std::array<u8, 7> tailData {}; // The 0-7 bytes just before the Scenario file ends, after the last valid section
     u8 tailLength {0}; // 0 for no tail data, must be less than 8
     mutable bool mapIsProtected {false}; // Flagged if map is protected
@@ -7,12 +7,18 @@
 #include <filesystem>
 #include <memory>
 #include <thread>
+#include <utility>
 #include <chrono>
 #include <iostream>
 #include <regex>
 #ifdef _WIN32
 #include <Windows.h>
 #include <direct.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 constexpr u32 size_1kb = 0x400;
@@ -322,6 +328,91 @@ bool bufferToFile(const std::string & systemFilePath, const std::vector<u8> & bu
     return success;
 }
 
+MappedFile::MappedFile(MappedFile && other) noexcept
+    : fileData(other.fileData), fileSize(other.fileSize), opened(other.opened)
+{
+    other.fileData = nullptr;
+    other.fileSize = 0;
+    other.opened = false;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile & MappedFile::operator=(MappedFile && other) noexcept
+{
+    if ( this != &other )
+    {
+        close();
+        std::swap(fileData, other.fileData);
+        std::swap(fileSize, other.fileSize);
+        std::swap(opened, other.opened);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string & systemFilePath)
+{
+    close();
+#ifdef _WIN32
+    HANDLE hFile = CreateFile(icux::toFilestring(systemFilePath).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if ( hFile == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size {};
+    if ( GetFileSizeEx(hFile, &size) && size.QuadPart == 0 )
+        opened = true;
+    else if ( size.QuadPart > 0 && u64(size.QuadPart) <= u64(SIZE_MAX) )
+    {
+        if ( HANDLE hMapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL) )
+        {
+            fileData = reinterpret_cast<const u8*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+            fileSize = fileData != nullptr ? size_t(size.QuadPart) : 0;
+            opened = fileData != nullptr;
+            CloseHandle(hMapping); // The view keeps the mapping alive
+        }
+    }
+    CloseHandle(hFile);
+#elif defined(__unix__) || defined(__APPLE__)
+    int fileDescriptor = ::open(systemFilePath.c_str(), O_RDONLY);
+    if ( fileDescriptor < 0 )
+        return false;
+
+    struct stat fileStat {};
+    if ( fstat(fileDescriptor, &fileStat) == 0 && fileStat.st_size == 0 )
+        opened = true;
+    else if ( fileStat.st_size > 0 )
+    {
+        void* mapping = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if ( mapping != MAP_FAILED )
+        {
+            fileData = reinterpret_cast<const u8*>(mapping);
+            fileSize = size_t(fileStat.st_size);
+            opened = true;
+        }
+    }
+    ::close(fileDescriptor); // The mapping remains valid after the descriptor is closed
+#endif
+    return opened;
+}
+
+void MappedFile::close()
+{
+    if ( fileData != nullptr )
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(fileData);
+#elif defined(__unix__) || defined(__APPLE__)
+        munmap(const_cast<u8*>(fileData), fileSize);
+#endif
+    }
+    fileData = nullptr;
+    fileSize = 0;
+    opened = false;
+}
+
 bool makeFileCopy(const std::string & inFilePath, const std::string & outFilePath)
 {
     bool success = false;
@@ -44,6 +44,29 @@ std::optional<std::string> fileToString(const std::string & fileName);
 std::optional<std::vector<u8>> fileToBuffer(const std::string & systemFilePath);
 bool bufferToFile(const std::string & systemFilePath, const std::vector<u8> & buffer);
 
+class MappedFile // A read-only memory mapping of a whole file, the contents remain valid until the mapping is closed, replaced or destroyed
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile && other) noexcept;
+    ~MappedFile();
+    MappedFile & operator=(const MappedFile &) = delete;
+    MappedFile & operator=(MappedFile && other) noexcept;
+
+    bool open(const std::string & systemFilePath); // Closes any current mapping, returns false if the file couldn't be mapped (or mapping is unsupported)
+    void close();
+
+    bool isOpen() const { return opened; }
+    const u8* data() const { return fileData; }
+    size_t size() const { return fileSize; }
+
+private:
+    const u8* fileData = nullptr;
+    size_t fileSize = 0;
+    bool opened = false; // Empty files are open with no data
+};
+
 bool makeFileCopy(const std::string & inFilePath, const std::string & outFilePath);
 bool makeDirectory(const std::string & directory);
 